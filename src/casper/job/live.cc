@@ -103,7 +103,7 @@ void casper::job::Live::Run (const uint64_t& a_id, const Json::Value& a_payload,
     // ... log status ...
     SEQUENCER_LOG_JOB(CC_JOB_LOG_LEVEL_INF, tracking.bjid_, CC_JOB_LOG_STEP_IN, "%s", "Validating");
 
-    sequencer::Sequence* sequence = nullptr;
+    std::shared_ptr<sequencer::Sequence> sequence;
     
     try {
         
@@ -142,6 +142,12 @@ void casper::job::Live::Run (const uint64_t& a_id, const Json::Value& a_payload,
             throw sequencer::JSONValidationException(tracking, "'on_error' is not a valid object!");
         }
         
+        // ... validate 'idempotency_key' ( if any ) ...
+        const Json::Value& idempotency_key = (*payload)["idempotency_key"];
+        if ( false == idempotency_key.isNull() && false == idempotency_key.isString() ) {
+            throw sequencer::JSONValidationException(tracking, "'idempotency_key' is not a valid string!");
+        }
+        
         // ... register sequence and grab first activity ...
         try {
 
@@ -152,7 +158,7 @@ void casper::job::Live::Run (const uint64_t& a_id, const Json::Value& a_payload,
             }
 
             // ... create sequence from payload ...
-            sequence = new sequencer::Sequence(
+            sequence = std::make_shared<sequencer::Sequence>(
                                                /* a_source */ ( true == a_payload.isMember("body") && true == a_payload.isMember("headers")
                                                                 ? sequencer::Sequence::Source::Jobification
                                                                 : sequencer::Sequence::Source::Default
@@ -167,26 +173,38 @@ void casper::job::Live::Run (const uint64_t& a_id, const Json::Value& a_payload,
                                                /* a_origin   */ origin,
                                                /* a_on_error */ on_error
             );
-            // ... register sequence ...
-            auto first_activity = RegisterSequence(*sequence, *payload);
-            try {
-                // ... launch first activity ...
-                o_response.code_ = LaunchActivity(tracking, first_activity, /* a_at_run */ true);
-            } catch (const sequencer::JSONValidationException& a_jve) {
-                // ... fallthrough to outer try - catch ...
-                throw a_jve;
-            } catch (const sequencer::V8ExpressionEvaluationException& a_v8eee) {
-                // ... fallthrough to outer try - catch ...
-                throw a_v8eee;
-            } catch (...) {
-                 // ... untrack activity ...
-                 UntrackActivity(first_activity);
-                 // ... rethrow ...
-                 try {
-                     ::cc::Exception::Rethrow(/* a_unhandled */ false,  tracking.file_.c_str(), tracking.line_, tracking.function_.c_str());
-                } catch (::cc::Exception& a_cc_exception) {
-                    // ... jump for common exception handling ...
-                    throw sequencer::JumpErrorAlreadySet(tracking, /* o_code */ 500, a_cc_exception.what());
+            // ... identical job retried? attach it to the in-flight sequence or reuse a recently completed response ...
+            std::string    identity;
+            const uint64_t key = IdempotencyKey(*payload, origin, identity);
+            if ( 0 != key && true == AttachSequence(key, identity, sequence) ) {
+                // ... response is deferred, as if it was launched ...
+                o_response.code_ = 200;
+            } else {
+                // ... register sequence ...
+                auto first_activity = RegisterSequence(sequence, *payload);
+                try {
+                    // ... launch first activity ...
+                    o_response.code_ = LaunchStep(tracking, first_activity, /* a_at_run */ true);
+                    // ... launched? from now on, identical jobs are attached to it ...
+                    if ( 0 != key && 200 == o_response.code_ ) {
+                        LeadSequence(key, identity, sequence);
+                    }
+                } catch (const sequencer::JSONValidationException& a_jve) {
+                    // ... fallthrough to outer try - catch ...
+                    throw a_jve;
+                } catch (const sequencer::V8ExpressionEvaluationException& a_v8eee) {
+                    // ... fallthrough to outer try - catch ...
+                    throw a_v8eee;
+                } catch (...) {
+                     // ... untrack activity ...
+                     UntrackActivity(first_activity);
+                     // ... rethrow ...
+                     try {
+                         ::cc::Exception::Rethrow(/* a_unhandled */ false,  tracking.file_.c_str(), tracking.line_, tracking.function_.c_str());
+                    } catch (::cc::Exception& a_cc_exception) {
+                        // ... jump for common exception handling ...
+                        throw sequencer::JumpErrorAlreadySet(tracking, /* o_code */ 500, a_cc_exception.what());
+                    }
                 }
             }
         } catch (const sequencer::Exception& a_exception) {
@@ -234,11 +252,6 @@ void casper::job::Live::Run (const uint64_t& a_id, const Json::Value& a_payload,
         );
     }
     
-    // ... release temporary allocated objects ...
-    if ( nullptr != sequence ) {
-        delete sequence;
-    }
-    
     // ... if scheduled, then the response must be deferred ...
     if ( 200 == o_response.code_ ) {
         // ... this will remove job from beanstalkd queue, but keeps the redis status as is ( in-progress ) ...
@@ -33,6 +33,10 @@
 
 #include "version.h"
 
+#include <algorithm> // std::max
+#include <iterator>  // std::make_move_iterator
+#include <vector>
+
 CC_WARNING_TODO("CJS: review all comments and parameters names")
 
 CC_WARNING_TODO("CJS: check if v8 calls must be done on 'Main' thread")
@@ -54,6 +58,9 @@ const std::map<std::string, casper::job::sequencer::Status> casper::job::Sequenc
 };
 
 const ::cc::easy::job::I18N casper::job::Sequencer::sk_i18n_aborted_ = { /* key_ */ "i18n_aborted", /* args_ */ {} };
+const char* const casper::job::Sequencer::sk_messages_callback_id_ = "sequencer-messages-callback";
+const char* const casper::job::Sequencer::sk_stats_callback_id_    = "sequencer-stats-callback";
+const char* const casper::job::Sequencer::sk_metrics_callback_id_  = "sequencer-metrics-callback";
 
 /**
  * @brief Default constructor.
@@ -64,11 +71,22 @@ const ::cc::easy::job::I18N casper::job::Sequencer::sk_i18n_aborted_ = { /* key_
  */
 casper::job::Sequencer::Sequencer (const char* const a_tube, const ev::Loggable::Data& a_loggable_data, const cc::easy::job::Job::Config& a_config)
     : cc::easy::job::Job(a_loggable_data, a_tube, a_config),      
-      sequence_config_(a_config.other()["sequence"]), activity_config_(a_config.other()["activity"])
+      log_level_(static_cast<size_t>(a_config.other().get("log_level", Json::Value(Json::UInt(a_config.log_level()))).asUInt())),
+      sequence_config_(a_config.other()["sequence"]), activity_config_(a_config.other()["activity"]),
+      messages_(4096)
 {
     script_   = nullptr;
     rollbar_  = nullptr;
     volatile_ = nullptr;
+    logger_   = nullptr;
+    messages_scheduled_.store(false);
+    overflow_size_.store(0);
+    relay_interval_  = 0;
+    pushes_deferred_ = false;
+    map_concurrency_ = 16;
+    // ... local job numbers never collide with REDIS ones ...
+    local_rjnr_      = ( static_cast<uint64_t>(1) << 63 );
+    idempotency_derive_ = false;
 }
 
 /**
@@ -89,11 +107,17 @@ casper::job::Sequencer::~Sequencer ()
     if ( nullptr != volatile_ ) {
         delete volatile_;
     }
-    // ... forget running activities ...
-    for ( auto it : running_activities_ ) {
-        delete it.second;
+    // ... forget binary logger ( pending records are written ) ...
+    if ( nullptr != logger_ ) {
+        delete logger_;
     }
-    running_activities_.clear();
+    // ... forget running activities ...
+    running_sequences_.Clear();
+    running_activities_.ForEach([] (const uint64_t /* a_rjnr */, sequencer::Activity* a_activity) {
+        delete a_activity;
+    });
+    running_activities_.Clear();
+    sequences_.clear();
 }
 
 #ifdef __APPLE__
@@ -123,9 +147,80 @@ void casper::job::Sequencer::Setup ()
             rollbar_->Setup(loggable_data_, rollbar_ref);
         }
     }
+    // ... prepare binary logger, when enabled SEQUENCER_LOG_* lines are written by it ( rotated by size, in MB - 0 never rotates ) ...
+    const Json::Value& binary_log_ref = json.Get(config_.other(), "binary_log", Json::ValueType::objectValue, &Json::Value::null);
+    if ( false == binary_log_ref.isNull() ) {
+        if ( true == json.Get(binary_log_ref, "enabled", Json::ValueType::booleanValue, /* a_default */ nullptr).asBool() ) {
+            const Json::Value default_max_size = Json::Value(Json::UInt(64));
+            logger_ = new sequencer::Logger(json.Get(binary_log_ref, "uri", Json::ValueType::stringValue, /* a_default */ nullptr).asString(),
+                                            /* a_capacity */ 16384,
+                                            /* a_max_size */ static_cast<uint64_t>(json.Get(binary_log_ref, "max_size", Json::ValueType::uintValue, &default_max_size).asUInt()) * 1024 * 1024
+            );
+            logger_->Start();
+        }
+    }
     // ... prepare 'volatile' ...
     volatile_ = new ::cc::easy::job::Volatile(beanstalk_config(), loggable_data_);
     volatile_->Setup();
+    // ... periodically log statistics, in seconds ( 0 disables it ) ...
+    const Json::Value default_stats_interval = Json::Value(Json::UInt(60));
+    const Json::UInt  stats_interval         = json.Get(config_.other(), "stats_interval", Json::ValueType::uintValue, &default_stats_interval).asUInt();
+    if ( 0 != stats_interval ) {
+        ScheduleCallbackOnLooperThread(/* a_id */ sk_stats_callback_id_,
+                                       /* a_callback */ std::bind(&casper::job::Sequencer::OnStatsTimer, this, std::placeholders::_1),
+                                       /* a_deferred  */ stats_interval * 1000,
+                                       /* a_recurrent */ true
+        );
+    }
+    // ... 'in-progress' messages coalescing interval, in milliseconds ( 0 relays all ) ...
+    const Json::Value default_relay_interval = Json::Value(Json::UInt(0));
+    relay_interval_ = static_cast<uint64_t>(json.Get(config_.other(), "progress_relay_interval", Json::ValueType::uintValue, &default_relay_interval).asUInt()) * 1000;
+    // ... default maximum number of running items of a 'map' step ( items are not registered @ DB nor retried ) ...
+    const Json::Value default_map_concurrency = Json::Value(Json::UInt(map_concurrency_));
+    map_concurrency_ = std::max(static_cast<size_t>(1), static_cast<size_t>(json.Get(config_.other(), "map_concurrency", Json::ValueType::uintValue, &default_map_concurrency).asUInt()));
+    // ... pipelined beanstalkd producer, used to push activities in batches to the same beanstalkd jobs are pushed to ( it's timeout, or producer's default one, is always set ) ...
+    const Json::Value default_pipelined_push = Json::Value(false);
+    if ( true == json.Get(config_.other(), "pipelined_push", Json::ValueType::booleanValue, &default_pipelined_push).asBool() ) {
+        producer_.Setup(beanstalk_config().host_, beanstalk_config().port_, static_cast<uint32_t>(beanstalk_config().timeout_ * 1000));
+    }
+    // ... per tube activities results memoization, TTL in seconds ...
+    const Json::Value& memoize_ref = json.Get(config_.other(), "memoize", Json::ValueType::objectValue, &Json::Value::null);
+    if ( false == memoize_ref.isNull() ) {
+        const Json::Value  default_max_entries = Json::Value(Json::UInt(1024));
+        const Json::UInt   max_entries         = json.Get(memoize_ref, "max_entries", Json::ValueType::uintValue, &default_max_entries).asUInt();
+        const Json::Value& tubes_ref           = json.Get(memoize_ref, "tubes", Json::ValueType::objectValue, /* a_default */ nullptr);
+        for ( const auto& tube : tubes_ref.getMemberNames() ) {
+            memo_.Enable(tube, json.Get(tubes_ref, tube.c_str(), Json::ValueType::uintValue, /* a_default */ nullptr).asUInt(), static_cast<size_t>(max_entries));
+        }
+    }
+    // ... idempotent submission: key derivation and recently completed sequences responses TTL, in seconds ( 0 disables it ) ...
+    const Json::Value& idempotency_ref = json.Get(config_.other(), "idempotency", Json::ValueType::objectValue, &Json::Value::null);
+    Json::UInt         completed_ttl   = 30;
+    Json::UInt         completed_max   = 1024;
+    if ( false == idempotency_ref.isNull() ) {
+        const Json::Value default_derive        = Json::Value(false);
+        const Json::Value default_completed_ttl = Json::Value(completed_ttl);
+        const Json::Value default_completed_max = Json::Value(completed_max);
+        idempotency_derive_ = json.Get(idempotency_ref, "derive"     , Json::ValueType::booleanValue, &default_derive).asBool();
+        completed_ttl       = json.Get(idempotency_ref, "ttl"        , Json::ValueType::uintValue   , &default_completed_ttl).asUInt();
+        completed_max       = json.Get(idempotency_ref, "max_entries", Json::ValueType::uintValue   , &default_completed_max).asUInt();
+    }
+    if ( 0 != completed_ttl ) {
+        completed_.Enable(tube_, completed_ttl, static_cast<size_t>(completed_max));
+    }
+    // ... prepare prometheus metrics file ...
+    const Json::Value& metrics_ref = json.Get(config_.other(), "metrics", Json::ValueType::objectValue, &Json::Value::null);
+    if ( false == metrics_ref.isNull() ) {
+        if ( true == json.Get(metrics_ref, "enabled", Json::ValueType::booleanValue, /* a_default */ nullptr).asBool() ) {
+            const Json::Value default_metrics_interval = Json::Value(Json::UInt(15));
+            metrics_uri_ = json.Get(metrics_ref, "uri", Json::ValueType::stringValue, /* a_default */ nullptr).asString();
+            ScheduleCallbackOnLooperThread(/* a_id */ sk_metrics_callback_id_,
+                                           /* a_callback */ std::bind(&casper::job::Sequencer::OnMetricsTimer, this, std::placeholders::_1),
+                                           /* a_deferred  */ json.Get(metrics_ref, "interval", Json::ValueType::uintValue, &default_metrics_interval).asUInt() * 1000,
+                                           /* a_recurrent */ true
+            );
+        }
+    }
     //
     // SPECIAL CASE: we're interested in cancellation signals ( since we're running activites in sequence )
     //
@@ -143,6 +238,15 @@ void casper::job::Sequencer::Dismantle ()
          // ... unsubscribe from REDIS ...
         ::ev::redis::subscriptions::Manager::GetInstance().Unubscribe(this);
     }, /* a_blocking */ true);
+    // ... stop logging statistics ...
+    TryCancelCallbackOnLooperThread(sk_stats_callback_id_);
+    if ( 0 != metrics_uri_.length() ) {
+        TryCancelCallbackOnLooperThread(sk_metrics_callback_id_);
+    }
+    // ... flush binary logger ...
+    if ( nullptr != logger_ ) {
+        logger_->Stop();
+    }
 }
 
 #ifdef __APPLE__
@@ -152,19 +256,19 @@ void casper::job::Sequencer::Dismantle ()
 /**
  * @brief Register job sequence and it's activities.
  *
- * @param a_jid      Sequence info.
+ * @param a_sequence Sequence info, NOT shared yet - it will be bound to DB info here.
  * @param a_payload  Sequence payload.
  *
  * @return \link ActivityInfo \link of the first activity to be launched.
  */
-casper::job::sequencer::Activity casper::job::Sequencer::RegisterSequence (sequencer::Sequence& a_sequence, const Json::Value& a_payload)
+casper::job::sequencer::Activity casper::job::Sequencer::RegisterSequence (const std::shared_ptr<sequencer::Sequence>& a_sequence, const Json::Value& a_payload)
 {
     CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
     
-    const sequencer::Tracking tracking = SEQUENCER_TRACK_CALL(a_sequence.bjid(), "REGISTERING SEQUENCE");
+    const sequencer::Tracking tracking = SEQUENCER_TRACK_CALL(a_sequence->bjid(), "REGISTERING SEQUENCE");
     
     // ... log ...
-    SEQUENCER_LOG_SEQUENCE(CC_JOB_LOG_LEVEL_INF, a_sequence, CC_JOB_LOG_STEP_IN, "%s", "Registering");
+    SEQUENCER_LOG_SEQUENCE(CC_JOB_LOG_LEVEL_INF, (*a_sequence), CC_JOB_LOG_STEP_IN, "%s", "Registering");
     
     //
     // FORMAT:
@@ -180,14 +284,45 @@ casper::job::sequencer::Activity casper::job::Sequencer::RegisterSequence (seque
     //   }]
     // }
     //
+    // A 'jobs' entry can also be a parallel group, { "parallel": [ <job>, ... ] }, all of it's jobs are launched
+    // together and the next entry is only launched after all of them return. Groups are flattened here, each job
+    // is still one activity, so responses are available to V8 expressions by their ( flattened ) index.
+    //
+    // A job can also be skipped, finalized here without being pushed, when it's optional 'skip_if' V8 expression
+    // evaluates to true, or when it's optional 'next_if' V8 expression evaluates to the 'name' ( or index ) of a
+    // following job, the sequence then continues from that job.
+    //
+    // A job can also be a 'map' step, "map": { "items": <V8 expression>, "concurrency": <unsigned int>, "max_items": <unsigned int> },
+    // one activity per item is launched ( up to 'concurrency' at a time ) and the step returns all items responses.
+    // ⚠️ Only the 'map' activity is registered @ DB, it's items are not, and a 'retry' policy does not apply to them:
+    //    the first failed item fails the step ( no more items are launched ).
+    //
     
     CC_WARNING_TODO("CJS: ensure id is the last component of a_jrid");
     
+    // ... expand parallel groups ( if any ) ...
+    Json::Value        flattened = Json::Value::null;
+    const Json::Value* payload   = &a_payload;
+    bool               grouped   = false;
+    if ( true == a_payload["jobs"].isArray() ) {
+        Json::Value jobs;
+        try {
+            grouped = sequencer::Parallel::Flatten(a_payload["jobs"], jobs);
+        } catch (const ::cc::Exception& a_cc_exception) {
+            throw sequencer::BadRequestException(tracking, a_cc_exception.what());
+        }
+        if ( true == grouped ) {
+            flattened = a_payload;
+            flattened["jobs"].swap(jobs);
+            payload = &flattened;
+        }
+    }
+    
     Json::UInt seq_ttr      = 0;
     Json::UInt seq_validity = 0;
     Json::UInt seq_timeout  = 0;
     // ... validate ...
-    ValidateSequenceTimeouts(tracking, a_sequence, a_payload, seq_ttr, seq_validity, seq_timeout);
+    ValidateSequenceTimeouts(tracking, *a_sequence, *payload, seq_ttr, seq_validity, seq_timeout);
     
     // ... adjust ...
     const uint64_t adjust_seq_ttr = static_cast<uint64_t>(seq_ttr);
@@ -195,45 +330,41 @@ casper::job::sequencer::Activity casper::job::Sequencer::RegisterSequence (seque
     SetTTRAndValidity(adjust_seq_ttr, adjust_seq_val);
     
     // ... now register sequence ...    
-    std::stringstream ss; ss.clear(); ss.str("");
     Json::FastWriter  jw; jw.omitEndingLineFeed();
-    
-    // ... js.register_sequence (pid INTEGER, cid INTEGER, iid INTEGER, bjid INTEGER, rjid TEXT, rcid TEXT, payload JSONB, activities JSONB, ttr INTEGER, validity INTEGER, timeout INTEGER) ...
-    ss << "SELECT * FROM js.register_sequence(";
-    ss <<     config_.pid() << ',' << a_sequence.cid() << ',' << a_sequence.iid() << ',' << a_sequence.bjid();
-    ss <<     ',' <<  "'" << a_sequence.rjid() << "'" << ',' << "'" << a_sequence.rcid() << "'";
-    ss <<     ",'" << ::ev::postgresql::Request::SQLEscape(jw.write(a_payload)) << "'";
-    ss <<     ",'" << ::ev::postgresql::Request::SQLEscape(jw.write(a_payload["jobs"])) << "'";
-    ss <<     ',' << seq_ttr << ',' << seq_validity << ',' << seq_timeout;
-    ss << ");";
+    const std::string query = sequencer::SQL::RegisterSequence(config_.pid(), *a_sequence, jw.write(*payload), jw.write((*payload)["jobs"]),
+                                                               seq_ttr, seq_validity, seq_timeout);
     
     //
-    Json::Value activity = Json::Value::null;
-    size_t      count    = 0;
+    Json::Value activity   = Json::Value::null;
+    Json::Value activities = Json::Value::null;
+    size_t      count      = 0;
     
     // ... register @ DB ...
     ExecuteQueryAndWait(/* a_tracking         */  tracking,
-                        /* a_query            */ ss.str(), /* a_expected */ ExecStatusType::PGRES_TUPLES_OK,
+                        /* a_query            */ query, /* a_expected */ ExecStatusType::PGRES_TUPLES_OK,
                         /* a_success_callback */
-                            [&count, &activity] (const Json::Value& a_value) {
+                            [&count, &activity, &activities] (Json::Value& a_value) {
                             count    = static_cast<size_t>(a_value.size());
-                            activity = a_value[0];
+                            // ... parallel groups and 'next_if' targets activities are launched from these rows, next activity REDIS job is reserved from them ...
+                            activities = a_value;
+                            activity.swap(a_value[0]);
                         }
     );
     
-    // ... register sequence id from DB ...
-    a_sequence.Bind(/* a_id    */ GetJSONObject(activity, "sid"     , Json::ValueType::intValue   , /* a_default */ nullptr).asString(),
-                    /* a_count */ count
+    // ... register sequence id from DB ...
+    a_sequence->Bind(/* a_id         */ GetJSONObject(activity, "sid"     , Json::ValueType::intValue   , /* a_default */ nullptr).asString(),
+                    /* a_count      */ count,
+                    /* a_activities */ std::move(activities)
     );
     
     // ... log ...
-    SEQUENCER_LOG_SEQUENCE(CC_JOB_LOG_LEVEL_INF, a_sequence, CC_JOB_LOG_STEP_POSGRESQL, "Registered with ID %s, " SIZET_FMT " %s",
-                           a_sequence.did().c_str(),
-                           a_sequence.count(), ( a_sequence.count() == 1 ? "actitity" : "activities" )
+    SEQUENCER_LOG_SEQUENCE(CC_JOB_LOG_LEVEL_INF, (*a_sequence), CC_JOB_LOG_STEP_POSGRESQL, "Registered with ID %s, " SIZET_FMT " %s",
+                           a_sequence->did().c_str(),
+                           a_sequence->count(), ( a_sequence->count() == 1 ? "actitity" : "activities" )
     );
 
     const auto did      = GetJSONObject(activity, "id"      , Json::ValueType::intValue   , /* a_default */ nullptr).asString();
-    const auto job      = GetJSONObject(activity, "job"     , Json::ValueType::objectValue, /* a_default */ nullptr);
+    const auto& job     = GetJSONObject(activity, "job"     , Json::ValueType::objectValue, /* a_default */ nullptr);
     
 //    CC_WARNING_TODO("CJS: do we need this variable - used for validate 'tube' field existence ?");
 //    const auto tube     = GetJSONObject(job     , "tube"    , Json::ValueType::stringValue, /* a_default */ nullptr).asString();
@@ -241,8 +372,10 @@ casper::job::sequencer::Activity casper::job::Sequencer::RegisterSequence (seque
     const auto validity = GetJSONObject(job     , "validity", Json::ValueType::uintValue   , &activity_config_.validity_).asUInt();
     const auto ttr      = GetJSONObject(job     , "ttr"     , Json::ValueType::uintValue   , &activity_config_.ttr_).asUInt();
     
-    // ... return first activity properties ...
-    return sequencer::Activity(a_sequence, /* a_id */ did, /* a_index */ 0, /* a_attempt */ 0).Bind(sequencer::Status::Pending, validity, ttr, activity);
+    // ... return first activity properties ( 'job' ref is no longer valid after this point ) ...
+    sequencer::Activity first(a_sequence, /* a_id */ did, /* a_index */ 0, /* a_attempt */ 0);
+    first.Bind(sequencer::Status::Pending, validity, ttr, std::move(activity));
+    return first;
 }
 
 /**
@@ -267,20 +400,15 @@ void casper::job::Sequencer::CancelSequence (const casper::job::sequencer::Activ
     //    we are letting it run until it's finished and only mark as cancelled at the database
     //    to stop any other activity in the sequence to run.
     //
-    std::stringstream ss; ss.clear(); ss.str("");
     Json::FastWriter  jw; jw.omitEndingLineFeed();
     
-    // ... js.cancel_sequence (id INTEGER, status js.status, response JSONB) ...
-    ss << "SELECT * FROM js.cancel_sequence(";
-    ss <<   a_activity.sequence().did();
-    ss <<   ",'" << ::ev::postgresql::Request::SQLEscape(jw.write(a_response)) << "'";
-    ss << ");";
+    const std::string query = sequencer::SQL::CancelSequence(a_activity.sequence(), jw.write(a_response));
  
     double rtt = -1.0;
     
     // ... register @ DB ...
     ExecuteQueryAndWait(/* a_tracking */ SEQUENCER_TRACK_CALL(a_activity.sequence().bjid(), "CANCELLING JOB SEQUENCE"),
-                        /* a_query    */ ss.str(), /* a_expected */ ExecStatusType::PGRES_TUPLES_OK,
+                        /* a_query    */ query, /* a_expected */ ExecStatusType::PGRES_TUPLES_OK,
                         /* a_success_callback */
                         [&rtt] (const Json::Value& a_value) {
                             // ... array with one element is expected ...
@@ -293,38 +421,84 @@ void casper::job::Sequencer::CancelSequence (const casper::job::sequencer::Activ
                            a_activity.sequence().did().c_str()
     );
 
-    // ... copy sequence info, once cancelled / untracked it's relased and it's reference is no longer válid ...
-    const sequencer::Sequence sequence = sequencer::Sequence(a_activity.sequence());
+    // ... keep sequence info, once cancelled / untracked the activity is relased and it's reference is no longer válid ...
+    const sequencer::SharedSequence sequence = a_activity.shared_sequence();
     
-    // ... cancel activity ...
-    CancelActivity(a_activity, a_response);
+    // ... cancel all it's running activities and forget it ...
+    ReleaseSequence(*sequence, a_response);
     
-    ss.clear(); ss.str("");
+    std::stringstream ss;
     ss << sequencer::Status::Cancelled;
     
     // ... log sequence 'rtt' ...
-    SEQUENCER_LOG_SEQUENCE(CC_JOB_LOG_LEVEL_INF, sequence, CC_JOB_LOG_STEP_RTT, DOUBLE_FMT_D(0) "ms",
+    SEQUENCER_LOG_SEQUENCE(CC_JOB_LOG_LEVEL_INF, (*sequence), CC_JOB_LOG_STEP_RTT, DOUBLE_FMT_D(0) "ms",
                             rtt
     );
 
     Json::FastWriter ljfw; ljfw.omitEndingLineFeed();
     
     // ... log sequence 'response' ...
-    SEQUENCER_LOG_SEQUENCE(CC_JOB_LOG_LEVEL_INF, sequence, CC_JOB_LOG_STEP_OUT, "Response: " CC_JOB_LOG_COLOR(ORANGE) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
+    SEQUENCER_LOG_SEQUENCE(CC_JOB_LOG_LEVEL_INF, (*sequence), CC_JOB_LOG_STEP_OUT, "Response: " CC_JOB_LOG_COLOR(ORANGE) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
                            ljfw.write(a_response).c_str()
     );
     
     // ... log sequence 'status' ...
-    SEQUENCER_LOG_SEQUENCE(CC_JOB_LOG_LEVEL_INF, sequence, CC_JOB_LOG_STEP_STATUS, CC_JOB_LOG_COLOR(ORANGE) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
+    SEQUENCER_LOG_SEQUENCE(CC_JOB_LOG_LEVEL_INF, (*sequence), CC_JOB_LOG_STEP_STATUS, CC_JOB_LOG_COLOR(ORANGE) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
                            ss.str().c_str()
     );
             
     // ... log job 'status' ..
-    SEQUENCER_LOG_JOB(CC_JOB_LOG_LEVEL_INF, sequence.bjid(), CC_JOB_LOG_STEP_OUT, CC_JOB_LOG_COLOR(ORANGE) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
+    SEQUENCER_LOG_JOB(CC_JOB_LOG_LEVEL_INF, sequence->bjid(), CC_JOB_LOG_STEP_OUT, CC_JOB_LOG_COLOR(ORANGE) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
                       ss.str().c_str()
     );
 }
 
+/**
+ * @brief Cancel all running activities of a sequence ( hedged attempts, parallel group, 'map' step items or waiting to be retried )
+ *        and forget all it's looper state, the sequence is no longer running.
+ *
+ * @param a_sequence Sequence info, must outlive this call ( keep it's shared reference ).
+ * @param a_response Activities response.
+ */
+void casper::job::Sequencer::ReleaseSequence (const sequencer::Sequence& a_sequence, const Json::Value& a_response)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    const uint64_t rjnr  = a_sequence.rjnr();
+    SequenceState* state = FindSequenceState(rjnr);
+    
+    // ... copy, cancelled activities are untracked ...
+    std::vector<uint64_t>    running;
+    std::unique_ptr<MapStep> map;
+    if ( nullptr != state ) {
+        running.assign(state->running_.begin(), state->running_.end());
+        // ... no longer grouped or branching ...
+        state->group_.reset();
+        state->branch_.reset();
+        // ... 'map' step? keep parent alive until it no longer indexes the sequence ...
+        map = std::move(state->map_);
+    }
+    // ... no longer hedged ...
+    for ( const auto activity : running ) {
+        const auto hedge = hedges_.find(activity);
+        if ( hedges_.end() != hedge ) {
+            hedges_.erase(hedge->second);
+            hedges_.erase(hedge);
+        }
+    }
+    // ... cancel running activities ( ⚠️ state might be trimmed meanwhile ⚠️ ) ...
+    for ( const auto activity : running ) {
+        const sequencer::Activity* tracked = running_activities_.Find(activity);
+        if ( nullptr != tracked ) {
+            CancelActivity(*tracked, a_response);
+        }
+    }
+    // ... sequence index is not owned, it may still point to 'map' step parent ...
+    running_sequences_.Erase(rjnr);
+    // ... forget whatever is left ( coalesced messages, reservation ) ...
+    sequences_.erase(rjnr);
+}
+
 /**
  * @brief Call when the 'final' activity was performed so we close the sequence.
  *
@@ -348,17 +522,15 @@ void casper::job::Sequencer::FinalizeSequence (const casper::job::sequencer::Act
     std::stringstream ss; ss.clear(); ss.str("");
     Json::FastWriter  jw; jw.omitEndingLineFeed();
     
-    // ... js.finalize_sequence (id INTEGER, status js.status, response JSONB) ...
-    ss << "SELECT * FROM js.finalize_sequence(";
-    ss <<   sequence.did() << ",'" << a_activity.status() << "'";
-    ss <<   ",'" << ::ev::postgresql::Request::SQLEscape(jw.write(a_response)) << "'";
-    ss << ");";
+    const std::string query = sequencer::SQL::FinalizeSequence(sequence, a_activity.status(), jw.write(a_response));
     
     o_rtt = 0;
     
+    const uint64_t finalize_start = sequencer::Stats::Now();
+    
     // ... register @ DB ...
     ExecuteQueryAndWait(/* a_tracking */ SEQUENCER_TRACK_CALL(sequence.bjid(), "FINALIZING JOB SEQUENCE"),
-                        /* a_query    */ ss.str(), /* a_expected */ ExecStatusType::PGRES_TUPLES_OK,
+                        /* a_query    */ query, /* a_expected */ ExecStatusType::PGRES_TUPLES_OK,
                         /* a_success_callback */
                         [&o_rtt] (const Json::Value& a_value) {
                             // ... array with one element is expected ...
@@ -366,6 +538,9 @@ void casper::job::Sequencer::FinalizeSequence (const casper::job::sequencer::Act
                         }
     );
     
+    stats_.Record(a_activity.rcnm(), sequencer::Stats::Stage::FinalizeSequence, finalize_start);
+    stats_.Record(tube_, sequencer::Stats::Stage::Sequence, sequence.started_at());
+    
     // ... log ...
     SEQUENCER_LOG_SEQUENCE(CC_JOB_LOG_LEVEL_INF, sequence, CC_JOB_LOG_STEP_STEP, "Finalized ( " SIZET_FMT " / " SIZET_FMT " %s )",
                           ( a_activity.index() + 1 ), sequence.count(), ( sequence.count() == 1 ? "actitity" : "activities" )
@@ -449,10 +624,219 @@ void casper::job::Sequencer::FinalizeSequence (const casper::job::sequencer::Act
     );
 }
 
+/**
+ * @brief Finalize a sequence and it's job.
+ *
+ * @param a_activity Activity that ended the sequence.
+ * @param a_response Sequence final response.
+ */
+void casper::job::Sequencer::FinishSequence (const casper::job::sequencer::Activity& a_activity, const Json::Value& a_response)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    double rtt = 0;
+    
+    // ... finalize sequence ...
+    FinalizeSequence(a_activity, a_response, rtt);
+    
+    // ... finish job ...
+    FinalizeJob(a_activity.sequence(), a_response);
+}
+
+/**
+ * @brief Obtain a sequence idempotency key.
+ *
+ * @param a_payload  Sequence payload.
+ * @param a_origin   ORIGIN info, optional.
+ * @param o_identity Set with payload 'idempotency_key' or, if enabled, 'jobs' and origin serialization - prefixed so they never collide.
+ *
+ * @return Hash of identity, 0 if none.
+ */
+uint64_t casper::job::Sequencer::IdempotencyKey (const Json::Value& a_payload, const Json::Value& a_origin, std::string& o_identity) const
+{
+    // ... provided by payload?
+    const Json::Value& key = a_payload["idempotency_key"];
+    if ( true == key.isString() && 0 != key.asString().length() ) {
+        o_identity = "key:" + key.asString();
+        return sequencer::Memo::Hash(o_identity);
+    }
+    // ... derive it?
+    if ( false == idempotency_derive_ || false == a_payload["jobs"].isArray() ) {
+        o_identity.clear();
+        return 0;
+    }
+    Json::FastWriter fw; fw.omitEndingLineFeed();
+    o_identity = "jobs:" + fw.write(a_payload["jobs"]) + fw.write(a_origin);
+    return sequencer::Memo::Hash(o_identity);
+}
+
+/**
+ * @brief Attach a sequence to an identical one, if in-flight or recently completed.
+ *
+ * @param a_key      Idempotency key, as returned by \link IdempotencyKey \link.
+ * @param a_identity Sequence identity, as set by \link IdempotencyKey \link - a key hit with a different identity is a miss.
+ * @param a_sequence Sequence info, NOT registered.
+ *
+ * @return True if attached, job will be finished when the other sequence finishes ( or right away ), false otherwise.
+ *
+ * @note An attached job gets the exact same final response as the in-flight one, including a 'cancelled' one if the
+ *       in-flight sequence is cancelled - cancelling an attached job only detaches it.
+ */
+bool casper::job::Sequencer::AttachSequence (const uint64_t a_key, const std::string& a_identity, const sequencer::SharedSequence& a_sequence)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    // ... in-flight? ( same key and same identity as the lead sequence )
+    const auto it = idempotency_keys_.find(a_key);
+    if ( idempotency_keys_.end() != it ) {
+        Coalesced& coalesced = coalesced_[it->second];
+        if ( 0 != coalesced.identity_.compare(a_identity) ) {
+            return false;
+        }
+        coalesced.attached_.push_back(a_sequence);
+        // ... log ...
+        SEQUENCER_LOG_SEQUENCE(CC_JOB_LOG_LEVEL_INF, (*a_sequence), CC_JOB_LOG_STEP_STEP,
+                               "Attached to in-flight sequence with REDIS job number " UINT64_FMT, it->second
+        );
+        return true;
+    }
+    
+    // ... recently completed?
+    const Json::Value* response = completed_.Get(tube_, a_key, IdempotencyDigest(a_identity));
+    if ( nullptr == response ) {
+        return false;
+    }
+    
+    // ... log ...
+    SEQUENCER_LOG_SEQUENCE(CC_JOB_LOG_LEVEL_INF, (*a_sequence), CC_JOB_LOG_STEP_STEP,
+                           "%s", "Reusing a recently completed sequence response"
+    );
+    
+    // ... job can't be finished while running, finish it from a looper callback ...
+    const Json::Value copy = *response;
+    ScheduleCallbackOnLooperThread(/* a_id */ "idempotent:" + a_sequence->rcid(),
+                                   /* a_callback */
+                                   [this, a_sequence, copy] (const std::string& /* a_id */) {
+                                       FinalizeJob(*a_sequence, copy);
+                                   },
+                                   /* a_deferred  */ 0,
+                                   /* a_recurrent */ false
+    );
+    
+    return true;
+}
+
+/**
+ * @brief Keep track of an in-flight sequence idempotency key, so identical jobs can be attached to it.
+ *
+ * @param a_key      Idempotency key, as returned by \link IdempotencyKey \link.
+ * @param a_identity Sequence identity, as set by \link IdempotencyKey \link.
+ * @param a_sequence Sequence info, registered and launched.
+ *
+ * @note On a key collision with another in-flight sequence, this one is not tracked - identical jobs are just not coalesced.
+ */
+void casper::job::Sequencer::LeadSequence (const uint64_t a_key, const std::string& a_identity, const sequencer::SharedSequence& a_sequence)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    if ( false == idempotency_keys_.insert(std::make_pair(a_key, a_sequence->rjnr())).second ) {
+        return;
+    }
+    Coalesced& coalesced = coalesced_[a_sequence->rjnr()];
+    coalesced.key_      = a_key;
+    coalesced.identity_ = a_identity;
+}
+
 #ifdef __APPLE__
 #pragma mark -
 #endif
 
+/**
+ * @brief Launch a sequence step, an activity or all activities of a parallel group.
+ *
+ * @param a_tracking Call tracking purposes.
+ * @param a_activity Activity info, first activity of the group ( if it's a group ).
+ * @param a_at_run   True when called from 'run' method.
+ *
+ * @return HTTP status code, of the first activity when it's a group.
+ */
+uint16_t casper::job::Sequencer::LaunchStep (const casper::job::sequencer::Tracking& a_tracking,
+                                             casper::job::sequencer::Activity& a_activity, const bool a_at_run)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    size_t first = 0;
+    size_t count = 0;
+    // ... not a parallel group?
+    if ( false == sequencer::Parallel::Get(a_activity.payload()["job"], first, count) || first != a_activity.index() ) {
+        return LaunchActivity(a_tracking, a_activity, a_at_run);
+    }
+    
+    const sequencer::SharedSequence sequence = a_activity.shared_sequence();
+    const uint64_t                  rjnr     = sequence->rjnr();
+    
+    // ... log ...
+    SEQUENCER_LOG_SEQUENCE(CC_JOB_LOG_LEVEL_INF, (*sequence), CC_JOB_LOG_STEP_STEP,
+                           "Launching parallel group ( " SIZET_FMT " to " SIZET_FMT " )",
+                           ( first + 1 ), ( first + count )
+    );
+    
+    // ... track group first, activities might return ( fail ) while being launched ...
+    sequences_[rjnr].group_.reset(new ParallelGroup({ /* first_ */ first, /* count_ */ count, /* pending_ */ count, /* ended_ */ nullptr, /* response_ */ Json::Value::null }));
+    
+    const auto forget = [this, rjnr] () {
+        SequenceState* state = FindSequenceState(rjnr);
+        if ( nullptr != state ) {
+            state->group_.reset();
+            TrimSequenceState(rjnr);
+        }
+    };
+    
+    uint16_t sc = 500;
+    try {
+        sc = LaunchActivity(a_tracking, a_activity, a_at_run);
+    } catch (...) {
+        forget();
+        throw;
+    }
+    // ... at 'run', errors are reported to caller and no other activity is launched ...
+    if ( true == a_at_run && 200 != sc ) {
+        forget();
+        return sc;
+    }
+    
+    // ... launch all other activities ...
+    for ( size_t index = first + 1 ; index < first + count ; ++index ) {
+        // ... ( state is looked up again, a launched activity might have returned ) ...
+        SequenceState* state = FindSequenceState(rjnr);
+        if ( nullptr == state || nullptr == state->group_ ) {
+            break;
+        }
+        ParallelGroup& group = *state->group_;
+        if ( nullptr == group.ended_ ) {
+            sequencer::Activity member = sequencer::Activity(/* a_sequence */ sequence, /* a_id */ "", /* a_index */ index, /* a_attempt */ 0);
+            if ( true == LoadActivity(sequence, index, member) ) {
+                (void)LaunchActivity(a_tracking, member, /* a_at_run */ false);
+                continue;
+            }
+            // ... data must be previously set on DB ...
+            Json::Value response = Json::Value::null;
+            (void)SetFailedResponse(/* a_code */ 500, Json::Value("No data available for activity #" + std::to_string(index + 1) + " ( from db )!"), response);
+            member.Reset(sequencer::Status::Failed, response);
+            group.ended_    = std::make_shared<sequencer::Activity>(member);
+            group.response_ = response;
+        }
+        // ... sequence will end, remaining activities won't be launched ...
+        group.pending_ -= ( first + count - index );
+        if ( 0 == group.pending_ ) {
+            GroupReturned(a_tracking, sequence);
+        }
+        break;
+    }
+    
+    return sc;
+}
+
 /**
  * @brief Launch an activity ( a.k.a inner job ).
  *
@@ -472,8 +856,6 @@ uint16_t casper::job::Sequencer::LaunchActivity (const casper::job::sequencer::T
     // ... log ...
     SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_VBS, a_activity, CC_JOB_LOG_STEP_STEP,
                            "%s", "Launching");
-        
-    const std::string seq_id_key = config_.service_id() + ":jobs:sequential_id";
 
     typedef struct {
         std::string tube_;
@@ -487,120 +869,122 @@ uint16_t casper::job::Sequencer::LaunchActivity (const casper::job::sequencer::T
         Json::Value abort_obj_;
         Json::Value abort_result_;
         bool        subscribed_;
+        bool        queued_;
+        std::string items_expr_;
+        Json::Value items_;
+        size_t      concurrency_;
+        size_t      max_items_;
+        bool        mapped_;
+        Branch      branch_;
+        size_t      target_;
+        Json::Value hedge_obj_;
+        Json::Value retry_obj_;
+        bool        memoize_;
+        Json::Value memoized_;
+        bool        local_;
     } ActivityJob;
     
     ActivityJob job_defs;
     
     try {
         
-        const auto job       = GetJSONObject(a_activity.payload(), "job"     , Json::ValueType::objectValue, /* a_default */ nullptr);
+        const auto& job      = GetJSONObject(a_activity.payload(), "job"     , Json::ValueType::objectValue, /* a_default */ nullptr);
         job_defs.tube_       = GetJSONObject(job                 , "tube"    , Json::ValueType::stringValue, /* a_default */ nullptr).asString();
         job_defs.expires_in_ = GetJSONObject(job                 , "validity", Json::ValueType::intValue   , &activity_config_.validity_).asUInt();
         job_defs.ttr_        = GetJSONObject(job                 , "ttr"     , Json::ValueType::intValue   , &activity_config_.ttr_).asUInt();
         job_defs.abort_obj_  = GetJSONObject(job                 , "abort"   , Json::ValueType::objectValue, &Json::Value::null);
+        // ... 'map' step?
+        const auto& map = GetJSONObject(job, "map", Json::ValueType::objectValue, &Json::Value::null);
+        if ( false == map.isNull() ) {
+            const Json::Value default_concurrency = Json::Value(Json::UInt(map_concurrency_));
+            job_defs.items_expr_  = GetJSONObject(map, "items"      , Json::ValueType::stringValue, /* a_default */ nullptr).asString();
+            job_defs.concurrency_ = std::max(static_cast<size_t>(1), static_cast<size_t>(GetJSONObject(map, "concurrency", Json::ValueType::uintValue, &default_concurrency).asUInt()));
+            job_defs.max_items_   = static_cast<size_t>(GetJSONObject(map, "max_items", Json::ValueType::uintValue, &Json::Value::null).asUInt());
+        } else {
+            job_defs.concurrency_ = 0;
+            job_defs.max_items_   = 0;
+        }
+        // ... conditional skip and branch?
+        job_defs.branch_.skip_if_ = GetJSONObject(job, "skip_if", Json::ValueType::stringValue, &Json::Value::null).asString();
+        job_defs.branch_.next_if_ = GetJSONObject(job, "next_if", Json::ValueType::stringValue, &Json::Value::null).asString();
+        // ... hedging?
+        job_defs.hedge_obj_       = GetJSONObject(job, "hedge"  , Json::ValueType::objectValue, &Json::Value::null);
+        // ... memoization opt-out?
+        const Json::Value default_memoize = Json::Value(true);
+        job_defs.memoize_         = GetJSONObject(job, "memoize", Json::ValueType::booleanValue, &default_memoize).asBool();
+        // ... retry policy?
+        const auto& retry = GetJSONObject(job, "retry", Json::ValueType::objectValue, &Json::Value::null);
+        if ( false == retry.isNull() ) {
+            const Json::Value default_attempts    = Json::Value(Json::UInt(3));
+            const Json::Value default_backoff     = Json::Value(Json::UInt(1000));
+            const Json::Value default_max_backoff = Json::Value(Json::UInt(60000));
+            Json::Value       default_on          = Json::Value(Json::ValueType::arrayValue);
+            default_on.append("failed");
+            default_on.append("error");
+            job_defs.retry_obj_                = Json::Value(Json::ValueType::objectValue);
+            job_defs.retry_obj_["attempts"]    = std::max(Json::UInt(1), GetJSONObject(retry, "attempts", Json::ValueType::uintValue, &default_attempts).asUInt());
+            job_defs.retry_obj_["backoff"]     = GetJSONObject(retry, "backoff"    , Json::ValueType::uintValue , &default_backoff).asUInt();
+            job_defs.retry_obj_["max_backoff"] = GetJSONObject(retry, "max_backoff", Json::ValueType::uintValue , &default_max_backoff).asUInt();
+            job_defs.retry_obj_["on"]          = GetJSONObject(retry, "on"         , Json::ValueType::arrayValue, &default_on);
+            // ... only 'failed' or 'error' statuses can be retried, 'cancelled' is final ...
+            for ( const auto& status : job_defs.retry_obj_["on"] ) {
+                if ( false == status.isString() ) {
+                    throw ::ev::Exception("Invalid 'retry.on' entry: a status name is expected!");
+                }
+                if ( 0 != status.asString().compare("failed") && 0 != status.asString().compare("error") ) {
+                    throw ::ev::Exception("Invalid 'retry.on' status '%s'!", status.asCString());
+                }
+            }
+        }
     } catch (const ev::Exception& a_ev_exception) {
         throw sequencer::JSONValidationException(a_tracking, a_ev_exception.what());
     }
     
     job_defs.id_           = 0;
-    job_defs.key_          = ( config_.service_id() + ":jobs:" + job_defs.tube_ + ':' );
-    job_defs.channel_      = ( config_.service_id() + ':'      + job_defs.tube_ + ':' );
     job_defs.sc_           = 500;
     job_defs.ew_           = "";
     job_defs.abort_result_ = Json::Value::null;
     job_defs.subscribed_   = false;
-    
-    // ...
-    osal::ConditionVariable cv;
-    ExecuteOnMainThread([this, &cv, &job_defs, &seq_id_key] () {
-
-        NewTask([this, &seq_id_key] () -> ::ev::Object* {
-            
-            // ...  get new job id ...
-            return new ::ev::redis::Request(loggable_data_, "INCR", {
-                /* key   */ seq_id_key
-            });
-            
-        })->Then([this, &job_defs] (::ev::Object* a_object) -> ::ev::Object* {
-            
-            //
-            // INCR:
-            //
-            // - An integer reply is expected:
-            //
-            //  - the value of key after the increment
-            //
-            const ::ev::redis::Value& value = ::ev::redis::Reply::EnsureIntegerReply(a_object);
-            
-            job_defs.id_       = static_cast<uint64_t>(value.Integer());
-            job_defs.key_     += std::to_string(job_defs.id_);
-            job_defs.channel_ += std::to_string(job_defs.id_);
-            
-            // ... first, set queued status ...
-            return new ::ev::redis::Request(loggable_data_, "HSET", {
-                /* key   */ job_defs.key_,
-                /* field */ "status", "{\"status\":\"queued\"}"
-            });
-            
-        })->Then([this, &job_defs] (::ev::Object* a_object) -> ::ev::Object* {
-            
-            //
-            // HSET:
-            //
-            // - An integer reply is expected:
-            //
-            //  - 1 if field is a new field in the hash and value was set.
-            //  - 0 if field already exists in the hash and the value was updated.
-            //
-            (void)::ev::redis::Reply::EnsureIntegerReply(a_object);
-            
-            return new ::ev::redis::Request(loggable_data_, "EXPIRE", { job_defs.key_, std::to_string(job_defs.expires_in_) });
-            
-        })->Finally([&cv, &job_defs] (::ev::Object* a_object) {
-            
-            //
-            // EXPIRE:
-            //
-            // Integer reply, specifically:
-            // - 1 if the timeout was set.
-            // - 0 if key does not exist or the timeout could not be set.
-            //
-            ::ev::redis::Reply::EnsureIntegerReply(a_object, 1);
-
-            //
-            // DONE
-            //
-            job_defs.sc_ = 200;
-            
-            // RELEASE job control
-            cv.Wake();
-            
-        })->Catch([&cv, &job_defs] (const ::ev::Exception& a_ev_exception) {
-            
-            job_defs.sc_ = 500;
-            job_defs.ew_ = a_ev_exception.what();
-            
-            // RELEASE job control
-            cv.Wake();
-            
-        });
-
-    }, /* a_blocking */ false);
-
-    // WAIT until REDIS key is reserved
-    cv.Wait();
+    job_defs.queued_       = false;
+    job_defs.items_        = Json::Value::null;
+    job_defs.mapped_       = false;
+    job_defs.branch_.skip_ = false;
+    job_defs.branch_.next_ = Json::Value::null;
+    job_defs.target_       = std::string::npos;
+    job_defs.memoized_     = Json::Value::null;
+    job_defs.local_        = false;
+    
+    // ... reserve REDIS job, using speculatively reserved one ( if any ) ...
+    const auto reserve = [this, &sequence, &job_defs] () {
+        const uint64_t reserve_start = sequencer::Stats::Now();
+        job_defs.sc_ = ReserveActivityJob(sequence.rjnr(), job_defs.tube_, job_defs.expires_in_, job_defs.id_, job_defs.key_, job_defs.channel_, job_defs.ew_);
+        metrics_.Observe(sequencer::Metrics::Latency::Redis, stats_.Record(job_defs.tube_, sequencer::Stats::Stage::Reserve, reserve_start));
+    };
+    
+    // ... might be skipped ( or branched ) or memoized? REDIS job is only reserved after patch, if still needed ...
+    const bool deferred = ( 0 != job_defs.branch_.skip_if_.length() || 0 != job_defs.branch_.next_if_.length()
+                           || ( true == job_defs.memoize_ && 0 == job_defs.items_expr_.length() && true == memo_.Enabled(job_defs.tube_) ) );
     
     //
-    // CONTINUE OR ROLLBACK?
+    // RESERVE OR DEFER
     //
-    if ( 200 != job_defs.sc_ ) {
-        // ... log ...
-        SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_ERR, a_activity, CC_JOB_LOG_STEP_ERROR,
-                               "An error occurred while launching activity ~ %s",
-                               job_defs.ew_.c_str()
-        );
-        // ... an error is already set ...
-        return job_defs.sc_;
+    if ( false == deferred ) {
+        reserve();
+        if ( 200 != job_defs.sc_ ) {
+            // ... log ...
+            SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_ERR, a_activity, CC_JOB_LOG_STEP_ERROR,
+                                   "An error occurred while launching activity ~ %s",
+                                   job_defs.ew_.c_str()
+            );
+            // ... an error is already set ...
+            return job_defs.sc_;
+        }
+    } else {
+        // ... a local job number, replaced by a REDIS one if activity is not finalized locally ...
+        job_defs.id_      = ++local_rjnr_;
+        job_defs.key_     = ( config_.service_id() + ":jobs:" + job_defs.tube_ + ':' + std::to_string(job_defs.id_) );
+        job_defs.channel_ = ( config_.service_id() + ':'      + job_defs.tube_ + ':' + std::to_string(job_defs.id_) );
+        job_defs.sc_      = 200;
     }
     
     sequencer::Exception* exception = nullptr;
@@ -611,10 +995,9 @@ uint16_t casper::job::Sequencer::LaunchActivity (const casper::job::sequencer::T
     try {
         // ... bind ids ...
         a_activity.Bind(/* rjnr_ */ job_defs.id_, /* a_rjid */ job_defs.key_, /* a_rcnm */ job_defs.tube_, /* a_rcid */ job_defs.channel_, /* a_new_attempt */ true);
-        // ... grab job object ...
-        const auto job = GetJSONObject(a_activity.payload(), "job" , Json::ValueType::objectValue, /* a_default */ nullptr);
-        // .. first, copy payload ( so it can be patched ) ...
-        Json::Value        payload = job["payload"];
+        // ... grab job payload, moved out of activity ( it will be replaced by the patched one ) ...
+        Json::Value        payload;
+        payload.swap(a_activity.DetachPayload()["job"]["payload"]);
         Json::StyledWriter jsw;
         // ... log ...
         CC_DEBUG_LOG_MSG("job", "Job #" INT64_FMT " ~= patching activity #" SIZET_FMT " - %s",
@@ -633,35 +1016,132 @@ uint16_t casper::job::Sequencer::LaunchActivity (const casper::job::sequencer::T
         if ( false == payload.isMember("validity") ) {
             payload["validity"] = job_defs.expires_in_;
         }
-        // ... debug only ...
-        CC_DEBUG_LOG_MSG("job", "Job #" INT64_FMT " ~= after patch:\n%s",
-                         sequence.bjid(), jsw.write(payload).c_str()
-        );
         // ... log ...
         CC_DEBUG_LOG_MSG("job", "Job #" INT64_FMT " ~= patched activity #" SIZET_FMT " - %s",
                           sequence.bjid(), ( a_activity.index() + 1 ), a_activity.rcid().c_str()
         );
         // ... tmp track payload, ttr and validity ...
-        a_activity.SetPayload(payload);
+        a_activity.SetPayload(std::move(payload));
         a_activity.SetTTR(job_defs.ttr_);
         a_activity.SetValidity(job_defs.ttr_);
         a_activity.SetAbortCondition(job_defs.abort_obj_);
+        a_activity.SetRetryPolicy(job_defs.retry_obj_);
         // ... if required, evaluate all string fields as V8 expressions ...
-        PatchActivity(a_tracking, a_activity, job_defs.abort_result_);
-        // ... now register activity attempt to launch @ db ...
+        PatchActivity(a_tracking, a_activity, job_defs.abort_result_, job_defs.items_expr_, job_defs.items_, job_defs.branch_);
+        // ... branch to another activity?
+        if ( false == job_defs.branch_.next_.isNull() ) {
+            job_defs.target_ = ResolveBranch(a_activity, job_defs.branch_.next_);
+        }
+        // ... 'map' step? sequence 'ttr' only accounts for ceil(max_items / concurrency) waves ...
+        if ( 0 != job_defs.items_expr_.length() && true == job_defs.items_.isArray() ) {
+            const size_t count = static_cast<size_t>(job_defs.items_.size());
+            if ( 0 != job_defs.max_items_ && count > job_defs.max_items_ ) {
+                throw ::cc::Exception("'map' step has " SIZET_FMT " item(s), more than 'max_items' ( " SIZET_FMT " )!", count, job_defs.max_items_);
+            } else if ( 0 == job_defs.max_items_ && count > job_defs.concurrency_ ) {
+                SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_WRN, a_activity, CC_JOB_LOG_STEP_TTR,
+                                       SIZET_FMT " item(s) will run in " SIZET_FMT " waves, but sequence 'ttr' only accounts for one - 'max_items' should be set",
+                                       count, ( count + job_defs.concurrency_ - 1 ) / job_defs.concurrency_
+                );
+            }
+        }
+        // ... memoized tube? an identical activity ( same patched payload, except 'id' ) may have returned recently ...
+        if ( true == job_defs.memoize_ && true == job_defs.abort_result_.isNull() && false == job_defs.branch_.skip_
+            && 0 == job_defs.items_expr_.length() && true == memo_.Enabled(job_defs.tube_) ) {
+            Json::FastWriter fw; fw.omitEndingLineFeed();
+            Json::Value      key = a_activity.payload();
+            key.removeMember("id");
+            // ... serialized key is kept, a hash collision must not return another activity response ...
+            const auto data = std::make_shared<const std::string>(fw.write(key));
+            a_activity.SetMemoKey(sequencer::Memo::Hash(*data), data);
+            const Json::Value* response = memo_.Get(job_defs.tube_, a_activity.memo_key(), *data);
+            if ( nullptr != response ) {
+                job_defs.memoized_ = *response;
+                metrics_.Count(job_defs.tube_, sequencer::Metrics::Counter::MemoHit);
+            } else {
+                metrics_.Count(job_defs.tube_, sequencer::Metrics::Counter::MemoMiss);
+            }
+        }
+        // ... skipped or memoized? it's finalized locally, no REDIS job is needed ...
+        job_defs.local_ = ( true == job_defs.abort_result_.isNull() && ( true == job_defs.branch_.skip_ || false == job_defs.memoized_.isNull() ) );
+        if ( true == deferred && false == job_defs.local_ ) {
+            reserve();
+            if ( 200 != job_defs.sc_ ) {
+                throw sequencer::Exception(a_tracking, job_defs.sc_, job_defs.ew_.c_str());
+            }
+            // ... same attempt, bound to the REDIS job ...
+            a_activity.Bind(/* rjnr_ */ job_defs.id_, /* a_rjid */ job_defs.key_, /* a_rcnm */ job_defs.tube_, /* a_rcid */ job_defs.channel_, /* a_new_attempt */ false);
+            Json::Value payload = a_activity.DetachPayload();
+            payload["id"] = std::to_string(job_defs.id_);
+            a_activity.SetPayload(std::move(payload));
+            a_activity.SerializePayload();
+        }
+        // ... now register activity attempt to launch @ db ( a local one too, js.finalize_activity expects a registered attempt ) ...
+        uint64_t stage_start = sequencer::Stats::Now();
         RegisterActivity(a_activity);
-        // ... track activity ...
-        TrackActivity(a_activity);
-        // ... NOT aborted?
-        if ( true == job_defs.abort_result_.isNull() ) {
+        stats_.Record(job_defs.tube_, sequencer::Stats::Stage::Register, stage_start);
+        // ... 'map' step NOT aborted? activity itself is never pushed, one activity per item is launched and tracked instead ...
+        job_defs.mapped_ = ( 0 != job_defs.items_expr_.length() && true == job_defs.abort_result_.isNull() && false == job_defs.branch_.skip_ );
+        if ( true == job_defs.mapped_ ) {
+            StartMap(a_tracking, a_activity, std::move(job_defs.items_), job_defs.expires_in_, job_defs.concurrency_);
+        } else {
+            // ... track activity ...
+            TrackActivity(a_activity);
+        }
+        // ... skipped? it's finalized locally, with a synthetic response, by a looper callback ...
+        if ( true == job_defs.local_ && true == job_defs.branch_.skip_ ) {
+            skips_[a_activity.rjnr()] = job_defs.target_;
+            ScheduleCallbackOnLooperThread(/* a_id */ "skip:" + a_activity.rcid(),
+                                           /* a_callback */ std::bind(&casper::job::Sequencer::OnSkipTimer, this, std::placeholders::_1),
+                                           /* a_deferred  */ 0,
+                                           /* a_recurrent */ false
+            );
+        } else if ( false == job_defs.memoized_.isNull() ) {
+            // ... memoized? it's finalized locally, with the cached response, by a looper callback ...
+            memoized_[a_activity.rjnr()] = job_defs.memoized_;
+            ScheduleCallbackOnLooperThread(/* a_id */ "memo:" + a_activity.rcid(),
+                                           /* a_callback */ std::bind(&casper::job::Sequencer::OnMemoTimer, this, std::placeholders::_1),
+                                           /* a_deferred  */ 0,
+                                           /* a_recurrent */ false
+            );
+        } else if ( false == job_defs.mapped_ && true == job_defs.abort_result_.isNull() ) { // ... NOT aborted?
             // ... then, listen to REDIS job channel ...
+            stage_start = sequencer::Stats::Now();
             SubscribeActivity(a_activity);
+            metrics_.Observe(sequencer::Metrics::Latency::Redis, stats_.Record(job_defs.tube_, sequencer::Stats::Stage::Subscribe, stage_start));
             job_defs.subscribed_ = true;
-            // ... now, push job ( send it to beanstalkd ) ...
-            PushActivity(a_activity);
+            // ... while draining messages, push job along with all others launched at this looper tick ...
+            if ( true == pushes_deferred_ && false == a_at_run ) {
+                QueueActivityPush(a_activity);
+                job_defs.queued_ = true;
+            } else {
+                // ... now, push job ( send it to beanstalkd ) ...
+                PushActivity(a_activity);
+                // ... worker execution time is measured from now until activity returns ...
+                sequencer::Activity* tracked = running_activities_.Find(a_activity.rjnr());
+                if ( nullptr != tracked ) {
+                    tracked->SetPushedAt(sequencer::Stats::Now());
+                }
+            }
+            // ... while it runs, reserve next activity REDIS job ...
+            ReserveNextActivityJob(a_activity);
+            // ... hedging? if it did not return after a delay ( or tube's p95 execution time ) launch another attempt ...
+            if ( false == job_defs.hedge_obj_.isNull() ) {
+                const Json::Value p95   = Json::Value(static_cast<Json::UInt64>(stats_.Percentile(job_defs.tube_, sequencer::Stats::Stage::Execution, 95.0) / 1000));
+                const Json::UInt  after = GetJSONObject(job_defs.hedge_obj_, "after", Json::ValueType::uintValue, &p95).asUInt();
+                if ( 0 != after ) {
+                    ScheduleCallbackOnLooperThread(/* a_id */ "hedge:" + a_activity.rcid(),
+                                                   /* a_callback */ std::bind(&casper::job::Sequencer::OnHedgeTimer, this, std::placeholders::_1),
+                                                   /* a_deferred  */ static_cast<size_t>(after),
+                                                   /* a_recurrent */ false
+                    );
+                }
+            }
         }
     } catch (const sequencer::V8ExpressionEvaluationException& a_v8eee) {
         exception = new sequencer::V8ExpressionEvaluationException(a_tracking, a_v8eee);
+    } catch (const sequencer::Exception& a_sequencer_exception) {
+        // ... keep it's status code ...
+        exception = new sequencer::Exception(a_tracking, a_sequencer_exception.code_, a_sequencer_exception.what());
     } catch (...) {
         // ... recapture exception ...
         try {
@@ -707,7 +1187,7 @@ uint16_t casper::job::Sequencer::LaunchActivity (const casper::job::sequencer::T
             // ... override with errors serialization ...
             (void)SetFailedResponse(/* a_code */ exception->code_, payload, errors);
             // ... reset
-            a_activity.Reset(sequencer::Status::Failed, /* a_payload */ errors);
+            a_activity.Reset(sequencer::Status::Failed, /* a_payload */ std::move(errors));
             // ... get rid of exception ...
             delete exception;
             exception = nullptr;
@@ -730,6 +1210,7 @@ uint16_t casper::job::Sequencer::LaunchActivity (const casper::job::sequencer::T
         SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, a_activity, CC_JOB_LOG_STEP_STEP,
                                CC_JOB_LOG_COLOR(YELLOW) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
                                "ABORTING as requested by 'abort_expr' evaluation...");
+        metrics_.Count(job_defs.tube_, sequencer::Metrics::Counter::Aborted);
         // ... and this activity ...
         UntrackActivity(a_activity); // ... ⚠️  a_activity STILL valid - it's the original one! ⚠️ ...
         // ... unsubscribe activity?
@@ -737,7 +1218,7 @@ uint16_t casper::job::Sequencer::LaunchActivity (const casper::job::sequencer::T
             UnsubscribeActivity(a_activity);
         }
         //...
-        Json::Value payload = job_defs.abort_result_;
+        Json::Value payload = std::move(job_defs.abort_result_);
         // ... override with errors serialization ...
         Json::Value message;
         if ( 0 != a_activity.abort_msg().length() ) {
@@ -755,86 +1236,1154 @@ uint16_t casper::job::Sequencer::LaunchActivity (const casper::job::sequencer::T
         Json::Value response;
         (void)SetFailedResponse(job_defs.sc_, payload, response);
         // ... reset
-        a_activity.Reset(sequencer::Status::Failed, /* a_payload */ response);
+        a_activity.Reset(sequencer::Status::Failed, /* a_payload */ std::move(response));
         if ( false == a_at_run ) {
             // ... just 'finalize' activity ( by setting failed status ) ...
             (void)ActivityReturned(a_tracking, a_activity, /* a_response */ nullptr);
         }
-    } else if ( sequencer::Status::Failed != a_activity.status() ) {
+    } else if ( true == job_defs.branch_.skip_ && sequencer::Status::Failed != a_activity.status() ) {
+        // ... log ...
+        SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, a_activity, CC_JOB_LOG_STEP_STEP,
+                               CC_JOB_LOG_COLOR(YELLOW) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
+                               ( std::string::npos != job_defs.target_ ? "SKIPPING, branching as requested by 'next_if' evaluation..." : "SKIPPING as requested by 'skip_if' evaluation..." ));
+        metrics_.Count(job_defs.tube_, sequencer::Metrics::Counter::Skipped);
+    } else if ( false == job_defs.memoized_.isNull() && sequencer::Status::Failed != a_activity.status() ) {
+        // ... log ...
+        SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, a_activity, CC_JOB_LOG_STEP_STEP,
+                               CC_JOB_LOG_COLOR(YELLOW) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
+                               "MEMOIZED, reusing a previous result...");
+    } else if ( sequencer::Status::Failed != a_activity.status() && false == job_defs.queued_ && false == job_defs.mapped_ ) {
         // ... log ...
         SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, a_activity, CC_JOB_LOG_STEP_STEP,
                                "Launched with REDIS channel ID %s", a_activity.rcid().c_str());
+        metrics_.Count(job_defs.tube_, sequencer::Metrics::Counter::Launched);
     }
     // ... we're done ...
     return job_defs.sc_;
 }
 
 /**
- * @brief Call this method when an activity has a message to be relayed to the sequencer job.
+ * @brief Reserve a REDIS job id for an activity and set it's status as 'queued'.
  *
- * @param a_tracking Call tracking purposes.
- * @param a_activity Activity info.
- * @param a_message  JSON object to relay.
+ * @param a_rjnr       Sequence REDIS job number, it's speculatively reserved REDIS job ( if any ) is used.
+ * @param a_tube       Activity tube.
+ * @param a_expires_in REDIS job key validity, in seconds.
+ * @param o_id         Set with REDIS job number.
+ * @param o_key        Set with REDIS job key.
+ * @param o_channel    Set with REDIS job channel.
+ * @param o_error      Set with error message, on failure.
  *
- * @return HTTP status code.
-*/
-void casper::job::Sequencer::ActivityMessageRelay (const casper::job::sequencer::Tracking& /* a_tracking */,
-                                                   const casper::job::sequencer::Activity& a_activity, const Json::Value& a_message)
+ * @return HTTP status code, 200 on success.
+ */
+uint16_t casper::job::Sequencer::ReserveActivityJob (const uint64_t a_rjnr, const std::string& a_tube, const int64_t a_expires_in,
+                                                     uint64_t& o_id, std::string& o_key, std::string& o_channel, std::string& o_error)
 {
     CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
     
-    const std::string src_channel_key = a_activity.rcid();
+    const std::string seq_id_key = config_.service_id() + ":jobs:sequential_id";
+    
+    struct {
+        int64_t     expires_in_;
+        uint64_t    id_;
+        std::string key_;
+        std::string channel_;
+        uint16_t    sc_;
+        std::string ew_; // exception 'what'
+    } job;
+    
+    job.expires_in_ = a_expires_in;
+    job.id_         = 0;
+    job.key_        = ( config_.service_id() + ":jobs:" + a_tube + ':' );
+    job.channel_    = ( config_.service_id() + ':'      + a_tube + ':' );
+    job.sc_         = 500;
+    job.ew_         = "";
+    
+    // ... speculatively reserved?
+    bool           ready = false;
+    SequenceState* state = FindSequenceState(a_rjnr);
+    if ( nullptr != state && nullptr != state->reservation_ && 0 != state->reservation_->id_ ) {
+        job.id_ = state->reservation_->id_;
+        // ... for this tube? then it's REDIS job key is already set ...
+        ready   = ( 0 == state->reservation_->tube_.compare(a_tube) );
+        state->reservation_.reset();
+    }
+    
+    if ( 0 != job.id_ ) {
+        job.key_     += std::to_string(job.id_);
+        job.channel_ += std::to_string(job.id_);
+    }
+    
+    // ... already set? only refresh it's validity, without waiting ...
+    if ( true == ready ) {
+        const std::string key        = job.key_;
+        const std::string expires_in = std::to_string(job.expires_in_);
+        ExecuteOnMainThread([this, key, expires_in] () {
+            NewTask([this, key, expires_in] () -> ::ev::Object* {
+                return new ::ev::redis::Request(loggable_data_, "EXPIRE", { key, expires_in });
+            })->Finally([] (::ev::Object* /* a_object */) {
+                // ... nothing to do ...
+            })->Catch([] (const ::ev::Exception& /* a_ev_exception */) {
+                // ... key keeps it's speculative validity ...
+            });
+        }, /* a_blocking */ false);
+        o_id      = job.id_;
+        o_key     = job.key_;
+        o_channel = job.channel_;
+        o_error   = "";
+        return 200;
+    }
+    
+    osal::ConditionVariable cv;
+    ExecuteOnMainThread([this, &cv, &job, &seq_id_key] () {
+        
+        // ... set queued status ...
+        const auto hset = [this, &job] () -> ::ev::Object* {
+            return new ::ev::redis::Request(loggable_data_, "HSET", {
+                /* key   */ job.key_,
+                /* field */ "status", "{\"status\":\"queued\"}"
+            });
+        };
+        
+        const auto expire = [this, &job] (::ev::Object* a_object) -> ::ev::Object* {
+            
+            //
+            // HSET:
+            //
+            // - An integer reply is expected:
+            //
+            //  - 1 if field is a new field in the hash and value was set.
+            //  - 0 if field already exists in the hash and the value was updated.
+            //
+            (void)::ev::redis::Reply::EnsureIntegerReply(a_object);
+            
+            return new ::ev::redis::Request(loggable_data_, "EXPIRE", { job.key_, std::to_string(job.expires_in_) });
+            
+        };
+        
+        const auto done = [&cv, &job] (::ev::Object* a_object) {
+            
+            //
+            // EXPIRE:
+            //
+            // Integer reply, specifically:
+            // - 1 if the timeout was set.
+            // - 0 if key does not exist or the timeout could not be set.
+            //
+            ::ev::redis::Reply::EnsureIntegerReply(a_object, 1);
+
+            //
+            // DONE
+            //
+            job.sc_ = 200;
+            
+            // RELEASE job control
+            cv.Wake();
+            
+        };
+        
+        const auto failed = [&cv, &job] (const ::ev::Exception& a_ev_exception) {
+            
+            job.sc_ = 500;
+            job.ew_ = a_ev_exception.what();
+            
+            // RELEASE job control
+            cv.Wake();
+            
+        };
+        
+        // ... already reserved?
+        if ( 0 != job.id_ ) {
+            NewTask(hset)->Then(expire)->Finally(done)->Catch(failed);
+            return;
+        }
+
+        NewTask([this, &seq_id_key] () -> ::ev::Object* {
+            
+            // ...  get new job id ...
+            return new ::ev::redis::Request(loggable_data_, "INCR", {
+                /* key   */ seq_id_key
+            });
+            
+        })->Then([&job, hset] (::ev::Object* a_object) -> ::ev::Object* {
+            
+            //
+            // INCR:
+            //
+            // - An integer reply is expected:
+            //
+            //  - the value of key after the increment
+            //
+            const ::ev::redis::Value& value = ::ev::redis::Reply::EnsureIntegerReply(a_object);
+            
+            job.id_       = static_cast<uint64_t>(value.Integer());
+            job.key_     += std::to_string(job.id_);
+            job.channel_ += std::to_string(job.id_);
+            
+            // ... first, set queued status ...
+            return hset();
+            
+        })->Then(expire)->Finally(done)->Catch(failed);
+
+    }, /* a_blocking */ false);
+
+    // WAIT until REDIS key is reserved
+    cv.Wait();
+    
+    o_id      = job.id_;
+    o_key     = job.key_;
+    o_channel = job.channel_;
+    o_error   = job.ew_;
+    
+    return job.sc_;
+}
+
+/**
+ * @brief Speculatively reserve, in background, a REDIS job for the next activity of a sequence.
+ *
+ * @param a_activity Running activity info.
+ */
+void casper::job::Sequencer::ReserveNextActivityJob (const casper::job::sequencer::Activity& a_activity)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    // ... last activity?
+    const size_t index = a_activity.index() + 1;
+    if ( index >= a_activity.sequence().count() ) {
+        return;
+    }
+    
+    // ... REDIS job key depends on next activity tube ...
+    const Json::Value& job  = a_activity.sequence().activities()[static_cast<Json::ArrayIndex>(index)]["job"];
+    const Json::Value& tube = job["tube"];
+    if ( false == tube.isString() ) {
+        return;
+    }
+    const Json::Value& validity = job["validity"];
+    
+    ReserveNextJob(a_activity.sequence().rjnr(), tube.asString(), static_cast<int64_t>(( true == validity.isUInt() ? validity : activity_config_.validity_ ).asUInt()));
+}
+
+/**
+ * @brief Speculatively reserve, in background, a REDIS job id and set it's status as 'queued'.
+ *
+ * @param a_rjnr       Sequence REDIS job number.
+ * @param a_tube       Tube of the activity that will use it.
+ * @param a_expires_in REDIS job key validity, in seconds.
+ */
+void casper::job::Sequencer::ReserveNextJob (const uint64_t a_rjnr, const std::string& a_tube, const int64_t a_expires_in)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    // ... already reserved ( or being reserved )?
+    SequenceState& state = sequences_[a_rjnr];
+    if ( nullptr != state.reservation_ ) {
+        return;
+    }
+    
+    // ... mark as being reserved ...
+    state.reservation_.reset(new Reservation({ /* id_ */ 0, /* tube_ */ a_tube }));
+    
+    const std::string seq_id_key = config_.service_id() + ":jobs:sequential_id";
+    const std::string key        = config_.service_id() + ":jobs:" + a_tube + ':';
+    const std::string expires_in = std::to_string(a_expires_in);
+    
+    // ... don't wait, result is handed over to looper thread ...
+    ExecuteOnMainThread([this, a_rjnr, seq_id_key, key, expires_in] () {
+        
+        const std::shared_ptr<uint64_t> id = std::make_shared<uint64_t>(0);
+        
+        NewTask([this, seq_id_key] () -> ::ev::Object* {
+            
+            // ...  get new job id ...
+            return new ::ev::redis::Request(loggable_data_, "INCR", {
+                /* key   */ seq_id_key
+            });
+            
+        })->Then([this, id, key] (::ev::Object* a_object) -> ::ev::Object* {
+            
+            //
+            // INCR:
+            //
+            // - An integer reply is expected:
+            //
+            //  - the value of key after the increment
+            //
+            (*id) = static_cast<uint64_t>(::ev::redis::Reply::EnsureIntegerReply(a_object).Integer());
+            
+            // ... set queued status ...
+            return new ::ev::redis::Request(loggable_data_, "HSET", {
+                /* key   */ key + std::to_string(*id),
+                /* field */ "status", "{\"status\":\"queued\"}"
+            });
+            
+        })->Then([this, id, key, expires_in] (::ev::Object* a_object) -> ::ev::Object* {
+            
+            //
+            // HSET:
+            //
+            // - An integer reply is expected.
+            //
+            (void)::ev::redis::Reply::EnsureIntegerReply(a_object);
+            
+            return new ::ev::redis::Request(loggable_data_, "EXPIRE", { key + std::to_string(*id), expires_in });
+            
+        })->Finally([this, a_rjnr, id] (::ev::Object* a_object) {
+            
+            //
+            // EXPIRE:
+            //
+            // Integer reply, 1 if the timeout was set.
+            //
+            ::ev::redis::Reply::EnsureIntegerReply(a_object, 1);
+            
+            PostMessage({ /* type_ */ MessageType::Reservation, /* id_ */ a_rjnr, /* channel_ */ "", /* data_ */ "", /* object_ */ Json::Value(static_cast<Json::UInt64>(*id)) });
+            
+        })->Catch([this, a_rjnr] (const ::ev::Exception& /* a_ev_exception */) {
+            
+            // ... failed, next activity will reserve it's own id ...
+            PostMessage({ /* type_ */ MessageType::Reservation, /* id_ */ a_rjnr, /* channel_ */ "", /* data_ */ "", /* object_ */ Json::Value::null });
+            
+        });
+        
+    }, /* a_blocking */ false);
+}
+
+/**
+ * @brief Process a speculative REDIS job reservation result.
+ *
+ * @param a_rjnr Sequence REDIS job number.
+ * @param a_id   Reserved REDIS job number, Json::Value::null on failure.
+ */
+void casper::job::Sequencer::ProcessReservation (const uint64_t a_rjnr, const Json::Value& a_id)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    // ... sequence already finished?
+    SequenceState* state = FindSequenceState(a_rjnr);
+    if ( nullptr == state || nullptr == state->reservation_ || 0 != state->reservation_->id_ ) {
+        return;
+    }
+    
+    if ( true == a_id.isNull() ) {
+        state->reservation_.reset();
+        TrimSequenceState(a_rjnr);
+    } else {
+        state->reservation_->id_ = static_cast<uint64_t>(a_id.asUInt64());
+    }
+}
+
+/**
+ * @brief Call this method when an activity has a message to be relayed to the sequencer job.
+ *
+ * @param a_tracking Call tracking purposes.
+ * @param a_activity Activity info.
+ * @param a_message  JSON object text to relay, as received.
+ * @param a_length   JSON object text length, in bytes.
+ *
+ * @return HTTP status code.
+*/
+void casper::job::Sequencer::ActivityMessageRelay (const casper::job::sequencer::Tracking& /* a_tracking */,
+                                                   const casper::job::sequencer::Activity& a_activity, const char* const a_message, const size_t a_length)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    // ... no coalescing?
+    if ( 0 == relay_interval_ ) {
+        RelayActivityMessage(a_activity, std::string(a_message, a_length));
+        return;
+    }
+    
+    SequenceState& state = sequences_[a_activity.sequence().rjnr()];
+    if ( nullptr == state.relay_ ) {
+        state.relay_.reset(new ProgressRelay({ /* message_ */ "", /* relayed_at_ */ 0, /* scheduled_ */ false }));
+    }
+    ProgressRelay& relay   = *state.relay_;
+    const uint64_t now     = sequencer::Stats::Now();
+    const uint64_t elapsed = ( now > relay.relayed_at_ ? now - relay.relayed_at_ : 0 );
+    
+    // ... interval elapsed and nothing pending? relay it now ...
+    if ( false == relay.scheduled_ && elapsed >= relay_interval_ ) {
+        relay.relayed_at_ = now;
+        RelayActivityMessage(a_activity, std::string(a_message, a_length));
+        return;
+    }
+    
+    // ... keep only the latest message ...
+    relay.message_.assign(a_message, a_length);
+    
+    // ... and relay it when interval elapses ...
+    if ( false == relay.scheduled_ ) {
+        relay.scheduled_ = true;
+        ScheduleCallbackOnLooperThread(/* a_id */ "relay:" + a_activity.sequence().rcid(),
+                                       /* a_callback */ std::bind(&casper::job::Sequencer::OnActivityMessagesTimer, this, std::placeholders::_1),
+                                       /* a_deferred  */ static_cast<size_t>(( relay_interval_ - elapsed ) / 1000 + 1),
+                                       /* a_recurrent */ false
+        );
+    }
+}
+
+/**
+ * @brief Relay an activity message to the sequencer job.
+ *
+ * @param a_activity Activity info.
+ * @param a_message  JSON object text to relay.
+ */
+void casper::job::Sequencer::RelayActivityMessage (const casper::job::sequencer::Activity& a_activity, const std::string& a_message)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    const std::string src_channel_key = a_activity.rcid();
     const std::string dst_channel_key = a_activity.sequence().rcid();
     const std::string dst_job_key     = a_activity.sequence().rjid();
-    
-    Json::FastWriter ljfw; ljfw.omitEndingLineFeed();
 
     // ... log ...
     SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_DBG, a_activity, CC_JOB_LOG_STEP_RELAY,
                            CC_JOB_LOG_COLOR(YELLOW) "Relay message" CC_LOGS_LOGGER_RESET_ATTRS " from %s to %s, " CC_JOB_LOG_COLOR(DARK_GRAY) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
-                           src_channel_key.c_str(), dst_channel_key.c_str(), ljfw.write(a_message).c_str()
+                           src_channel_key.c_str(), dst_channel_key.c_str(), a_message.c_str()
     );
     try {
-        Relay(a_activity.sequence().bjid(), dst_channel_key, dst_job_key, a_message);
+        RelayMessage(dst_channel_key, dst_job_key, a_message);
+    } catch (...) {
+        try {
+            ::cc::Exception::Rethrow(/* a_unhandled */ true, __FILE__, __LINE__, __FUNCTION__);
+        } catch (const ::cc::Exception& a_cc_exception) {
+            CC_WARNING_TODO("CJS: HANDLE EXCEPTION");
+            // ... log ...
+            SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_WRN, a_activity, CC_JOB_LOG_STEP_RELAY,
+                                   CC_JOB_LOG_COLOR(RED) "Failed to relay message" CC_LOGS_LOGGER_RESET_ATTRS " from %s to %s, " CC_JOB_LOG_COLOR(DARK_GRAY) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
+                                   src_channel_key.c_str(), dst_channel_key.c_str(), a_cc_exception.what()
+            );
+        }
+    }
+    
+    // ... at macOS and if debug mode ...
+#if defined(__APPLE__) && !defined(NDEBUG) && ( defined(DEBUG) || defined(_DEBUG) || defined(ENABLE_DEBUG) )
+    // ... if configured will sleep between message relay ...
+    Sleep(activity_config_, a_activity, "Sleeping between message relays");
+#endif
+}
+
+/**
+ * @brief Forget coalesced 'in-progress' messages of an activity sequence.
+ *
+ * @param a_activity Activity info.
+ * @param a_relay    When true, pending message ( if any ) is relayed first.
+ */
+void casper::job::Sequencer::FlushActivityMessages (const casper::job::sequencer::Activity& a_activity, const bool a_relay)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    SequenceState* state = FindSequenceState(a_activity.sequence().rjnr());
+    if ( nullptr == state || nullptr == state->relay_ ) {
+        return;
+    }
+    // ... cancel pending flush ...
+    const std::unique_ptr<ProgressRelay> relay = std::move(state->relay_);
+    if ( true == relay->scheduled_ ) {
+        TryCancelCallbackOnLooperThread("relay:" + a_activity.sequence().rcid());
+    }
+    // ... relay latest message?
+    if ( true == a_relay && 0 != relay->message_.length() ) {
+        RelayActivityMessage(a_activity, relay->message_);
+    }
+}
+
+/**
+ * @brief Callback to execute when a sequence 'in-progress' messages coalescing interval elapsed.
+ *
+ * @param a_id Callback id, 'relay:' + sequence REDIS channel id.
+ */
+void casper::job::Sequencer::OnActivityMessagesTimer (const std::string& a_id)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    const uint64_t rjnr = RCID2RJNR(a_id);
+    
+    SequenceState* state = FindSequenceState(rjnr);
+    if ( nullptr == state || nullptr == state->relay_ ) {
+        return;
+    }
+    ProgressRelay& relay = *state->relay_;
+    relay.scheduled_ = false;
+    
+    // ... sequence still 'running'?
+    const sequencer::Activity* activity = running_sequences_.Find(rjnr);
+    if ( nullptr == activity ) {
+        state->relay_.reset();
+        TrimSequenceState(rjnr);
+        return;
+    }
+    
+    // ... relay latest message ...
+    if ( 0 != relay.message_.length() ) {
+        std::string message;
+        message.swap(relay.message_);
+        relay.relayed_at_ = sequencer::Stats::Now();
+        RelayActivityMessage(*activity, message);
+    }
+}
+
+/**
+ * @brief Call this method when an activity has returned ( the next in sequence will be launched if needed ).
+ *
+ * @param a_tracking Call tracking purposes.
+ * @param a_activity Activity info.
+ * @param a_response Activity response.
+ *
+ * @return HTTP status code.
+ */
+void casper::job::Sequencer::ActivityReturned (const casper::job::sequencer::Tracking& a_tracking,
+                                               const casper::job::sequencer::Activity& a_activity, const Json::Value* a_response)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    metrics_.Count(a_activity.rcnm(), sequencer::Metrics::Counter::Returned);
+    
+    // ... hedged? first attempt to complete wins, the other one is cancelled ...
+    const auto hedge = hedges_.find(a_activity.rjnr());
+    if ( hedges_.end() != hedge ) {
+        const uint64_t             peer  = hedge->second;
+        const sequencer::Activity* loser = running_activities_.Find(peer);
+        // ... not completed while the other attempt is still running? only this one is dropped, the other one carries on alone ...
+        if ( nullptr != loser && sequencer::Status::Done != a_activity.status() ) {
+            // ... log ...
+            SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, a_activity, CC_JOB_LOG_STEP_STEP,
+                                   "Dropping attempt #" UINT64_FMT ", it did not complete and attempt #" UINT64_FMT " is still running",
+                                   static_cast<uint64_t>(a_activity.attempt()), static_cast<uint64_t>(loser->attempt())
+            );
+            // ... untrack it while still paired, so sequence keeps pointing to a running attempt ...
+            const sequencer::Activity dropped = sequencer::Activity(a_activity);
+            FlushActivityMessages(dropped, /* a_relay */ false);
+            UntrackActivity(a_activity); // ... ⚠️ from now on a_activity is NOT valid ! ⚠️ ...
+            UnsubscribeActivity(dropped);
+            hedges_.erase(dropped.rjnr());
+            hedges_.erase(peer);
+            return;
+        }
+        if ( nullptr != loser ) {
+            // ... log ...
+            SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, (*loser), CC_JOB_LOG_STEP_STEP,
+                                   "Cancelling attempt #" UINT64_FMT ", attempt #" UINT64_FMT " returned first",
+                                   static_cast<uint64_t>(loser->attempt()), static_cast<uint64_t>(a_activity.attempt())
+            );
+            // ... cancel it, while still paired, so sequence keeps pointing to a running attempt ...
+            CancelActivity(*loser, Json::Value::null);
+        }
+        hedges_.erase(a_activity.rjnr());
+        hedges_.erase(peer);
+    }
+    
+    // ... retry policy allows another attempt?
+    if ( true == RetryActivity(a_tracking, a_activity, a_response) ) {
+        return;
+    }
+    
+    // ... memoizable and completed? keep it's response for identical activities ...
+    if ( 0 != a_activity.memo_key() && sequencer::Status::Done == a_activity.status() && nullptr != a_response ) {
+        memo_.Put(a_activity.rcnm(), a_activity.memo_key(), a_activity.memo_data(), *a_response);
+    }
+    
+    // ... coalesced 'in-progress' message must be relayed before activity is finalized ...
+    FlushActivityMessages(a_activity, /* a_relay */ true);
+    
+    // ... pushed? then it was executed ( or timed out ) ...
+    if ( 0 != a_activity.pushed_at() ) {
+        stats_.Record(a_activity.rcnm(), sequencer::Stats::Stage::Execution, a_activity.pushed_at());
+    }
+    
+    // ... item of a running 'map' step? it's not registered @ DB, the 'map' activity is finalized once all items return ...
+    const SequenceState* state = FindSequenceState(a_activity.sequence().rjnr());
+    if ( nullptr != state && nullptr != state->map_ && state->map_->running_.end() != state->map_->running_.find(a_activity.rjnr()) ) {
+        MapItemReturned(a_tracking, a_activity, a_response);
+        return;
+    }
+    
+    // ... prepare next activity ...
+    sequencer::Activity next = sequencer::Activity(/* a_sequence */ a_activity.shared_sequence(), /* a_id */ a_activity.did(), /* a_index */ a_activity.index(), /* a_attempt */ 0);
+
+    // ... finalize activity and pick next ( if any ) ...
+    FinalizeActivity(a_activity, a_response, next);
+    
+    // ... copy activity ...
+    const auto returning_activity = sequencer::Activity(a_activity);
+    
+    // ... untrack activity ...
+    UntrackActivity(a_activity); // ... ⚠️ from now on a_activity is NOT valid ! ⚠️ ...
+    
+    // ... unsubscribe activity ...
+    UnsubscribeActivity(returning_activity);
+    
+    // ... ( sequence state is looked up again, it might have been trimmed when activity was untracked ) ...
+    SequenceState* remaining = FindSequenceState(returning_activity.sequence().rjnr());
+    
+    // ... member of a running parallel group?
+    const bool grouped = ( nullptr != remaining && nullptr != remaining->group_ );
+    
+    // ... branching, as requested by 'next_if' evaluation?
+    size_t target = std::string::npos;
+    if ( nullptr != remaining && nullptr != remaining->branch_ ) {
+        target = *remaining->branch_;
+        remaining->branch_.reset();
+        TrimSequenceState(returning_activity.sequence().rjnr());
+    }
+    
+    // ... do we have another activity?
+    if ( sequencer::Status::Pending == next.status() ) {
+        // ... next activity is launched only when all group activities return ...
+        if ( true == grouped ) {
+            GroupActivityReturned(a_tracking, returning_activity, /* a_response */ nullptr);
+            return;
+        }
+        // ... activities jumped over by the branch are finalized as skipped ...
+        if ( std::string::npos != target ) {
+            SkipActivities(returning_activity.shared_sequence(), returning_activity.index() + 1, target);
+        }
+        // ... replace next activity with the branch target one ...
+        if ( std::string::npos != target && false == LoadActivity(returning_activity.shared_sequence(), target, next) ) {
+            // ... data must be previously set on DB ...
+            Json::Value response = Json::Value::null;
+            (void)SetFailedResponse(/* a_code */ 500, Json::Value("No data available for activity #" + std::to_string(target + 1) + " ( from db )!"), response);
+            next.Reset(sequencer::Status::Failed, response);
+            FinishSequence(next, response);
+            return;
+        }
+        // ... we're ready to next activity ...
+        CC_ASSERT(next.index() != returning_activity.index());
+        CC_ASSERT(0 != next.did().compare(returning_activity.did()));
+        // ... launch activity ...
+        const uint64_t launch_start = sequencer::Stats::Now();
+        LaunchStep(a_tracking, next, /* a_at_run */ false);
+        if ( 0 != next.rcnm().length() ) {
+            stats_.Record(next.rcnm(), sequencer::Stats::Stage::Launch, launch_start);
+        }
+    } else {
+
+        // ... set final response ...
+        const Json::Value* job_response;
+        
+        if ( nullptr != a_response ) {
+            // ... a valid response was provided ...
+            job_response = a_response;
+        } else {
+            CC_WARNING_TODO("CJS: review IF");
+            // ... a critical error occurred?
+            if ( sequencer::Status::Failed == returning_activity.status() || sequencer::Status::Error == returning_activity.status() ) {
+                // ... activity payload must the the error do display ...
+                job_response = &returning_activity.payload();
+            } else if ( sequencer::Status::Done == next.status() ) { // ... we're done?
+                // ... we're done ...
+                job_response = a_response;
+            } else {
+                // ... critical error ...
+                job_response = &next.payload();
+            }
+        }
+               
+        // ... job_response can't be nullptr!
+        CC_ASSERT(nullptr != job_response);
+        CC_ASSERT(false == job_response->isNull() && true == job_response->isMember("status"));
+        
+        // ... sequence ends only when all group activities return ...
+        if ( true == grouped ) {
+            GroupActivityReturned(a_tracking, returning_activity, job_response);
+            return;
+        }
+        
+        // ... finalize sequence and finish job ...
+        FinishSequence(returning_activity, *job_response);
+    }
+}
+
+/**
+ * @brief Check if a returned activity should be retried and, if so, schedule another attempt after a backoff delay.
+ *
+ * @param a_tracking Call tracking purposes.
+ * @param a_activity Returned activity info.
+ * @param a_response Activity response.
+ *
+ * @return True if another attempt was scheduled ( activity must not be finalized ), false otherwise.
+ */
+bool casper::job::Sequencer::RetryActivity (const casper::job::sequencer::Tracking& /* a_tracking */,
+                                            const casper::job::sequencer::Activity& a_activity, const Json::Value* a_response)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    const Json::Value& policy = a_activity.retry();
+    // ... no policy, aborted or not 'running' ( already retried and relaunch failed )?
+    if ( true == policy.isNull() || nullptr == a_response || nullptr == running_activities_.Find(a_activity.rjnr()) ) {
+        return false;
+    }
+    // ... items of a 'map' step are not registered @ DB, they're not retried ...
+    const SequenceState* state = FindSequenceState(a_activity.sequence().rjnr());
+    if ( nullptr != state && nullptr != state->map_ ) {
+        return false;
+    }
+    // ... out of attempts?
+    if ( a_activity.attempt() >= static_cast<size_t>(policy["attempts"].asUInt()) ) {
+        return false;
+    }
+    // ... status must be one of the retryable ones ( a timeout is a 'failed' status ) ...
+    bool retryable = false;
+    for ( const auto& it : s_irj_teminal_status_map_ ) {
+        if ( it.second != a_activity.status() ) {
+            continue;
+        }
+        for ( const auto& status : policy["on"] ) {
+            if ( 0 == it.first.compare(status.asString()) ) {
+                retryable = true;
+                break;
+            }
+        }
+        break;
+    }
+    if ( false == retryable ) {
+        return false;
+    }
+    
+    // ... exponential backoff, capped, with jitter in [delay / 2, delay] ...
+    const uint64_t backoff     = static_cast<uint64_t>(policy["backoff"].asUInt());
+    const uint64_t max_backoff = static_cast<uint64_t>(policy["max_backoff"].asUInt());
+    const size_t   shift       = std::min(a_activity.attempt() > 0 ? a_activity.attempt() - 1 : 0, static_cast<size_t>(31));
+    const uint64_t delay       = std::min(backoff << shift, max_backoff);
+    const uint64_t deferred    = ( delay / 2 ) + static_cast<uint64_t>(random()) % ( ( delay - ( delay / 2 ) ) + 1 );
+    
+    // ... it's job returned: no longer expect a timeout, a hedge or any message from it ...
+    TryCancelCallbackOnLooperThread(a_activity.rcid());
+    TryCancelCallbackOnLooperThread("hedge:" + a_activity.rcid());
+    FlushActivityMessages(a_activity, /* a_relay */ true);
+    UnsubscribeActivity(a_activity);
+    
+    // ... keep it tracked while waiting, so it can still be cancelled ...
+    retries_[a_activity.rjnr()] = *a_response;
+    
+    // ... log ...
+    SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, a_activity, CC_JOB_LOG_STEP_STEP,
+                           CC_JOB_LOG_COLOR(YELLOW) "Attempt #" SIZET_FMT " of " UINT64_FMT " returned, retrying in " UINT64_FMT " ms..." CC_LOGS_LOGGER_RESET_ATTRS,
+                           a_activity.attempt(), static_cast<uint64_t>(policy["attempts"].asUInt()), deferred
+    );
+    metrics_.Count(a_activity.rcnm(), sequencer::Metrics::Counter::Retried);
+    
+    ScheduleCallbackOnLooperThread(/* a_id */ "retry:" + a_activity.rcid(),
+                                   /* a_callback */ std::bind(&casper::job::Sequencer::OnRetryTimer, this, std::placeholders::_1),
+                                   /* a_deferred  */ static_cast<size_t>(deferred),
+                                   /* a_recurrent */ false
+    );
+    
+    return true;
+}
+
+/**
+ * @brief Launch another attempt of an activity, reusing it's already patched payload, with a new REDIS id and channel.
+ *
+ * @param io_activity Activity info, a copy of the previous attempt, bound to the new attempt here.
+ * @param a_peer      Previous attempt REDIS job number, when both must keep running ( hedging ), 0 otherwise.
+ * @param o_error     Set with error message, on failure.
+ *
+ * @return True on success, false otherwise ( new attempt was forgotten ).
+ */
+bool casper::job::Sequencer::LaunchAttempt (casper::job::sequencer::Activity& io_activity, const uint64_t a_peer, std::string& o_error)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+
+    uint64_t    id = 0;
+    std::string key;
+    std::string channel;
+    bool        subscribed = false;
+    
+    const uint64_t reserve_start = sequencer::Stats::Now();
+    const uint16_t sc            = ReserveActivityJob(io_activity.sequence().rjnr(), io_activity.rcnm(), static_cast<int64_t>(io_activity.validity()), id, key, channel, o_error);
+    metrics_.Observe(sequencer::Metrics::Latency::Redis, stats_.Record(io_activity.rcnm(), sequencer::Stats::Stage::Reserve, reserve_start));
+    if ( 200 != sc ) {
+        return false;
+    }
+    
+    // ... bind ids, it's a new attempt ...
+    io_activity.Bind(/* rjnr_ */ id, /* a_rjid */ key, /* a_rcnm */ io_activity.rcnm(), /* a_rcid */ channel, /* a_new_attempt */ true);
+    Json::Value payload = io_activity.payload();
+    payload["id"] = std::to_string(id);
+    io_activity.SetPayload(std::move(payload));
+    io_activity.SerializePayload();
+    
+    try {
+        // ... register attempt @ DB ...
+        RegisterActivity(io_activity);
+        // ... pair both attempts, first one to return wins ...
+        if ( 0 != a_peer ) {
+            hedges_[a_peer] = id;
+            hedges_[id]     = a_peer;
+        }
+        // ... track activity ...
+        TrackActivity(io_activity);
+        // ... listen to REDIS job channel ...
+        SubscribeActivity(io_activity);
+        subscribed = true;
+        // ... push job ( send it to beanstalkd ) ...
+        PushActivity(io_activity);
+        sequencer::Activity* tracked = running_activities_.Find(id);
+        if ( nullptr != tracked ) {
+            tracked->SetPushedAt(sequencer::Stats::Now());
+        }
+        // ... speculatively reserved job ( if any ) was used by this attempt, reserve another one for next activity ...
+        ReserveNextActivityJob(io_activity);
+        return true;
+    } catch (...) {
+        // ... recapture exception ...
+        try {
+            ::cc::Exception::Rethrow(/* a_unhandled */ false, __FILE__, __LINE__, __FUNCTION__);
+        } catch (::cc::Exception& a_cc_exception) {
+            o_error = a_cc_exception.what();
+        }
+    }
+    
+    // ... forget attempt, while still paired, so sequence keeps pointing to a running attempt ...
+    UntrackActivity(io_activity);
+    if ( true == subscribed ) {
+        UnsubscribeActivity(io_activity);
+    }
+    if ( 0 != a_peer ) {
+        hedges_.erase(a_peer);
+        hedges_.erase(id);
+    }
+    
+    return false;
+}
+
+/**
+ * @brief Call this method when an activity that belongs to a running parallel group has returned.
+ *
+ * @param a_tracking Call tracking purposes.
+ * @param a_activity Returned activity info, already finalized and untracked.
+ * @param a_response Sequence final response, when this activity ends the sequence, nullptr otherwise.
+ */
+void casper::job::Sequencer::GroupActivityReturned (const casper::job::sequencer::Tracking& a_tracking,
+                                                    const casper::job::sequencer::Activity& a_activity, const Json::Value* a_response)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    SequenceState* state = FindSequenceState(a_activity.sequence().rjnr());
+    CC_ASSERT(nullptr != state && nullptr != state->group_);
+    
+    ParallelGroup& group = *state->group_;
+    
+    // ... ends the sequence?
+    if ( nullptr != a_response ) {
+        // ... keep first one, unless it succeeded and this one did not ...
+        if ( nullptr == group.ended_ || ( sequencer::Status::Done == group.ended_->status() && sequencer::Status::Done != a_activity.status() ) ) {
+            group.ended_    = std::make_shared<sequencer::Activity>(a_activity);
+            group.response_ = *a_response;
+        }
+    }
+    
+    group.pending_--;
+    
+    // ... log ...
+    SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, a_activity, CC_JOB_LOG_STEP_STEP,
+                           "Parallel group activity returned, " SIZET_FMT " / " SIZET_FMT " pending",
+                           group.pending_, group.count_
+    );
+    
+    // ... all returned?
+    if ( 0 == group.pending_ ) {
+        GroupReturned(a_tracking, a_activity.shared_sequence());
+    }
+}
+
+/**
+ * @brief Call this method when all activities of a parallel group have returned.
+ *
+ * @param a_tracking Call tracking purposes.
+ * @param a_sequence Sequence info.
+ */
+void casper::job::Sequencer::GroupReturned (const casper::job::sequencer::Tracking& a_tracking, const casper::job::sequencer::SharedSequence& a_sequence)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    SequenceState* state = FindSequenceState(a_sequence->rjnr());
+    if ( nullptr == state || nullptr == state->group_ ) {
+        return;
+    }
+    
+    // ... forget group ...
+    const ParallelGroup group = *state->group_;
+    state->group_.reset();
+    TrimSequenceState(a_sequence->rjnr());
+    
+    // ... log ...
+    SEQUENCER_LOG_SEQUENCE(CC_JOB_LOG_LEVEL_INF, (*a_sequence), CC_JOB_LOG_STEP_STEP,
+                           "Parallel group returned ( " SIZET_FMT " to " SIZET_FMT " )",
+                           ( group.first_ + 1 ), ( group.first_ + group.count_ )
+    );
+    
+    // ... sequence ended?
+    if ( nullptr != group.ended_ ) {
+        FinishSequence(*group.ended_, group.response_);
+        return;
+    }
+    
+    // ... load next activity ...
+    const size_t        index = group.first_ + group.count_;
+    sequencer::Activity next  = sequencer::Activity(/* a_sequence */ a_sequence, /* a_id */ "", /* a_index */ index, /* a_attempt */ 0);
+    if ( false == LoadActivity(a_sequence, index, next) ) {
+        // ... data must be previously set on DB ...
+        Json::Value response = Json::Value::null;
+        (void)SetFailedResponse(/* a_code */ 500, Json::Value("No data available for activity #" + std::to_string(index + 1) + " ( from db )!"), response);
+        next.Reset(sequencer::Status::Failed, response);
+        FinishSequence(next, response);
+        return;
+    }
+    
+    // ... launch it ...
+    const uint64_t launch_start = sequencer::Stats::Now();
+    LaunchStep(a_tracking, next, /* a_at_run */ false);
+    if ( 0 != next.rcnm().length() ) {
+        stats_.Record(next.rcnm(), sequencer::Stats::Stage::Launch, launch_start);
+    }
+}
+
+/**
+ * @brief Load an activity from it's sequence registered activities.
+ *
+ * @param a_sequence Sequence info.
+ * @param a_index    Activity index.
+ * @param o_activity Pre-filled activity info ( payload, ttr and status to be set here ).
+ *
+ * @return True if activity was loaded, false if it's not available.
+ */
+bool casper::job::Sequencer::LoadActivity (const casper::job::sequencer::SharedSequence& a_sequence, const size_t a_index,
+                                           casper::job::sequencer::Activity& o_activity)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    const Json::Value& activities = a_sequence->activities();
+    if ( false == activities.isArray() || a_index >= static_cast<size_t>(activities.size()) ) {
+        return false;
+    }
+    const Json::Value& row = activities[static_cast<Json::ArrayIndex>(a_index)];
+    if ( true == row["id"].isNull() ) {
+        return false;
+    }
+    const auto did = row["id"].asString();
+    o_activity.Reset(sequencer::Status::Pending, /* a_payload */ row);
+    o_activity.SetIndex(a_index);
+    o_activity.SetDID(did);
+    const auto& job = GetJSONObject(o_activity.payload(), "job", Json::ValueType::objectValue, /* a_default */ nullptr);
+    o_activity.SetTTR           (GetJSONObject(job, "ttr"     , Json::ValueType::intValue   , &activity_config_.ttr_     ).asUInt());
+    o_activity.SetValidity      (GetJSONObject(job, "validity", Json::ValueType::intValue   , &activity_config_.validity_).asUInt());
+    o_activity.SetAbortCondition(GetJSONObject(job, "abort"   , Json::ValueType::objectValue, &Json::Value::null));
+    return true;
+}
+
+/**
+ * @brief Start a 'map' step, one activity per item will be launched.
+ *
+ * @param a_tracking    Call tracking purposes.
+ * @param a_activity    'map' activity info, already patched and registered @ DB.
+ * @param a_items       Items to map.
+ * @param a_expires_in  Item REDIS job key validity, in seconds.
+ * @param a_concurrency Maximum number of running items.
+ */
+void casper::job::Sequencer::StartMap (const casper::job::sequencer::Tracking& a_tracking, const casper::job::sequencer::Activity& a_activity,
+                                       Json::Value&& a_items, const int64_t a_expires_in, const size_t a_concurrency)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    const uint64_t rjnr = a_activity.sequence().rjnr();
+    
+    SequenceState& state = sequences_[rjnr];
+    state.map_.reset(new MapStep());
+    
+    MapStep& map = *state.map_;
+    
+    map.parent_      = std::make_shared<sequencer::Activity>(a_activity);
+    map.payload_     = a_activity.payload();
+    map.items_       = std::move(a_items);
+    map.expires_in_  = a_expires_in;
+    map.concurrency_ = a_concurrency;
+    map.next_        = 0;
+    map.running_.clear();
+    map.results_     = Json::Value(Json::ValueType::arrayValue);
+    map.results_.resize(map.items_.size());
+    map.failed_      = false;
+    map.failure_     = Json::Value::null;
+    
+    // ... parent payload is the template, no need to keep it twice ...
+    map.parent_->SetPayload(Json::Value::null);
+    
+    // ... sequence is indexed by parent while no item is running ( e.g. between waves or if there are no items at all ) ...
+    running_sequences_.Insert(rjnr, map.parent_.get());
+    
+    // ... log ...
+    SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, a_activity, CC_JOB_LOG_STEP_STEP,
+                           "Mapping %u item(s), up to " SIZET_FMT " at a time",
+                           static_cast<unsigned>(map.items_.size()), map.concurrency_
+    );
+    
+    // ... launch first items, if none is running step is finished outside of this call ...
+    MapNext(a_tracking, rjnr, /* a_deferred */ true);
+}
+
+/**
+ * @brief Launch 'map' step items while concurrency limit allows it, finish step when no more items are running.
+ *
+ * @param a_tracking Call tracking purposes.
+ * @param a_rjnr     Sequence REDIS job number.
+ * @param a_deferred When true and step is finished, it's return is handled by a looper callback.
+ */
+void casper::job::Sequencer::MapNext (const casper::job::sequencer::Tracking& a_tracking, const uint64_t a_rjnr, const bool a_deferred)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    SequenceState* state = FindSequenceState(a_rjnr);
+    if ( nullptr == state || nullptr == state->map_ ) {
+        return;
+    }
+    
+    MapStep& map = *state->map_;
+    
+    // ... launch items, unless one already failed ...
+    while ( false == map.failed_ && map.next_ < static_cast<size_t>(map.items_.size()) && map.running_.size() < map.concurrency_ ) {
+        LaunchMapItem(a_tracking, map, map.next_++);
+    }
+    
+    // ... still running?
+    if ( false == map.running_.empty() ) {
+        return;
+    }
+    
+    // ... we're done ...
+    if ( true == a_deferred ) {
+        ScheduleCallbackOnLooperThread(/* a_id */ "map:" + map.parent_->sequence().rcid(),
+                                       /* a_callback */ std::bind(&casper::job::Sequencer::OnMapTimer, this, std::placeholders::_1),
+                                       /* a_deferred  */ 0,
+                                       /* a_recurrent */ false
+        );
+    } else {
+        MapReturned(a_tracking, a_rjnr);
+    }
+}
+
+/**
+ * @brief Launch a 'map' step item activity.
+ *
+ * @param a_tracking Call tracking purposes.
+ * @param a_map      'map' step info.
+ * @param a_index    Item index.
+ */
+void casper::job::Sequencer::LaunchMapItem (const casper::job::sequencer::Tracking& /* a_tracking */, casper::job::Sequencer::MapStep& a_map, const size_t a_index)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    sequencer::Activity item = sequencer::Activity(*a_map.parent_);
+    
+    uint64_t    id = 0;
+    std::string key;
+    std::string channel;
+    std::string error;
+    bool        subscribed = false;
+    
+    try {
+        // ... reserve REDIS job id ...
+        const uint64_t reserve_start = sequencer::Stats::Now();
+        const uint16_t sc            = ReserveActivityJob(item.sequence().rjnr(), item.rcnm(), a_map.expires_in_, id, key, channel, error);
+        metrics_.Observe(sequencer::Metrics::Latency::Redis, stats_.Record(item.rcnm(), sequencer::Stats::Stage::Reserve, reserve_start));
+        if ( 200 != sc ) {
+            throw ::cc::Exception("%s", error.c_str());
+        }
+        // ... bind ids, it's the same activity attempt ...
+        item.Bind(/* rjnr_ */ id, /* a_rjid */ key, /* a_rcnm */ item.rcnm(), /* a_rcid */ channel, /* a_new_attempt */ false);
+        // ... patched payload, with this item ...
+        Json::Value payload = a_map.payload_;
+        payload["id"] = std::to_string(id);
+        Json::Value& map = payload["map"];
+        map["item"]  = a_map.items_[static_cast<Json::ArrayIndex>(a_index)];
+        map["index"] = static_cast<Json::UInt>(a_index);
+        map["count"] = static_cast<Json::UInt>(a_map.items_.size());
+        item.SetPayload(std::move(payload));
+        item.SerializePayload();
+        // ... item is running from now on ...
+        a_map.running_[id] = a_index;
+        // ... track activity ...
+        TrackActivity(item);
+        // ... listen to REDIS job channel ...
+        const uint64_t subscribe_start = sequencer::Stats::Now();
+        SubscribeActivity(item);
+        metrics_.Observe(sequencer::Metrics::Latency::Redis, stats_.Record(item.rcnm(), sequencer::Stats::Stage::Subscribe, subscribe_start));
+        subscribed = true;
+        // ... while draining messages, push job along with all others launched at this looper tick ...
+        if ( true == pushes_deferred_ ) {
+            QueueActivityPush(item);
+        } else {
+            PushActivity(item);
+            sequencer::Activity* tracked = running_activities_.Find(item.rjnr());
+            if ( nullptr != tracked ) {
+                tracked->SetPushedAt(sequencer::Stats::Now());
+            }
+        }
+        // ... reserve next item ( or next activity ) REDIS job ...
+        if ( a_map.next_ < static_cast<size_t>(a_map.items_.size()) ) {
+            ReserveNextJob(item.sequence().rjnr(), item.rcnm(), a_map.expires_in_);
+        } else {
+            ReserveNextActivityJob(item);
+        }
+        // ... log ...
+        SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, item, CC_JOB_LOG_STEP_STEP,
+                               "Launched map item #" SIZET_FMT " with REDIS channel ID %s", ( a_index + 1 ), item.rcid().c_str());
+        metrics_.Count(item.rcnm(), sequencer::Metrics::Counter::Launched);
+        return;
     } catch (...) {
+        // ... recapture exception ...
         try {
-            ::cc::Exception::Rethrow(/* a_unhandled */ true, __FILE__, __LINE__, __FUNCTION__);
-        } catch (const ::cc::Exception& a_cc_exception) {
-            CC_WARNING_TODO("CJS: HANDLE EXCEPTION");
-            // ... log ...
-            SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_WRN, a_activity, CC_JOB_LOG_STEP_RELAY,
-                                   CC_JOB_LOG_COLOR(RED) "Failed to relay message" CC_LOGS_LOGGER_RESET_ATTRS " from %s to %s, " CC_JOB_LOG_COLOR(DARK_GRAY) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
-                                   src_channel_key.c_str(), dst_channel_key.c_str(), a_cc_exception.what()
-            );
+            ::cc::Exception::Rethrow(/* a_unhandled */ false, __FILE__, __LINE__, __FUNCTION__);
+        } catch (::cc::Exception& a_cc_exception) {
+            error = a_cc_exception.what();
         }
     }
     
-    // ... at macOS and if debug mode ...
-#if defined(__APPLE__) && !defined(NDEBUG) && ( defined(DEBUG) || defined(_DEBUG) || defined(ENABLE_DEBUG) )
-    // ... if configured will sleep between message relay ...
-    Sleep(activity_config_, a_activity, "Sleeping between message relays");
-#endif
+    // ... forget item ...
+    if ( 0 != id ) {
+        a_map.running_.erase(id);
+        UntrackActivity(item);
+        if ( true == subscribed ) {
+            UnsubscribeActivity(item);
+        }
+    }
+    
+    // ... log ...
+    SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_ERR, item, CC_JOB_LOG_STEP_ERROR,
+                           "An error occurred while launching map item #" SIZET_FMT " ~ " CC_JOB_LOG_COLOR(RED) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
+                           ( a_index + 1 ), error.c_str()
+    );
+    
+    // ... item failed, no more items will be launched ...
+    Json::Value payload  = Json::Value(Json::ValueType::objectValue);
+    payload["exception"] = error;
+    Json::Value response = Json::Value::null;
+    (void)SetFailedResponse(/* a_code */ 400, payload, response);
+    a_map.results_[static_cast<Json::ArrayIndex>(a_index)] = response;
+    if ( false == a_map.failed_ ) {
+        a_map.failed_  = true;
+        a_map.failure_ = std::move(response);
+    }
 }
 
 /**
- * @brief Call this method when an activity has returned ( the next in sequence will be launched if needed ).
+ * @brief Call this method when a 'map' step item activity has returned.
  *
  * @param a_tracking Call tracking purposes.
- * @param a_activity Activity info.
- * @param a_response Activity response.
- *
- * @return HTTP status code.
+ * @param a_activity Item activity info.
+ * @param a_response Item activity response.
  */
-void casper::job::Sequencer::ActivityReturned (const casper::job::sequencer::Tracking& a_tracking,
-                                               const casper::job::sequencer::Activity& a_activity, const Json::Value* a_response)
+void casper::job::Sequencer::MapItemReturned (const casper::job::sequencer::Tracking& a_tracking,
+                                              const casper::job::sequencer::Activity& a_activity, const Json::Value* a_response)
 {
     CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
     
-    // ... prepare next activity ...
-    sequencer::Activity next = sequencer::Activity(/* a_sequence */ a_activity.sequence(), /* a_id */ a_activity.did(), /* a_index */ a_activity.index(), /* a_attempt */ 0);
-
-    // ... finalize activity and pick next ( if any ) ...
-    FinalizeActivity(a_activity, a_response, next);
+    const uint64_t rjnr = a_activity.sequence().rjnr();
+    
+    SequenceState* state = FindSequenceState(rjnr);
+    CC_ASSERT(nullptr != state && nullptr != state->map_);
+    
+    MapStep& map = *state->map_;
     
     // ... copy activity ...
     const auto returning_activity = sequencer::Activity(a_activity);
@@ -845,50 +2394,267 @@ void casper::job::Sequencer::ActivityReturned (const casper::job::sequencer::Tra
     // ... unsubscribe activity ...
     UnsubscribeActivity(returning_activity);
     
-    // ... do we have another activity?
-    if ( sequencer::Status::Pending == next.status() ) {
-        // ... we're ready to next activity ...
-        CC_ASSERT(next.index() != returning_activity.index());
-        CC_ASSERT(0 != next.did().compare(returning_activity.did()));
-        // ... launch activity ...
-        LaunchActivity(a_tracking, next, /* a_at_run */ false);
+    // ... keep it's response, in items order ...
+    const auto   running = map.running_.find(returning_activity.rjnr());
+    const size_t index   = running->second;
+    map.running_.erase(running);
+    
+    const Json::Value& response = ( nullptr != a_response ? *a_response : returning_activity.payload() );
+    map.results_[static_cast<Json::ArrayIndex>(index)] = response;
+    if ( sequencer::Status::Done != returning_activity.status() && false == map.failed_ ) {
+        map.failed_  = true;
+        map.failure_ = response;
+    }
+    
+    // ... log ...
+    SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, returning_activity, CC_JOB_LOG_STEP_STEP,
+                           "Map item #" SIZET_FMT " returned, " SIZET_FMT " / %u launched, " SIZET_FMT " running",
+                           ( index + 1 ), map.next_, static_cast<unsigned>(map.items_.size()), map.running_.size()
+    );
+    
+    // ... launch next items or finish step ...
+    MapNext(a_tracking, rjnr, /* a_deferred */ false);
+}
+
+/**
+ * @brief Call this method when all items of a 'map' step have returned, or no more items will be launched.
+ *
+ * @param a_tracking Call tracking purposes.
+ * @param a_rjnr     Sequence REDIS job number.
+ */
+void casper::job::Sequencer::MapReturned (const casper::job::sequencer::Tracking& a_tracking, const uint64_t a_rjnr)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    SequenceState* state = FindSequenceState(a_rjnr);
+    if ( nullptr == state || nullptr == state->map_ ) {
+        return;
+    }
+    
+    // ... forget step ( parent still indexes the sequence, state is not trimmed ) ...
+    MapStep map = std::move(*state->map_);
+    state->map_.reset();
+    
+    // ... parent is released when this call returns, it can no longer index the sequence ...
+    if ( map.parent_.get() == running_sequences_.Find(a_rjnr) ) {
+        running_sequences_.Erase(a_rjnr);
+    }
+    
+    // ... aggregate responses ...
+    Json::Value response;
+    if ( true == map.failed_ ) {
+        map.parent_->SetStatus(sequencer::Status::Failed);
+        response = std::move(map.failure_);
     } else {
+        map.parent_->SetStatus(sequencer::Status::Done);
+        response                = Json::Value(Json::ValueType::objectValue);
+        response["status"]      = "completed";
+        response["status_code"] = 200;
+        response["results"]     = std::move(map.results_);
+    }
+    
+    // ... log ...
+    SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, (*map.parent_), CC_JOB_LOG_STEP_STEP,
+                           "Map returned, " SIZET_FMT " / %u item(s) launched",
+                           map.next_, static_cast<unsigned>(map.items_.size())
+    );
+    
+    // ... finalize 'map' activity, next one is launched if needed ...
+    ActivityReturned(a_tracking, *map.parent_, &response);
+}
 
-        // ... set final response ...
-        const Json::Value* job_response;
-        
-        if ( nullptr != a_response ) {
-            // ... a valid response was provided ...
-            job_response = a_response;
-        } else {
-            CC_WARNING_TODO("CJS: review IF");
-            // ... a critical error occurred?
-            if ( sequencer::Status::Failed == returning_activity.status() || sequencer::Status::Error == returning_activity.status() ) {
-                // ... activity payload must the the error do display ...
-                job_response = &returning_activity.payload();
-            } else if ( sequencer::Status::Done == next.status() ) { // ... we're done?
-                // ... we're done ...
-                job_response = a_response;
-            } else {
-                // ... critical error ...
-                job_response = &next.payload();
+/**
+ * @brief Callback to finish a 'map' step that has no running items.
+ *
+ * @param a_id Callback id, 'map:' + sequence REDIS channel id.
+ */
+void casper::job::Sequencer::OnMapTimer (const std::string& a_id)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    const uint64_t rjnr = RCID2RJNR(a_id);
+    
+    const SequenceState* state = FindSequenceState(rjnr);
+    if ( nullptr == state || nullptr == state->map_ ) {
+        return;
+    }
+    
+    MapReturned(SEQUENCER_TRACK_CALL(state->map_->parent_->sequence().bjid(), "MAP RETURNED"), rjnr);
+}
+
+/**
+ * @brief Resolve a 'next_if' evaluation result to the index of the activity to branch to.
+ *
+ * @param a_activity Branching activity info.
+ * @param a_target   Target job name or index.
+ *
+ * @return Index of the activity to branch to.
+ */
+size_t casper::job::Sequencer::ResolveBranch (const casper::job::sequencer::Activity& a_activity, const Json::Value& a_target)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    const Json::Value& activities = a_activity.sequence().activities();
+    const size_t       count      = ( true == activities.isArray() ? static_cast<size_t>(activities.size()) : 0 );
+    
+    Json::FastWriter jw; jw.omitEndingLineFeed();
+    
+    // ... by name or by index ...
+    size_t target = std::string::npos;
+    if ( true == a_target.isString() ) {
+        for ( size_t idx = 0 ; idx < count ; ++idx ) {
+            const Json::Value& name = activities[static_cast<Json::ArrayIndex>(idx)]["job"]["name"];
+            if ( true == name.isString() && 0 == name.asString().compare(a_target.asString()) ) {
+                target = idx;
+                break;
             }
         }
-               
-        // ... job_response can't be nullptr!
-        CC_ASSERT(nullptr != job_response);
-        CC_ASSERT(false == job_response->isNull() && true == job_response->isMember("status"));
-        
-        double rtt = 0;
-        
-        // ... finalize sequence ...
-        FinalizeSequence(returning_activity, *job_response, rtt);
-        
-        // ... finish job ...
-        FinalizeJob(returning_activity.sequence(), *job_response);
+    } else if ( true == a_target.isUInt() ) {
+        target = static_cast<size_t>(a_target.asUInt());
+    }
+    if ( target >= count ) {
+        throw ::cc::Exception("Unable to branch to %s: job not found!", jw.write(a_target).c_str());
+    }
+    // ... only forward, no loops ...
+    if ( target <= a_activity.index() ) {
+        throw ::cc::Exception("Unable to branch to %s: only following jobs are allowed!", jw.write(a_target).c_str());
+    }
+    // ... parallel groups run and return as a whole ...
+    size_t first = 0;
+    size_t size  = 0;
+    if ( true == sequencer::Parallel::Get(activities[static_cast<Json::ArrayIndex>(a_activity.index())]["job"], first, size) ) {
+        throw ::cc::Exception("Unable to branch to %s: not allowed from a parallel group!", jw.write(a_target).c_str());
+    }
+    if ( true == sequencer::Parallel::Get(activities[static_cast<Json::ArrayIndex>(target)]["job"], first, size) && first != target ) {
+        throw ::cc::Exception("Unable to branch to %s: not allowed into a parallel group!", jw.write(a_target).c_str());
+    }
+    
+    return target;
+}
+
+/**
+ * @brief Callback to finalize a skipped activity, with a synthetic response.
+ *
+ * @param a_id Callback id, 'skip:' + activity REDIS channel id.
+ */
+void casper::job::Sequencer::OnSkipTimer (const std::string& a_id)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    const uint64_t rjnr = RCID2RJNR(a_id);
+    
+    const auto it = skips_.find(rjnr);
+    if ( skips_.end() == it ) {
+        return;
+    }
+    const size_t target = it->second;
+    skips_.erase(it);
+    
+    // ... activity still 'running' ( not cancelled )?
+    sequencer::Activity* activity = running_activities_.Find(rjnr);
+    if ( nullptr == activity ) {
+        return;
+    }
+    
+    // ... synthetic response ...
+    Json::Value response    = Json::Value(Json::ValueType::objectValue);
+    response["status"]      = "completed";
+    response["status_code"] = 200;
+    response["skipped"]     = true;
+    if ( std::string::npos != target ) {
+        response["next"] = static_cast<Json::UInt>(target);
+        sequences_[activity->sequence().rjnr()].branch_.reset(new size_t(target));
+    }
+    activity->SetStatus(sequencer::Status::Done);
+    
+    // ... signal activity 'completed' ...
+    ActivityReturned(SEQUENCER_TRACK_CALL(activity->sequence().bjid(), "ACTIVITY SKIPPED"),
+                     *activity, &response
+    );
+}
+
+/**
+ * @brief Finalize, as skipped, all activities jumped over by a 'next_if' branch.
+ *
+ * @param a_sequence Sequence info.
+ * @param a_first    Index of the first activity to skip.
+ * @param a_last     Index of the branch target activity, not skipped.
+ */
+void casper::job::Sequencer::SkipActivities (const casper::job::sequencer::SharedSequence& a_sequence, const size_t a_first, const size_t a_last)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    // ... synthetic response ...
+    Json::Value response    = Json::Value(Json::ValueType::objectValue);
+    response["status"]      = "completed";
+    response["status_code"] = 200;
+    response["skipped"]     = true;
+    
+    sequencer::Activity next = sequencer::Activity(/* a_sequence */ a_sequence, /* a_id */ "", /* a_index */ a_first, /* a_attempt */ 0);
+    for ( size_t index = a_first ; index < a_last ; ++index ) {
+        sequencer::Activity activity = sequencer::Activity(/* a_sequence */ a_sequence, /* a_id */ "", /* a_index */ index, /* a_attempt */ 0);
+        if ( false == LoadActivity(a_sequence, index, activity) ) {
+            continue;
+        }
+        // ... never launched, there's no REDIS job - a local job number is used ...
+        const std::string tube = activity.payload()["job"].get("tube", "").asString();
+        const uint64_t    rjnr = ++local_rjnr_;
+        activity.Bind(/* rjnr_ */ rjnr,
+                      /* a_rjid */ ( config_.service_id() + ":jobs:" + tube + ':' + std::to_string(rjnr) ), /* a_rcnm */ tube,
+                      /* a_rcid */ ( config_.service_id() + ':'      + tube + ':' + std::to_string(rjnr) ),
+                      /* a_new_attempt */ true
+        );
+        // ... attempt is registered, with it's job payload ( never patched ), and then finalized like any other ...
+        Json::Value payload;
+        payload.swap(activity.DetachPayload()["job"]["payload"]);
+        activity.SetPayload(std::move(payload));
+        activity.SerializePayload();
+        RegisterActivity(activity);
+        activity.SetStatus(sequencer::Status::Done);
+        // ... log ...
+        SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, activity, CC_JOB_LOG_STEP_STEP,
+                               CC_JOB_LOG_COLOR(YELLOW) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
+                               "SKIPPED, jumped over by 'next_if' evaluation...");
+        // ... next one is already known, ignore it ...
+        FinalizeActivity(activity, &response, next);
+        metrics_.Count(tube, sequencer::Metrics::Counter::Skipped);
     }
 }
 
+/**
+ * @brief Callback to execute when a memoized activity must be finalized with it's cached response.
+ *
+ * @param a_id Callback id, 'memo:' + activity REDIS channel id.
+ */
+void casper::job::Sequencer::OnMemoTimer (const std::string& a_id)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    const uint64_t rjnr = RCID2RJNR(a_id);
+    
+    const auto it = memoized_.find(rjnr);
+    if ( memoized_.end() == it ) {
+        return;
+    }
+    const Json::Value response = std::move(it->second);
+    memoized_.erase(it);
+    
+    // ... activity still 'running' ( not cancelled )?
+    sequencer::Activity* activity = running_activities_.Find(rjnr);
+    if ( nullptr == activity ) {
+        return;
+    }
+    
+    // ... only completed responses are memoized, and this one must not be memoized again ...
+    activity->SetStatus(sequencer::Status::Done);
+    activity->SetMemoKey(0, nullptr);
+    
+    // ... signal activity 'completed' ...
+    ActivityReturned(SEQUENCER_TRACK_CALL(activity->sequence().bjid(), "ACTIVITY MEMOIZED"),
+                     *activity, &response
+    );
+}
+
 /**
  * @brief Register an attempt to launch an activity job.
  *
@@ -913,29 +2679,22 @@ void casper::job::Sequencer::RegisterActivity (const casper::job::sequencer::Act
     // ...
     //
     
-    std::stringstream ss; ss.clear(); ss.str("");
     Json::FastWriter  jw; jw.omitEndingLineFeed();
     
     Json::Value data = Json::Value(Json::ValueType::objectValue);
     
     data["launched_at"] = cc::UTCTime::NowISO8601WithTZ();
-    data["payload"    ] = a_activity.payload();
     data["bjid"       ] = a_activity.sequence().bjid();
     data["rjid"       ] = a_activity.rjid();
     data["rcid"       ] = a_activity.rcid();
-      
-    // ... js.register_activity (sid INTEGER, id INTEGER, bjid INTEGER, rjid TEXT, rcid TEXT, attempt INTEGER, payload JSONB, status js.status); ...
-    ss << "SELECT * FROM js.register_activity(";
-    ss <<   a_activity.sequence().did() << ',' << a_activity.did();
-    ss <<  ',' << a_activity.sequence().bjid() << ",'" << a_activity.rjid() << "','" << a_activity.rcid() << "'";
-    ss <<  ',' << a_activity.attempt();
-    ss <<   ",'" << ::ev::postgresql::Request::SQLEscape(jw.write(data)) << "'";
-    ss <<   ",'" << sequencer::Status::InProgress << "'";
-    ss << ");";
+    
+    // ... 'payload' is already serialized, splice it instead of copying and writing it again ...
+    std::string data_str = jw.write(data);
+    data_str.insert(data_str.length() - 1, ",\"payload\":" + a_activity.payload_str());
       
     // ... execute query ...
     ExecuteQueryAndWait(/* a_tracking */ SEQUENCER_TRACK_CALL(a_activity.sequence().bjid(), "REGISTERING ACTIVITY"),
-                        /* a_query    */ ss.str(), /* a_expected */ ExecStatusType::PGRES_TUPLES_OK
+                        /* a_query    */ sequencer::SQL::RegisterActivity(a_activity, data_str), /* a_expected */ ExecStatusType::PGRES_TUPLES_OK
     );
     
     // ... log ...
@@ -990,6 +2749,8 @@ void casper::job::Sequencer::SubscribeActivity (const casper::job::sequencer::Ac
     }, /* a_blocking */ false);
     
     cv.Wait();
+    
+    subscribed_.insert(a_activity.rjnr());
 }
 
 /**
@@ -1000,160 +2761,176 @@ void casper::job::Sequencer::SubscribeActivity (const casper::job::sequencer::Ac
  */
 EV_REDIS_SUBSCRIPTIONS_DATA_POST_NOTIFY_CALLBACK casper::job::Sequencer::OnActivityMessageReceived (const std::string& a_id, const std::string& a_message)
 {
-    
     CC_DEBUG_FAIL_IF_NOT_AT_MAIN_THREAD();
     
+    // ... hand it over to looper thread ...
+    PostMessage({ /* type_ */ MessageType::Activity, /* id_ */ 0, /* channel_ */ a_id, /* data_ */ a_message, /* object_ */ Json::Value::null });
     
-    ScheduleCallbackOnLooperThread(/* a_id */ MakeID("sequencer-activity-message-callback", a_id),
-        /* a_callback */
-        [this, a_id, a_message](const std::string& /* a_id */) {
-        
-            sequencer::Sequence*  sequence  = nullptr;
-            sequencer::Exception* exception = nullptr;
-
-            CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    // ... we're done ..
+    return nullptr;
+}
 
-            // ... expecting message?
-            const auto activity_it = running_activities_.find(a_id);
-            if ( running_activities_.end() == activity_it ) {
-                // ... log ...
-                CC_DEBUG_LOG_MSG("job", "Job #" INT64_FMT " ~= '%s': %s",
-                                 static_cast<uint64_t>(0), a_id.c_str(), "ignored"
-                );
-                // ... not expected, we're done ...
-                return;
-            }
-            
-            try {
-                
-                Json::Value  object;
-                
-                // ... parse JSON message ...
-                MSG2JSON(a_message, object);
-                
-                // ... check this inner job status ...
-                const std::string status = object.get("status", "").asCString();
-                CC_DEBUG_LOG_MSG("job", "Job #" INT64_FMT " ~= '%s': status is %s",
-                                 activity_it->second->sequence().bjid(), a_id.c_str(), status.c_str()
-                );
-                
-                // ... interested in this status ( completed, failed or cancelled ) ?
-                const auto m_it = s_irj_teminal_status_map_.find(status);
-                if ( s_irj_teminal_status_map_.end() == m_it ) {
-                    //
-                    // ... relay 'in-progress' messages ...
-                    // ... ( because we may have more activities to run ) ...
-                    if ( 0 == status.compare("in-progress") ) {
-                        ActivityMessageRelay(SEQUENCER_TRACK_CALL(activity_it->second->sequence().bjid(), "ACTIVITY MESSAGE RELAY"),
-                                             *activity_it->second, object
-                        );
-                    }
-                    // ... not interest, we're done
-                    return;
-                }
-                
-                // ... update activity statuus ...
-                activity_it->second->SetStatus(m_it->second);
-                
-                // ... copy sequence info - for try catch ...
-                sequence = new sequencer::Sequence(activity_it->second->sequence());
-                
-                //
-                // ... we're interested:
-                // ... ( completed, failed, error or cancelled )
-                //
-                // ... - we've got all required data to finalize this inner job
-                // ... - we can launch the next inner job ( if required )
-                //
-                ActivityReturned(SEQUENCER_TRACK_CALL(activity_it->second->sequence().bjid(), "RETURNING ACTIVITY"),
-                                 *activity_it->second, &object
-                );
-                
-                // ... ⚠️ from now on a_activity is NOT valid ! ⚠️ ...
-                
-            } catch (const sequencer::JumpErrorAlreadySet& a_jp_exception) {
+/**
+ * @brief Process an activity message received from REDIS.
+ *
+ * @param a_id      REDIS channel id.
+ * @param a_message Channel's message.
+ */
+void casper::job::Sequencer::ProcessActivityMessage (const std::string& a_id, const std::string& a_message)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    sequencer::SharedSequence sequence;
+    sequencer::Exception*     exception = nullptr;
 
-                // ... copy exception ...
-                exception = new sequencer::JumpErrorAlreadySet(a_jp_exception);
-                // ... log it ...
-                CC_JOB_LOG_TRACE(CC_JOB_LOG_LEVEL_DBG, "Job #" INT64_FMT " ~= ERROR JUMP =~\n\nORIGIN: %s:%d\nACTION: %s\n\%s\n",
-                                 a_jp_exception.tracking_.bjid_,
-                                 a_jp_exception.tracking_.function_.c_str(), a_jp_exception.tracking_.line_,
-                                 a_jp_exception.tracking_.action_.c_str(),
-                                 a_jp_exception.what()
+    // ... expecting message? ( job number must be valid and channel must be the one it was subscribed to ) ...
+    sequencer::Activity* activity = running_activities_.Find(RCID2RJNR(a_id));
+    if ( nullptr == activity || 0 != activity->rcid().compare(a_id) ) {
+        // ... log ...
+        CC_DEBUG_LOG_MSG("job", "Job #" INT64_FMT " ~= '%s': %s",
+                         static_cast<uint64_t>(0), a_id.c_str(), "ignored"
+        );
+        // ... not expected, we're done ...
+        return;
+    }
+    
+    try {
+        
+        Json::Value  object;
+        std::string  status;
+        
+        // ... peek status first, only messages we're interested in are fully parsed ...
+        const char* body   = a_message.data();
+        size_t      length = a_message.length();
+        if ( 0 != length && '*' == body[0] ) {
+            sequencer::Protocol::Unwrap(a_message, body, length);
+        }
+        if ( false == sequencer::Protocol::PeekStatus(body, length, status) ) {
+            // ... unable to peek, parse JSON message ...
+            MSG2JSON(a_message, object);
+            status = object.get("status", "").asString();
+        }
+        CC_DEBUG_LOG_MSG("job", "Job #" INT64_FMT " ~= '%s': status is %s",
+                         activity->sequence().bjid(), a_id.c_str(), status.c_str()
+        );
+        
+        // ... interested in this status ( completed, failed or cancelled ) ?
+        const auto m_it = s_irj_teminal_status_map_.find(status);
+        if ( s_irj_teminal_status_map_.end() == m_it ) {
+            //
+            // ... relay 'in-progress' messages ...
+            // ... ( because we may have more activities to run ) ...
+            if ( 0 == status.compare("in-progress") ) {
+                // ... relay original bytes ( peeked ones were checked to be well formed ), no need to parse and serialize it again ...
+                ActivityMessageRelay(SEQUENCER_TRACK_CALL(activity->sequence().bjid(), "ACTIVITY MESSAGE RELAY"),
+                                     *activity, body, length
                 );
-            
-            } catch (const sequencer::Exception& a_sq_exception) {
-                // ... copy exception ...
-                exception = new sequencer::Exception(a_sq_exception);
-                // ... log it ...
-                if ( nullptr != sequence ) {
-                    CC_JOB_LOG_TRACE(CC_JOB_LOG_LEVEL_DBG, "Job #" INT64_FMT "'%s': %s",
-                                     sequence->bjid(), a_id.c_str(), a_sq_exception.what()
-                    );
-                }
-            } catch (const ::cc::Exception& a_cc_exception) {
-                // ... if sequence found ...
-                if ( nullptr != sequence ) {
-                    // ... copy exception ...
-                    exception = new sequencer::Exception(SEQUENCER_TRACK_CALL(sequence->bjid(), "CC EXCEPTION CAUGHT"), /* a_code */ 500, a_cc_exception.what());
-                    // ... log it ...
-                    CC_JOB_LOG_TRACE(CC_JOB_LOG_LEVEL_DBG, "Job #" INT64_FMT "'%s': %s",
-                                     sequence->bjid(), a_id.c_str(), a_cc_exception.what()
-                    );
-                } else {
-                    // ... copy exception ...
-                    exception = new sequencer::Exception(SEQUENCER_TRACK_CALL(0, "CC EXCEPTION CAUGHT"), /* a_code */ 500, a_cc_exception.what());
-                }
-            } catch (...) {
-                try {
-                    ::cc::Exception::Rethrow(/* a_unhandled */ true, __FILE__, __LINE__, __FUNCTION__);
-                } catch (const ::cc::Exception& a_cc_exception) {
-                    // ... if sequence found ...
-                    if ( nullptr != sequence ) {
-                        // ... copy exception ...
-                        exception = new sequencer::Exception(SEQUENCER_TRACK_CALL(sequence->bjid(), "GENERIC CC EXCEPTION CAUGHT"), /* a_code */ 500, a_cc_exception.what());
-                        // ... log it ...
-                        CC_JOB_LOG_TRACE(CC_JOB_LOG_LEVEL_DBG, "Job #" INT64_FMT "'%s': %s",
-                                         sequence->bjid(), a_id.c_str(), a_cc_exception.what()
-                        );
-                    } else {
-                        // ... copy exception ...
-                        exception = new sequencer::Exception(SEQUENCER_TRACK_CALL(0, "GENERIC CC EXCEPTION CAUGHT"), /* a_code */ 500, a_cc_exception.what());
-                    }
-                }
             }
+            // ... not interest, we're done
+            return;
+        }
+        
+        // ... terminal status, full message is required ...
+        if ( true == object.isNull() ) {
+            MSG2JSON(a_message, object);
+        }
+        
+        // ... update activity statuus ...
+        activity->SetStatus(m_it->second);
+        
+        // ... keep sequence info - for try catch ...
+        sequence = activity->shared_sequence();
+        
+        //
+        // ... we're interested:
+        // ... ( completed, failed, error or cancelled )
+        //
+        // ... - we've got all required data to finalize this inner job
+        // ... - we can launch the next inner job ( if required )
+        //
+        ActivityReturned(SEQUENCER_TRACK_CALL(activity->sequence().bjid(), "RETURNING ACTIVITY"),
+                         *activity, &object
+        );
+        
+        // ... ⚠️ from now on a_activity is NOT valid ! ⚠️ ...
+        
+    } catch (const sequencer::JumpErrorAlreadySet& a_jp_exception) {
 
-            // ... accepted if sequence is set ...
+        // ... copy exception ...
+        exception = new sequencer::JumpErrorAlreadySet(a_jp_exception);
+        // ... log it ...
+        CC_JOB_LOG_TRACE(CC_JOB_LOG_LEVEL_DBG, "Job #" INT64_FMT " ~= ERROR JUMP =~\n\nORIGIN: %s:%d\nACTION: %s\n\%s\n",
+                         a_jp_exception.tracking_.bjid_,
+                         a_jp_exception.tracking_.function_.c_str(), a_jp_exception.tracking_.line_,
+                         a_jp_exception.tracking_.action_.c_str(),
+                         a_jp_exception.what()
+        );
+    
+    } catch (const sequencer::Exception& a_sq_exception) {
+        // ... copy exception ...
+        exception = new sequencer::Exception(a_sq_exception);
+        // ... log it ...
+        if ( nullptr != sequence ) {
+            CC_JOB_LOG_TRACE(CC_JOB_LOG_LEVEL_DBG, "Job #" INT64_FMT "'%s': %s",
+                             sequence->bjid(), a_id.c_str(), a_sq_exception.what()
+            );
+        }
+    } catch (const ::cc::Exception& a_cc_exception) {
+        // ... if sequence found ...
+        if ( nullptr != sequence ) {
+            // ... copy exception ...
+            exception = new sequencer::Exception(SEQUENCER_TRACK_CALL(sequence->bjid(), "CC EXCEPTION CAUGHT"), /* a_code */ 500, a_cc_exception.what());
+            // ... log it ...
+            CC_JOB_LOG_TRACE(CC_JOB_LOG_LEVEL_DBG, "Job #" INT64_FMT "'%s': %s",
+                             sequence->bjid(), a_id.c_str(), a_cc_exception.what()
+            );
+        } else {
+            // ... copy exception ...
+            exception = new sequencer::Exception(SEQUENCER_TRACK_CALL(0, "CC EXCEPTION CAUGHT"), /* a_code */ 500, a_cc_exception.what());
+        }
+    } catch (...) {
+        try {
+            ::cc::Exception::Rethrow(/* a_unhandled */ true, __FILE__, __LINE__, __FUNCTION__);
+        } catch (const ::cc::Exception& a_cc_exception) {
+            // ... if sequence found ...
             if ( nullptr != sequence ) {
-                // ... if an exception was thrown ...
-                if ( nullptr != exception ) {
-                    //
-                    Json::Value response = Json::Value::null;
-                    // ... build response ..
-                    (void)SetFailedResponse(exception->code_, response);
-                    // ... notify 'job finished' ...
-                    FinalizeJob(*sequence, response);
-                    // ... cleanup ...
-                    delete sequence;
-                    delete exception;
-                } else {
-                    // ... cleanup ...
-                    delete sequence;
-                }
+                // ... copy exception ...
+                exception = new sequencer::Exception(SEQUENCER_TRACK_CALL(sequence->bjid(), "GENERIC CC EXCEPTION CAUGHT"), /* a_code */ 500, a_cc_exception.what());
+                // ... log it ...
+                CC_JOB_LOG_TRACE(CC_JOB_LOG_LEVEL_DBG, "Job #" INT64_FMT "'%s': %s",
+                                 sequence->bjid(), a_id.c_str(), a_cc_exception.what()
+                );
             } else {
-                // ...sequence NOT set, is exception set?
-                if ( nullptr != exception ) {
-                    // ... log it ...
-                    SEQUENCER_LOG_CRITICAL_EXCEPTION("%s", exception->what());
-                    // ... cleanup ...
-                    delete exception;
-                }
+                // ... copy exception ...
+                exception = new sequencer::Exception(SEQUENCER_TRACK_CALL(0, "GENERIC CC EXCEPTION CAUGHT"), /* a_code */ 500, a_cc_exception.what());
             }
-    });
-    
-    // ... we're done ..
-    return nullptr;
+        }
+    }
+
+    // ... accepted if sequence is set ...
+    if ( nullptr != sequence ) {
+        // ... if an exception was thrown ...
+        if ( nullptr != exception ) {
+            //
+            Json::Value response = Json::Value::null;
+            // ... build response ..
+            (void)SetFailedResponse(exception->code_, response);
+            // ... other running activities of this sequence ( hedged attempt, parallel group or 'map' step items ) must not outlive it ...
+            ReleaseSequence(*sequence, response);
+            // ... notify 'job finished' ...
+            FinalizeJob(*sequence, response);
+            // ... cleanup ...
+            delete exception;
+        }
+    } else {
+        // ...sequence NOT set, is exception set?
+        if ( nullptr != exception ) {
+            // ... log it ...
+            SEQUENCER_LOG_CRITICAL_EXCEPTION("%s", exception->what());
+            // ... cleanup ...
+            delete exception;
+        }
+    }
 }
 
 /**
@@ -1165,6 +2942,11 @@ void casper::job::Sequencer::UnsubscribeActivity (const casper::job::sequencer::
 {
     CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
     
+    // ... never subscribed ( e.g. a 'map' step parent ) or already unsubscribed?
+    if ( 0 == subscribed_.erase(a_activity.rjnr()) ) {
+        return;
+    }
+    
     // ... log ...
     SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_VBS, a_activity, CC_JOB_LOG_STEP_REDIS,
                            "Unsubscribing from channel '%s'",
@@ -1196,6 +2978,101 @@ void casper::job::Sequencer::UnsubscribeActivity (const casper::job::sequencer::
     cv.Wait();
 }
 
+/**
+ * @brief Set a job status and publish it, as is, to it's REDIS channel.
+ *
+ * @param a_channel REDIS channel to publish to.
+ * @param a_key     REDIS job key.
+ * @param a_message JSON object text, already serialized.
+ */
+void casper::job::Sequencer::RelayMessage (const std::string& a_channel, const std::string& a_key, const std::string& a_message)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    RelayTicket ticket;
+    StartRelayMessage(a_channel, a_key, a_message, ticket);
+    WaitRelayMessage(ticket);
+}
+
+/**
+ * @brief Start to set a job status and publish it, as is, to it's REDIS channel, without waiting for it.
+ *
+ * @param a_channel REDIS channel to publish to.
+ * @param a_key     REDIS job key.
+ * @param a_message JSON object text, already serialized.
+ * @param o_ticket  Ticket to wait for, all parameters MUST be valid until \link WaitRelayMessage \link returns.
+ */
+void casper::job::Sequencer::StartRelayMessage (const std::string& a_channel, const std::string& a_key, const std::string& a_message,
+                                                casper::job::Sequencer::RelayTicket& o_ticket)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    RelayTicket* ticket = &o_ticket;
+    ticket->error_ = "";
+    
+    ExecuteOnMainThread([this, ticket, &a_channel, &a_key, &a_message] () {
+        
+        NewTask([this, &a_key, &a_message] () -> ::ev::Object* {
+            
+            // ... set status ...
+            return new ::ev::redis::Request(loggable_data_, "HSET", {
+                /* key   */ a_key,
+                /* field */ "status", a_message
+            });
+            
+        })->Then([this, &a_channel, &a_message] (::ev::Object* a_object) -> ::ev::Object* {
+            
+            //
+            // HSET:
+            //
+            // - An integer reply is expected.
+            //
+            (void)::ev::redis::Reply::EnsureIntegerReply(a_object);
+            
+            // ... publish it ...
+            return new ::ev::redis::Request(loggable_data_, "PUBLISH", { a_channel, a_message });
+            
+        })->Finally([ticket] (::ev::Object* a_object) {
+            
+            //
+            // PUBLISH:
+            //
+            // - An integer reply is expected: the number of clients that received the message.
+            //
+            (void)::ev::redis::Reply::EnsureIntegerReply(a_object);
+            
+            // RELEASE control
+            ticket->cv_.Wake();
+            
+        })->Catch([ticket] (const ::ev::Exception& a_ev_exception) {
+            
+            ticket->error_ = a_ev_exception.what();
+            
+            // RELEASE control
+            ticket->cv_.Wake();
+            
+        });
+        
+    }, /* a_blocking */ false);
+}
+
+/**
+ * @brief Wait for a relay started by \link StartRelayMessage \link.
+ *
+ * @param a_ticket Ticket to wait for.
+ */
+void casper::job::Sequencer::WaitRelayMessage (casper::job::Sequencer::RelayTicket& a_ticket)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    // ... WAIT ...
+    a_ticket.cv_.Wait();
+    
+    if ( 0 != a_ticket.error_.length() ) {
+        throw ::cc::Exception("%s", a_ticket.error_.c_str());
+    }
+}
+
 #ifdef __APPLE__
 #pragma mark -
 #endif
@@ -1205,12 +3082,10 @@ void casper::job::Sequencer::UnsubscribeActivity (const casper::job::sequencer::
  *
  * @param a_activity Activity info.
  */
-    void casper::job::Sequencer::PushActivity (const casper::job::sequencer::Activity& a_activity)
+void casper::job::Sequencer::PushActivity (const casper::job::sequencer::Activity& a_activity)
 {
     CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
     
-    Json::FastWriter ljfw; ljfw.omitEndingLineFeed();
-    
     // ... at macOS and if debug mode ...
     #if defined(__APPLE__) && !defined(NDEBUG) && ( defined(DEBUG) || defined(_DEBUG) || defined(ENABLE_DEBUG) )
         // ... if configured will sleep between message relay ...
@@ -1218,56 +3093,329 @@ void casper::job::Sequencer::UnsubscribeActivity (const casper::job::sequencer::
     #endif
         
     // ... clean up ...
-    {
-        const std::string src_channel_key = a_activity.rcid();
-        const std::string dst_channel_key = a_activity.sequence().rcid();
-        const std::string dst_job_key     = a_activity.sequence().rjid();
-        Json::Value       status          = Json::Value(Json::ValueType::objectValue);
-        status["status"]                  = "reset";
-        status["activity"]["number"]      = static_cast<Json::UInt64>(a_activity.index() + 1);
-        status["activity"]["count"]       = static_cast<Json::UInt64>(a_activity.sequence().count());
-#if defined(__APPLE__) && !defined(NDEBUG) && ( defined(DEBUG) || defined(_DEBUG) || defined(ENABLE_DEBUG) )
-        status["debug"]["activity"]["rcid"]   = a_activity.rcid();
-        status["debug"]["activity"]["number"] = static_cast<Json::UInt64>(a_activity.index() + 1);
-        status["debug"]["sequence"]["rcid"]   = a_activity.sequence().rcid();
-        status["debug"]["sequence"]["count"]  = static_cast<Json::UInt64>(a_activity.sequence().count());
-#endif
+    const uint64_t    relay_start     = sequencer::Stats::Now();
+    const std::string src_channel_key = a_activity.rcid();
+    const std::string dst_channel_key = a_activity.sequence().rcid();
+    const std::string dst_job_key     = a_activity.sequence().rjid();
+    const std::string message         = ForgeResetMessage(a_activity);
+    
+    //
+    // ⚠️ REDIS relay runs at main thread while we're pushing to beanstalkd,
+    //    it's parameters MUST be kept alive until WaitRelayMessage returns.
+    //
+    RelayTicket ticket;
+    StartRelayMessage(dst_channel_key, dst_job_key, message, ticket);
+    
+    // ... log ...
+    SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_VBS, a_activity, CC_JOB_LOG_STEP_BEANSTALK,
+                           "%s", "Pushing to beanstalkd");
+    
+    // ... submit job to beanstalkd queue ...
+    const uint64_t push_start = sequencer::Stats::Now();
+    try {
+        if ( true == producer_.Enabled() ) {
+            const std::string                     tube = a_activity.payload()["tube"].asString();
+            std::vector<sequencer::Producer::Job> jobs = { ProducerJob(a_activity, tube) };
+            producer_.Put(jobs);
+            if ( 0 != jobs[0].error_.length() ) {
+                throw ::cc::Exception("%s", jobs[0].error_.c_str());
+            }
+            if ( true == jobs[0].unknown_ ) {
+                SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_WRN, a_activity, CC_JOB_LOG_STEP_BEANSTALK,
+                                       "%s", "Push outcome is unknown, connection failed before it's reply - relying on activity timeout");
+            }
+        } else {
+            PushJob(a_activity.payload()["tube"].asString(), a_activity.payload_str(), a_activity.ttr());
+        }
+    } catch (...) {
+        // ... relay is still using stack variables, wait for it ...
+        try {
+            WaitRelayMessage(ticket);
+        } catch (...) {
+            // ... push exception takes precedence ...
+        }
+        throw;
+    }
+    stats_.Record(a_activity.rcnm(), sequencer::Stats::Stage::Push, push_start);
+    
+    // ... wait for relay ...
+    try {
+        WaitRelayMessage(ticket);
+    } catch (...) {
+        try {
+            ::cc::Exception::Rethrow(/* a_unhandled */ true, __FILE__, __LINE__, __FUNCTION__);
+        } catch (const ::cc::Exception& a_cc_exception) {
+            // ... log ...
+            SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_WRN, a_activity, CC_JOB_LOG_STEP_RELAY,
+                                   CC_JOB_LOG_COLOR(RED) "Failed to relay ( forged ) message"
+                                   CC_LOGS_LOGGER_RESET_ATTRS " from %s to %s, " CC_JOB_LOG_COLOR(DARK_GRAY) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
+                                   src_channel_key.c_str(), dst_channel_key.c_str(), a_cc_exception.what()
+            );
+        }
+    }
+    metrics_.Observe(sequencer::Metrics::Latency::Redis, stats_.Record(a_activity.rcnm(), sequencer::Stats::Stage::Relay, relay_start));
+    
+    // ... at macOS and if debug mode ...
+    #if defined(__APPLE__) && !defined(NDEBUG) && ( defined(DEBUG) || defined(_DEBUG) || defined(ENABLE_DEBUG) )
+        // ... if configured will sleep between message relay ...
+        Sleep(activity_config_, a_activity, "Sleeping between ( forged ) message relays");
+    #endif
+    
+    // ... log ...
+    SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, a_activity, CC_JOB_LOG_STEP_BEANSTALK,
+                           "%s", "Pushed to beanstalkd");
+}
+
+/**
+ * @brief Build a pipelined producer job for an activity.
+ *
+ * @param a_activity Activity info, MUST be kept alive until job is pushed.
+ * @param a_tube     Activity tube, MUST be kept alive until job is pushed.
+ *
+ * @return Producer job, optional activity 'priority' and 'delay' are honoured ( both default to 0, as \link PushJob \link uses ).
+ */
+casper::job::sequencer::Producer::Job casper::job::Sequencer::ProducerJob (const casper::job::sequencer::Activity& a_activity, const std::string& a_tube)
+{
+    const Json::Value& priority = a_activity.payload()["priority"];
+    const Json::Value& delay    = a_activity.payload()["delay"];
+    return {
+        /* tube_     */ &a_tube,
+        /* payload_  */ &a_activity.payload_str(),
+        /* priority_ */ static_cast<uint32_t>(true == priority.isUInt() ? priority.asUInt() : 0),
+        /* delay_    */ static_cast<uint32_t>(true == delay.isUInt()    ? delay.asUInt()    : 0),
+        /* ttr_      */ static_cast<uint32_t>(a_activity.ttr()),
+        /* id_       */ 0,
+        /* error_    */ "",
+        /* unknown_  */ false
+    };
+}
+
+/**
+ * @brief Queue an activity to be pushed to BEANSTALKD queue by \link FlushActivityPushes \link.
+ *
+ * @param a_activity Activity info, it MUST be tracked.
+ */
+void casper::job::Sequencer::QueueActivityPush (const casper::job::sequencer::Activity& a_activity)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    // ... at macOS and if debug mode ...
+    #if defined(__APPLE__) && !defined(NDEBUG) && ( defined(DEBUG) || defined(_DEBUG) || defined(ENABLE_DEBUG) )
+        // ... if configured will sleep between message relay ...
+        Sleep(sequence_config_, a_activity, "Sleeping before activity push");
+    #endif
+    
+    pushes_.emplace_back();
+    
+    PendingPush& push = pushes_.back();
+    push.rjnr_    = a_activity.rjnr();
+    push.channel_ = a_activity.sequence().rcid();
+    push.key_     = a_activity.sequence().rjid();
+    push.message_ = ForgeResetMessage(a_activity);
+    push.started_ = false;
+    
+    // ... log ...
+    SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_VBS, a_activity, CC_JOB_LOG_STEP_BEANSTALK,
+                           "Queued for beanstalkd push, " SIZET_FMT " pending", pushes_.size());
+}
+
+/**
+ * @brief Push all queued activities to BEANSTALKD queue.
+ *
+ * All ( forged ) reset messages relays are started first, then all jobs are pushed - in a single write / replies cycle
+ * if the pipelined producer is enabled, back-to-back otherwise - and only then we wait for the relays.
+ * Push failures are handled per activity, as \link LaunchActivity \link would.
+ */
+void casper::job::Sequencer::FlushActivityPushes ()
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    if ( 0 == pushes_.size() ) {
+        return;
+    }
+    
+    // ... activities failing to be pushed might launch others, those must not be queued here ...
+    std::deque<PendingPush> pending;
+    pending.swap(pushes_);
+    
+    const uint64_t relay_start = sequencer::Stats::Now();
+    
+    //
+    // ⚠️ REDIS relays run at main thread while we're pushing to beanstalkd,
+    //    pending MUST be kept alive until all WaitRelayMessage calls return.
+    //
+    for ( auto& push : pending ) {
+        // ... still running? ( it might have been cancelled while draining messages ) ...
+        if ( nullptr == running_activities_.Find(push.rjnr_) ) {
+            continue;
+        }
+        StartRelayMessage(push.channel_, push.key_, push.message_, push.ticket_);
+        push.started_ = true;
+    }
+    
+    // ... submit all jobs to beanstalkd queue, pipelined ...
+    if ( true == producer_.Enabled() ) {
+        std::vector<std::string>              tubes;
+        std::vector<sequencer::Producer::Job> jobs;
+        std::vector<PendingPush*>             pushes;
+        tubes.reserve(pending.size());
+        jobs.reserve(pending.size());
+        pushes.reserve(pending.size());
+        for ( auto& push : pending ) {
+            if ( false == push.started_ ) {
+                continue;
+            }
+            const sequencer::Activity* activity = running_activities_.Find(push.rjnr_);
+            // ... log ...
+            SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_VBS, (*activity), CC_JOB_LOG_STEP_BEANSTALK,
+                                   "%s", "Pushing to beanstalkd");
+            tubes.push_back(activity->payload()["tube"].asString());
+            jobs.push_back(ProducerJob(*activity, tubes.back()));
+            pushes.push_back(&push);
+        }
+        const uint64_t push_start = sequencer::Stats::Now();
+        producer_.Put(jobs);
+        const uint64_t pushed_at = sequencer::Stats::Now();
+        for ( size_t idx = 0 ; idx < jobs.size() ; ++idx ) {
+            if ( 0 != jobs[idx].error_.length() ) {
+                pushes[idx]->error_ = jobs[idx].error_;
+                continue;
+            }
+            sequencer::Activity* activity = running_activities_.Find(pushes[idx]->rjnr_);
+            // ... written but not replied? it might have been inserted, pushing it again could run it twice ...
+            if ( true == jobs[idx].unknown_ ) {
+                SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_WRN, (*activity), CC_JOB_LOG_STEP_BEANSTALK,
+                                       "%s", "Push outcome is unknown, connection failed before it's reply - relying on activity timeout");
+            }
+            stats_.Record(activity->rcnm(), sequencer::Stats::Stage::Push, push_start);
+            // ... worker execution time is measured from now until activity returns ...
+            activity->SetPushedAt(pushed_at);
+        }
+    }
+    for ( auto& push : pending ) {
+        if ( false == push.started_ || true == producer_.Enabled() ) {
+            continue;
+        }
+        sequencer::Activity* activity = running_activities_.Find(push.rjnr_);
         // ... log ...
-        SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_DBG, a_activity, CC_JOB_LOG_STEP_RELAY,
-                               CC_JOB_LOG_COLOR(YELLOW) "Relay ( forged ) message" CC_LOGS_LOGGER_RESET_ATTRS " from %s to %s, " CC_JOB_LOG_COLOR(DARK_GRAY) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
-                               src_channel_key.c_str(), dst_channel_key.c_str(), ljfw.write(status).c_str()
-        );
+        SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_VBS, (*activity), CC_JOB_LOG_STEP_BEANSTALK,
+                               "%s", "Pushing to beanstalkd");
+        const uint64_t push_start = sequencer::Stats::Now();
+        try {
+            PushJob(activity->payload()["tube"].asString(), activity->payload_str(), activity->ttr());
+        } catch (...) {
+            try {
+                ::cc::Exception::Rethrow(/* a_unhandled */ false, __FILE__, __LINE__, __FUNCTION__);
+            } catch (const ::cc::Exception& a_cc_exception) {
+                push.error_ = a_cc_exception.what();
+            }
+            continue;
+        }
+        stats_.Record(activity->rcnm(), sequencer::Stats::Stage::Push, push_start);
+        // ... worker execution time is measured from now until activity returns ...
+        activity->SetPushedAt(sequencer::Stats::Now());
+    }
+    
+    // ... wait for all relays ...
+    for ( auto& push : pending ) {
+        if ( false == push.started_ ) {
+            continue;
+        }
+        const sequencer::Activity* activity = running_activities_.Find(push.rjnr_);
         try {
-            Relay(a_activity.sequence().bjid(), dst_channel_key, dst_job_key, status);
+            WaitRelayMessage(push.ticket_);
         } catch (...) {
             try {
                 ::cc::Exception::Rethrow(/* a_unhandled */ true, __FILE__, __LINE__, __FUNCTION__);
             } catch (const ::cc::Exception& a_cc_exception) {
                 // ... log ...
-                SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_WRN, a_activity, CC_JOB_LOG_STEP_RELAY,
+                SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_WRN, (*activity), CC_JOB_LOG_STEP_RELAY,
                                        CC_JOB_LOG_COLOR(RED) "Failed to relay ( forged ) message"
                                        CC_LOGS_LOGGER_RESET_ATTRS " from %s to %s, " CC_JOB_LOG_COLOR(DARK_GRAY) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
-                                       src_channel_key.c_str(), dst_channel_key.c_str(), a_cc_exception.what()
+                                       activity->rcid().c_str(), push.channel_.c_str(), a_cc_exception.what()
                 );
             }
         }
-        // ... at macOS and if debug mode ...
-        #if defined(__APPLE__) && !defined(NDEBUG) && ( defined(DEBUG) || defined(_DEBUG) || defined(ENABLE_DEBUG) )
-            // ... if configured will sleep between message relay ...
-            Sleep(activity_config_, a_activity, "Sleeping between ( forged ) message relays");
-        #endif
+        metrics_.Observe(sequencer::Metrics::Latency::Redis, stats_.Record(activity->rcnm(), sequencer::Stats::Stage::Relay, relay_start));
+        // ... pushed?
+        if ( 0 == push.error_.length() ) {
+            // ... log ...
+            SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, (*activity), CC_JOB_LOG_STEP_BEANSTALK,
+                                   "%s", "Pushed to beanstalkd");
+            SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, (*activity), CC_JOB_LOG_STEP_STEP,
+                                   "Launched with REDIS channel ID %s", activity->rcid().c_str());
+            metrics_.Count(activity->rcnm(), sequencer::Metrics::Counter::Launched);
+        }
     }
     
-    // ... log ...
-    SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_VBS, a_activity, CC_JOB_LOG_STEP_BEANSTALK,
-                           "%s", "Pushing to beanstalkd");
+    // ... finalize activities that failed to be pushed, one by one ...
+    for ( auto& push : pending ) {
+        if ( false == push.started_ || 0 == push.error_.length() ) {
+            continue;
+        }
+        sequencer::Activity* tracked = running_activities_.Find(push.rjnr_);
+        if ( nullptr == tracked ) {
+            continue;
+        }
+        // ... copy activity info, once untracked it's relased and it's reference is no longer válid ...
+        sequencer::Activity activity = sequencer::Activity(*tracked);
+        const sequencer::Tracking tracking = SEQUENCER_TRACK_CALL(activity.sequence().bjid(), "PUSHING ACTIVITY");
+        try {
+            // ... and this activity ...
+            UntrackActivity(activity);
+            // ... unsubscribe activity ...
+            UnsubscribeActivity(activity);
+            // ... log ...
+            SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_ERR, activity, CC_JOB_LOG_STEP_ERROR,
+                                   "An error occurred while launching activity ~ " CC_JOB_LOG_COLOR(RED) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
+                                   push.error_.c_str()
+            );
+            Json::Value payload  = Json::Value(Json::ValueType::objectValue);
+            payload["exception"] = push.error_;
+            Json::Value errors  = Json::Value::null;
+            // ... override with errors serialization ...
+            (void)SetFailedResponse(/* a_code */ 400, payload, errors);
+            // ... reset
+            activity.Reset(sequencer::Status::Failed, /* a_payload */ std::move(errors));
+            // ... just 'finalize' activity ( by setting failed status ) ...
+            (void)ActivityReturned(tracking, activity, /* a_response */ nullptr);
+        } catch (const ::cc::Exception& a_cc_exception) {
+            // ... log error ...
+            SEQUENCER_LOG_JOB(CC_JOB_LOG_LEVEL_ERR, tracking.bjid_, CC_JOB_LOG_STEP_ERROR, "%s", a_cc_exception.what());
+        }
+    }
+}
+
+/**
+ * @brief Forge and serialize the 'reset' status message to relay to sequence job channel, before an activity is pushed.
+ *
+ * @param a_activity Activity info.
+ *
+ * @return JSON object text.
+ */
+std::string casper::job::Sequencer::ForgeResetMessage (const casper::job::sequencer::Activity& a_activity)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
     
-    // ... submit job to beanstalkd queue ...
-    PushJob(a_activity.payload()["tube"].asString(), ljfw.write(a_activity.payload()), a_activity.ttr());
+    Json::FastWriter ljfw; ljfw.omitEndingLineFeed();
     
+    Json::Value status           = Json::Value(Json::ValueType::objectValue);
+    status["status"]             = "reset";
+    status["activity"]["number"] = static_cast<Json::UInt64>(a_activity.index() + 1);
+    status["activity"]["count"]  = static_cast<Json::UInt64>(a_activity.sequence().count());
+#if defined(__APPLE__) && !defined(NDEBUG) && ( defined(DEBUG) || defined(_DEBUG) || defined(ENABLE_DEBUG) )
+    status["debug"]["activity"]["rcid"]   = a_activity.rcid();
+    status["debug"]["activity"]["number"] = static_cast<Json::UInt64>(a_activity.index() + 1);
+    status["debug"]["sequence"]["rcid"]   = a_activity.sequence().rcid();
+    status["debug"]["sequence"]["count"]  = static_cast<Json::UInt64>(a_activity.sequence().count());
+#endif
+    const std::string message = ljfw.write(status);
     // ... log ...
-    SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, a_activity, CC_JOB_LOG_STEP_BEANSTALK,
-                           "%s", "Pushed to beanstalkd");
+    SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_DBG, a_activity, CC_JOB_LOG_STEP_RELAY,
+                           CC_JOB_LOG_COLOR(YELLOW) "Relay ( forged ) message" CC_LOGS_LOGGER_RESET_ATTRS " from %s to %s, " CC_JOB_LOG_COLOR(DARK_GRAY) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
+                           a_activity.rcid().c_str(), a_activity.sequence().rcid().c_str(), message.c_str()
+    );
+    return message;
 }
 
 /**
@@ -1293,8 +3441,6 @@ void casper::job::Sequencer::FinalizeActivity (const casper::job::sequencer::Act
     //         }],
     // ...
     //
-    CC_WARNING_TODO("CJS: implement retry mechanism beware of status meaning");
-    
     std::stringstream ss; ss.clear(); ss.str("");
     Json::FastWriter  jw; jw.omitEndingLineFeed();
     
@@ -1309,45 +3455,40 @@ void casper::job::Sequencer::FinalizeActivity (const casper::job::sequencer::Act
     // NOTICE: rtt will be calculated and set unpon js.finalize_activity execution ...
     //
     attempt["finished_at"] = cc::UTCTime::NowISO8601WithTZ();
-    // ... if a_response was provided ...
-    if ( nullptr != a_response ) {
-        // ... copy response ...
-        attempt["response"] = *a_response;
-    } else {
-        // ... else, payload MUST be already set, use it ...
-        attempt["response"] = a_activity.payload();
-    }
+    // ... if a_response was not provided, payload MUST be already set, use it ...
+    // ... serialize it only once, without copying it into attempt object ...
+    const std::string response_str = jw.write(( nullptr != a_response ? *a_response : a_activity.payload() ));
+    std::string       attempt_str  = jw.write(attempt);
+    attempt_str.insert(attempt_str.length() - 1, ",\"response\":" + response_str);
     
-    // ... js.finalize_activity (sid INTEGER, id INTEGER, attempt INTEGER, payload JSONB, response JSONB, status js.status) ...
-    ss << "SELECT * FROM js.finalize_activity(";
-    ss <<   a_activity.sequence().did() << ',' << a_activity.did();
-    ss <<  ',' << a_activity.attempt() << ",'" << ::ev::postgresql::Request::SQLEscape(jw.write(attempt)) << "'";
-    ss <<  ",'" << ::ev::postgresql::Request::SQLEscape(jw.write(attempt["response"])) << "'";
-    ss <<  ",'" << a_activity.status() << "'";
-    ss << ");";
+    const std::string query = sequencer::SQL::FinalizeActivity(a_activity, attempt_str, response_str);
   
     // ... log ...
     SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_VBS, a_activity, CC_JOB_LOG_STEP_POSGRESQL,
                            "%s", "Registering finalization");
     
-    double rtt = -1.0;
+    double         rtt            = -1.0;
+    const uint64_t finalize_start = sequencer::Stats::Now();
     
     // ... execute query ...
     ExecuteQueryAndWait(/* a_tracking         */ SEQUENCER_TRACK_CALL(a_activity.sequence().bjid(), "FINALIZING ACTIVITY"),
-                        /* a_query            */ ss.str(), /* a_expect   */ ExecStatusType::PGRES_TUPLES_OK,
+                        /* a_query            */ query, /* a_expect   */ ExecStatusType::PGRES_TUPLES_OK,
                         /* a_success_callback */
-                        [this, &o_next, &rtt] (const Json::Value& a_value) {
+                        [this, &o_next, &rtt] (Json::Value& a_value) {
                             // ... array is expected ...
                             if ( a_value.size() > 0 ) {
                                 // ... ⚠️ we're returning the last activity rtt in the next activity ...
                                 rtt = a_value[0]["rtt"].asDouble() * 1000;
                                 // ... if ID is not rull then we've a 'next' activity ...
-                                const Json::Value& next = a_value[0];
+                                Json::Value& next = a_value[0];
                                 if ( false == next["id"].isNull() ) {
-                                    o_next.Reset(sequencer::Status::Pending, /* a_payload */ next);
-                                    o_next.SetIndex(static_cast<size_t>(next["index"].asUInt()));
-                                    o_next.SetDID(next["id"].asString());                                    
-                                    const auto job = GetJSONObject(o_next.payload(), "job", Json::ValueType::objectValue, /* a_default */ nullptr);
+                                    const auto index = static_cast<size_t>(next["index"].asUInt());
+                                    const auto did   = next["id"].asString();
+                                    // ... row is no longer needed, move it ...
+                                    o_next.Reset(sequencer::Status::Pending, /* a_payload */ std::move(next));
+                                    o_next.SetIndex(index);
+                                    o_next.SetDID(did);
+                                    const auto& job = GetJSONObject(o_next.payload(), "job", Json::ValueType::objectValue, /* a_default */ nullptr);
                                     o_next.SetTTR           (GetJSONObject(job, "ttr"     , Json::ValueType::intValue   , &activity_config_.ttr_     ).asUInt());
                                     o_next.SetValidity      (GetJSONObject(job, "validity", Json::ValueType::intValue   , &activity_config_.validity_).asUInt());
                                     o_next.SetAbortCondition(GetJSONObject(job, "abort"   , Json::ValueType::objectValue, &Json::Value::null));
@@ -1356,6 +3497,8 @@ void casper::job::Sequencer::FinalizeActivity (const casper::job::sequencer::Act
                         }
     );
     
+    stats_.Record(a_activity.rcnm(), sequencer::Stats::Stage::Finalize, finalize_start);
+    
     Json::FastWriter ljfw; ljfw.omitEndingLineFeed();
         
     // ... log ...
@@ -1393,7 +3536,7 @@ void casper::job::Sequencer::FinalizeActivity (const casper::job::sequencer::Act
                 // ... set standard 'failed' response ...
                 (void)SetFailedResponse(/* a_code */ 404, Json::Value("Invalid status '" + std::string(status.asCString()) + "'"), response);
                 // ... invalid status - set internal error ...
-                o_next.Reset(sequencer::Status::Failed, /* a_payload */ response);
+                o_next.Reset(sequencer::Status::Failed, /* a_payload */ std::move(response));
             }
         } else {
             // ... no, we're done ...
@@ -1417,15 +3560,42 @@ void casper::job::Sequencer::CancelActivity (const casper::job::sequencer::Activ
     
     // ... copy activity info, once cancelled / untracked it's relased and it's reference is no longer válid ...
     const sequencer::Activity activity = sequencer::Activity(a_activity);
+    
+    // ... 'map' step parent? it was never pushed nor subscribed, it's items are cancelled by CancelSequence ...
+    const SequenceState* state = FindSequenceState(activity.sequence().rjnr());
+    if ( nullptr != state && nullptr != state->map_ && &a_activity == state->map_->parent_.get() ) {
+        return;
+    }
+    
+    // ... waiting to be retried? it's job already returned and it's no longer subscribed ...
+    const bool waiting = ( retries_.erase(activity.rjnr()) > 0 );
+    if ( true == waiting ) {
+        TryCancelCallbackOnLooperThread("retry:" + activity.rcid());
+    }
+    // ... skipped or memoized? it's finalized locally, there's no REDIS job to signal ...
+    const bool skipped  = ( skips_.erase(activity.rjnr()) > 0 );
+    const bool memoized = ( memoized_.erase(activity.rjnr()) > 0 );
+    if ( true == skipped ) {
+        TryCancelCallbackOnLooperThread("skip:" + activity.rcid());
+    }
+    if ( true == memoized ) {
+        TryCancelCallbackOnLooperThread("memo:" + activity.rcid());
+    }
+    
+    // ... forget coalesced 'in-progress' messages ...
+    FlushActivityMessages(activity, /* a_relay */ false);
 
     // ... untrack activity ...
     UntrackActivity(a_activity); // ... ⚠️ from now on a_activity is NOT valid ! ⚠️ ...
 
-    // ... unsubscribe activity ...
-    UnsubscribeActivity(activity);
-
-    // ... signal activity's job to cancel ...
-    Cancel(activity.sequence().bjid(), activity.rcid(), activity.rjid());
+    if ( false == waiting && false == skipped && false == memoized ) {
+        // ... unsubscribe activity ...
+        UnsubscribeActivity(activity);
+        // ... signal activity's job to cancel ...
+        Cancel(activity.sequence().bjid(), activity.rcid(), activity.rjid());
+    }
+    
+    metrics_.Count(activity.rcnm(), sequencer::Metrics::Counter::Cancelled);
 }
 
 #ifdef __APPLE__
@@ -1457,17 +3627,18 @@ void casper::job::Sequencer::TrackActivity (const casper::job::sequencer::Activi
 
         
     // ... keep track of running activity ...
-    running_activities_[a_activity.rcid()] = new casper::job::sequencer::Activity(a_activity);
+    sequencer::Activity* activity = new casper::job::sequencer::Activity(a_activity);
+    delete running_activities_.Erase(activity->rjnr());
+    running_activities_.Insert(activity->rjnr(), activity);
+    running_sequences_.Insert(activity->sequence().rjnr(), activity);
+    sequences_[activity->sequence().rjnr()].running_.insert(activity->rjnr());
     
     // ... schedule a timeout event for this activity ...
     ScheduleCallbackOnLooperThread(/* a_id */ a_activity.rcid(),
                                    /* a_callback */ std::bind(&casper::job::Sequencer::OnActivityTimeout, this, std::placeholders::_1),
                                    /* a_deferred  */ ( a_activity.timeout() * 1000 ) + 100 , // ttr + 100 milliseconds of threshold
                                    /* a_recurrent */ false
-   );
-    
-    // ... log ...
-    LogStats();
+   );
 }
 
 /**
@@ -1494,7 +3665,12 @@ void casper::job::Sequencer::TrackActivity (casper::job::sequencer::Activity* a_
     );
 
     // ... keep track of running activity ...
-    running_activities_[a_activity->rcid()] = a_activity;
+    if ( a_activity != running_activities_.Find(a_activity->rjnr()) ) {
+        delete running_activities_.Erase(a_activity->rjnr());
+        running_activities_.Insert(a_activity->rjnr(), a_activity);
+    }
+    running_sequences_.Insert(a_activity->sequence().rjnr(), a_activity);
+    sequences_[a_activity->sequence().rjnr()].running_.insert(a_activity->rjnr());
     
     // ... schedule a timeout event for this activity ...
     ScheduleCallbackOnLooperThread(/* a_id */ a_activity->rcid(),
@@ -1502,9 +3678,6 @@ void casper::job::Sequencer::TrackActivity (casper::job::sequencer::Activity* a_
                                    /* a_deferred  */ ( a_activity->timeout() * 1000 ) + 100 , // ttr + 100 milliseconds of threshold
                                    /* a_recurrent */ false
     );
-    
-    // ... log ...
-    LogStats();
 }
 
 /**
@@ -1525,14 +3698,33 @@ void casper::job::Sequencer::UntrackActivity (const casper::job::sequencer::Acti
     TryCancelCallbackOnLooperThread(a_activity.rcid());
 
     // ... ensure it's running ...
-    const auto it = running_activities_.find(a_activity.rcid());
-    if ( running_activities_.end() != it ) {
-        delete it->second;
-        running_activities_.erase(it);
+    sequencer::Activity* activity = running_activities_.Erase(a_activity.rjnr());
+    if ( nullptr != activity ) {
+        const uint64_t rjnr  = activity->sequence().rjnr();
+        SequenceState* state = FindSequenceState(rjnr);
+        // ... forget it as a running activity of it's sequence ...
+        if ( nullptr != state ) {
+            state->running_.erase(activity->rjnr());
+        }
+        // ... forget sequence entry, only if it's pointing to this activity ...
+        if ( activity == running_sequences_.Find(rjnr) ) {
+            running_sequences_.Erase(rjnr);
+            // ... running a parallel group, a 'map' step or hedged? point it to another running activity of this sequence ...
+            if ( nullptr != state && ( nullptr != state->group_ || nullptr != state->map_ || hedges_.end() != hedges_.find(activity->rjnr()) ) ) {
+                sequencer::Activity* other = ( false == state->running_.empty() ? running_activities_.Find(*state->running_.begin()) : nullptr );
+                // ... no other running activity? 'map' step parent, if any, stays indexed until step returns ...
+                if ( nullptr == other && nullptr != state->map_ ) {
+                    other = state->map_->parent_.get();
+                }
+                if ( nullptr != other ) {
+                    running_sequences_.Insert(rjnr, other);
+                }
+            }
+        }
+        // ... nothing else pending? forget sequence state ...
+        TrimSequenceState(rjnr);
+        delete activity;
     }
-    
-    // ... log ...
-    LogStats();
 }
 
 /**
@@ -1544,37 +3736,174 @@ void casper::job::Sequencer::OnActivityTimeout (const std::string& a_rcid)
 {
     CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
     
+    const uint64_t rjnr = RCID2RJNR(a_rcid);
+    
     // ... activity still 'running'?
-    const auto it = running_activities_.find(a_rcid);
-    if ( running_activities_.end() == it ) {
+    sequencer::Activity* activity = running_activities_.Find(rjnr);
+    if ( nullptr == activity ) {
         // ... not running, we're done ...
         return;
     }
+    // ... hedged? other attempt is still running, let it return ...
+    const auto hedge = hedges_.find(rjnr);
+    if ( hedges_.end() != hedge ) {
+        const uint64_t peer = hedge->second;
+        // ... log ...
+        SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, (*activity), CC_JOB_LOG_STEP_STEP,
+                               "Attempt timed-out after " UINT32_FMT " second(s), waiting for other attempt", activity->ttr()
+        );
+        metrics_.Count(activity->rcnm(), sequencer::Metrics::Counter::TimedOut);
+        // ... cancel it, while still paired, so sequence keeps pointing to a running attempt ...
+        CancelActivity(*activity, Json::Value::null);
+        hedges_.erase(rjnr);
+        hedges_.erase(peer);
+        return;
+    }
     // ... mark as timed-out ...
-    it->second->SetStatus(sequencer::Status::Failed);
+    activity->SetStatus(sequencer::Status::Failed);
+    metrics_.Count(activity->rcnm(), sequencer::Metrics::Counter::TimedOut);
 
     // ... log ...
-    SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, (*it->second), CC_JOB_LOG_STEP_STEP,
-                           "Timed-out after " UINT32_FMT " second(s)", it->second->ttr()
+    SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, (*activity), CC_JOB_LOG_STEP_STEP,
+                           "Timed-out after " UINT32_FMT " second(s)", activity->ttr()
     );
         
     Json::Value response;
     (void)SetTimeoutResponse(/* a_payload */ Json::Value::null, response);
 
     // ... signal activity 'failed' ...
-    ActivityReturned(SEQUENCER_TRACK_CALL(it->second->sequence().bjid(), "ACTIVITY TIMEOUT"),
-                     *it->second, &response
+    ActivityReturned(SEQUENCER_TRACK_CALL(activity->sequence().bjid(), "ACTIVITY TIMEOUT"),
+                     *activity, &response
     );
     
     // ... debug only: ensure activity was untracked ...
     CC_IF_DEBUG({
-        CC_ASSERT(running_activities_.end() == running_activities_.find(a_rcid));
+        CC_ASSERT(nullptr == running_activities_.Find(rjnr) || retries_.end() != retries_.find(rjnr));
     });
+}
+
+/**
+ * @brief Callback to execute when a hedged activity did not return in time, another attempt is launched.
+ *
+ * @param a_id Callback id, 'hedge:' + activity REDIS channel id.
+ */
+void casper::job::Sequencer::OnHedgeTimer (const std::string& a_id)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    const uint64_t rjnr = RCID2RJNR(a_id);
+    
+    // ... activity still 'running', not hedged yet and not waiting to be retried?
+    const sequencer::Activity* activity = running_activities_.Find(rjnr);
+    if ( nullptr == activity || hedges_.end() != hedges_.find(rjnr) || retries_.end() != retries_.find(rjnr) ) {
+        return;
+    }
+    
+    // ... another attempt of the same activity, with a new REDIS id and channel ...
+    sequencer::Activity hedge = sequencer::Activity(*activity);
+    std::string         error;
+    
+    if ( true == LaunchAttempt(hedge, /* a_peer */ rjnr, error) ) {
+        // ... log ...
+        SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, hedge, CC_JOB_LOG_STEP_STEP,
+                               "Hedged with attempt #" SIZET_FMT ", REDIS channel ID %s", hedge.attempt(), hedge.rcid().c_str());
+        metrics_.Count(hedge.rcnm(), sequencer::Metrics::Counter::Hedged);
+        return;
+    }
+    
+    // ... log ...
+    SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_ERR, hedge, CC_JOB_LOG_STEP_ERROR,
+                           "An error occurred while hedging activity ~ " CC_JOB_LOG_COLOR(RED) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
+                           error.c_str()
+    );
+}
+
+/**
+ * @brief Callback to execute when a failed activity backoff delay expired, another attempt is launched.
+ *
+ * @param a_id Callback id, 'retry:' + activity REDIS channel id.
+ */
+void casper::job::Sequencer::OnRetryTimer (const std::string& a_id)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    
+    const uint64_t rjnr = RCID2RJNR(a_id);
+    
+    // ... still waiting to be retried?
+    const auto retry = retries_.find(rjnr);
+    if ( retries_.end() == retry ) {
+        return;
+    }
+    const Json::Value response = std::move(retry->second);
+    retries_.erase(retry);
+    
+    // ... still 'running' ( not cancelled meanwhile )?
+    const sequencer::Activity* activity = running_activities_.Find(rjnr);
+    if ( nullptr == activity ) {
+        return;
+    }
+    
+    // ... keep previous attempt, once untracked it's relased and it's reference is no longer válid ...
+    const sequencer::Activity previous = sequencer::Activity(*activity);
+    UntrackActivity(*activity); // ... ⚠️ from now on activity is NOT valid ! ⚠️ ...
+    
+    // ... another attempt of the same activity, with a new REDIS id and channel ...
+    sequencer::Activity attempt = sequencer::Activity(previous);
+    std::string         error;
+    
+    attempt.SetStatus(sequencer::Status::Pending);
+    if ( true == LaunchAttempt(attempt, /* a_peer */ 0, error) ) {
+        // ... log ...
+        SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, attempt, CC_JOB_LOG_STEP_STEP,
+                               "Retried with attempt #" SIZET_FMT ", REDIS channel ID %s", attempt.attempt(), attempt.rcid().c_str());
+        return;
+    }
     
     // ... log ...
+    SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_ERR, previous, CC_JOB_LOG_STEP_ERROR,
+                           "An error occurred while retrying activity ~ " CC_JOB_LOG_COLOR(RED) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
+                           error.c_str()
+    );
+    
+    // ... previous attempt response is final ( it's no longer tracked, so it won't be retried again ) ...
+    ActivityReturned(SEQUENCER_TRACK_CALL(previous.sequence().bjid(), "ACTIVITY RETRY"),
+                     previous, &response
+    );
+}
+
+/**
+ * @brief Callback to execute periodically to log statistics.
+ *
+ * @param a_id Callback id.
+ */
+void casper::job::Sequencer::OnStatsTimer (const std::string& /* a_id */)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    // ... log and reset histograms ...
     LogStats();
 }
 
+/**
+ * @brief Callback to execute periodically to write prometheus metrics file.
+ *
+ * @param a_id Callback id.
+ */
+void casper::job::Sequencer::OnMetricsTimer (const std::string& /* a_id */)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    // ... collect gauges ...
+    const sequencer::Metrics::Gauges gauges = {
+        /* running_sequences_  */ running_sequences_.size(),
+        /* running_activities_ */ running_activities_.size(),
+        /* queue_depth_        */ messages_.size() + overflow_size_.load()
+    };
+    // ... write file ...
+    std::string error;
+    if ( false == metrics_.Write(metrics_uri_, gauges, error) ) {
+        owner_log_callback_(tube_.c_str(), "METRICS", error);
+    }
+}
+
 #ifdef __APPLE__
 #pragma mark -
 #endif
@@ -1595,6 +3924,29 @@ void casper::job::Sequencer::FinalizeJob (const sequencer::Sequence& a_sequence,
     //
     CC_WARNING_TODO("CJS: global broadcast job status");
     
+    // ... forget speculative reservation ( if any ), it's id is just skipped, and whatever else is no longer pending ...
+    SequenceState* state = FindSequenceState(a_sequence.rjnr());
+    if ( nullptr != state ) {
+        state->reservation_.reset();
+        state->branch_.reset();
+        state->relay_.reset();
+        TrimSequenceState(a_sequence.rjnr());
+    }
+    
+    // ... idempotent sequence? attached jobs get the same response ( even if cancelled ), a completed one is kept for a while ...
+    const auto coalesced = coalesced_.find(a_sequence.rjnr());
+    if ( coalesced_.end() != coalesced ) {
+        const Coalesced entry = std::move(coalesced->second);
+        coalesced_.erase(coalesced);
+        idempotency_keys_.erase(entry.key_);
+        if ( true == a_response["status"].isString() && 0 == a_response["status"].asString().compare("completed") ) {
+            completed_.Put(tube_, entry.key_, IdempotencyDigest(entry.identity_), a_response);
+        }
+        for ( const auto& attached : entry.attached_ ) {
+            FinalizeJob(*attached, a_response);
+        }
+    }
+    
     // ... publish result ...
     Finished(/* a_id               */ a_sequence.bjid(),
              /* a_channel          */ a_sequence.rcid(),
@@ -1637,49 +3989,170 @@ void casper::job::Sequencer::OnJobsSignalReceived (const uint64_t& a_id, const s
         return;
     }
     
-    ScheduleCallbackOnLooperThread(/* a_id */ MakeID("sequencer-jobs-signals-callback", std::to_string(a_id)),
-        /* a_callback */
-       [this, a_id, a_status, a_message](const std::string& /* a_id */) {
-    
-            CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    // ... hand it over to looper thread ...
+    PostMessage({ /* type_ */ MessageType::Signal, /* id_ */ a_id, /* channel_ */ "", /* data_ */ a_status, /* object_ */ a_message });
+}
 
-            //
-            // Process cancellation message.
-            //
-            const casper::job::sequencer::Tracking tracking = SEQUENCER_TRACK_CALL(a_id, "JOBS SIGNALS MESSAGE RECEIVED");
+/**
+ * @brief Process a 'cancellation' signal.
+ *
+ * @param a_id      Sequence REDIS job number.
+ * @param a_message Signal message.
+ */
+void casper::job::Sequencer::ProcessJobsSignal (const uint64_t& a_id, const Json::Value& a_message)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+
+    //
+    // Process cancellation message.
+    //
+    const casper::job::sequencer::Tracking tracking = SEQUENCER_TRACK_CALL(a_id, "JOBS SIGNALS MESSAGE RECEIVED");
+
+    try {
         
-            try {
-                
-                Json::Value response;
-                
-                // ... prepare response ...
-                (void)SetCancelledResponse(/* a_payload*/ a_message, /* o_response */ response);
-
-                //
-                // ⚠️ Since we're only running one activity at a time for a specific sequence,
-                //    we can stop the search at the first activity that belongs to the sequence.
-                //
-                for ( auto it : running_activities_ ) {
-                    // ... found?
-                    if ( it.second->sequence().rjnr() == a_id) {
-                        // .. copy sequence info ...
-                        const sequencer::Sequence sequence = it.second->sequence();
-                        // ... cancel ...
-                        CancelSequence(*it.second, response);
-                        // ... finish job ...
-                        FinalizeJob(sequence, response);
-                        // ... and we're done ...
-                        break;
-                    }
+        Json::Value response;
+        
+        // ... prepare response ...
+        (void)SetCancelledResponse(/* a_payload*/ a_message, /* o_response */ response);
+
+        //
+        // ⚠️ The sequence index points to one of the sequence running activities,
+        //    when running a parallel group the others are cancelled by CancelSequence.
+        //
+        sequencer::Activity* activity = running_sequences_.Find(a_id);
+        if ( nullptr != activity ) {
+            // .. keep sequence info ...
+            const sequencer::SharedSequence sequence = activity->shared_sequence();
+            // ... cancel ...
+            CancelSequence(*activity, response);
+            // ... finish job, jobs attached to it ( if any ) are finished with the same 'cancelled' response ...
+            FinalizeJob(*sequence, response);
+        } else {
+            // ... attached to an identical in-flight sequence? just detach it ...
+            for ( auto& coalesced : coalesced_ ) {
+                auto& attached = coalesced.second.attached_;
+                const auto it = std::find_if(attached.begin(), attached.end(), [a_id] (const sequencer::SharedSequence& a_sequence) {
+                    return a_id == a_sequence->rjnr();
+                });
+                if ( attached.end() != it ) {
+                    const sequencer::SharedSequence sequence = *it;
+                    attached.erase(it);
+                    FinalizeJob(*sequence, response);
+                    break;
                 }
-                                
-            } catch (const ::cc::Exception& a_cc_exception) {
-                // ... log error ...
-                SEQUENCER_LOG_JOB(CC_JOB_LOG_LEVEL_ERR, tracking.bjid_, CC_JOB_LOG_STEP_ERROR, "%s", a_cc_exception.what());
             }
+        }
+                        
+    } catch (const ::cc::Exception& a_cc_exception) {
+        // ... log error ...
+        SEQUENCER_LOG_JOB(CC_JOB_LOG_LEVEL_ERR, tracking.bjid_, CC_JOB_LOG_STEP_ERROR, "%s", a_cc_exception.what());
+    }
+}
+
+/**
+ * @brief Hand-off a message from MAIN thread to looper thread.
+ *
+ * @param a_message Message to move into queue.
+ */
+void casper::job::Sequencer::PostMessage (casper::job::Sequencer::Message&& a_message)
+{
+    // ... queue it, unless overflowing ( ordering must be kept ) ...
+    if ( 0 != overflow_size_.load() || false == messages_.Push(std::move(a_message)) ) {
+        //
+        // ⚠️ Ring is full, append to overflow queue - drained by the same callback, after the ring.
+        //
+        std::lock_guard<std::mutex> lock(overflow_mutex_);
+        overflow_.push_back(std::move(a_message));
+        overflow_size_.store(overflow_.size());
+    }
+    // ... only one pending drain callback is needed ...
+    if ( false == messages_scheduled_.exchange(true) ) {
+        ScheduleCallbackOnLooperThread(/* a_id       */ sk_messages_callback_id_,
+                                       /* a_callback */ std::bind(&casper::job::Sequencer::OnMessagesPosted, this, std::placeholders::_1)
+        );
+    }
+}
 
+/**
+ * @brief Called on looper thread to drain all posted messages.
+ *
+ * @param a_id Callback id.
+ */
+void casper::job::Sequencer::OnMessagesPosted (const std::string& /* a_id */)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    // ... activities launched while draining are pushed to beanstalkd all at once ...
+    pushes_deferred_ = true;
+    // ... drain ...
+    Message             message;
+    std::deque<Message> overflow;
+    try {
+        while ( true ) {
+            // ... ring first, overflow messages are always newer ...
+            while ( true == messages_.Pop(message) ) {
+                ProcessMessage(message);
+            }
+            {
+                std::lock_guard<std::mutex> lock(overflow_mutex_);
+                overflow.swap(overflow_);
+                overflow_size_.store(0);
+            }
+            while ( false == overflow.empty() ) {
+                message = std::move(overflow.front());
+                overflow.pop_front();
+                ProcessMessage(message);
+            }
+            //
+            // ⚠️ Flag is only cleared after draining, so no drain is scheduled while messages are being processed;
+            //    re-check after clearing it: a message posted meanwhile either scheduled a new drain or it's ours.
+            //
+            messages_scheduled_.store(false);
+            if ( 0 == messages_.size() && 0 == overflow_size_.load() ) {
+                break;
+            }
+            if ( true == messages_scheduled_.exchange(true) ) {
+                break;
+            }
         }
-    );
+    } catch (...) {
+        // ... keep not processed overflow messages, in order, for next drain ...
+        if ( false == overflow.empty() ) {
+            std::lock_guard<std::mutex> lock(overflow_mutex_);
+            overflow_.insert(overflow_.begin(), std::make_move_iterator(overflow.begin()), std::make_move_iterator(overflow.end()));
+            overflow_size_.store(overflow_.size());
+        }
+        // ... next posted message schedules a new drain ...
+        messages_scheduled_.store(false);
+        pushes_deferred_ = false;
+        FlushActivityPushes();
+        throw;
+    }
+    pushes_deferred_ = false;
+    // ... push all activities launched while draining ...
+    FlushActivityPushes();
+}
+
+/**
+ * @brief Dispatch a message posted from MAIN thread.
+ *
+ * @param a_message Message to process.
+ */
+void casper::job::Sequencer::ProcessMessage (const casper::job::Sequencer::Message& a_message)
+{
+    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    switch (a_message.type_) {
+        case MessageType::Activity:
+            ProcessActivityMessage(a_message.channel_, a_message.data_);
+            break;
+        case MessageType::Signal:
+            ProcessJobsSignal(a_message.id_, a_message.object_);
+            break;
+        case MessageType::Reservation:
+            ProcessReservation(a_message.id_, a_message.object_);
+            break;
+        default:
+            break;
+    }
 }
 
 #ifdef __APPLE__
@@ -1696,11 +4169,12 @@ void casper::job::Sequencer::OnJobsSignalReceived (const uint64_t& a_id, const s
  */
 void casper::job::Sequencer::ExecuteQueryAndWait (const casper::job::sequencer::Tracking& a_tracking,
                                                   const std::string& a_query, const ExecStatusType& a_expected,
-                                                  const std::function<void(const Json::Value& a_value)> a_success_callback,
+                                                  const std::function<void(Json::Value& a_value)> a_success_callback,
                                                   const std::function<void(const ev::Exception& a_exception)> a_failure_callback)
 {
     CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
         
+    const uint64_t          start = sequencer::Stats::Now();
     osal::ConditionVariable cv;
     cc::Exception*          ex    = nullptr;
     Json::Value*            table = nullptr;
@@ -1740,6 +4214,8 @@ void casper::job::Sequencer::ExecuteQueryAndWait (const casper::job::sequencer::
     // ... WAIT ...
     cv.Wait();
     
+    metrics_.Observe(sequencer::Metrics::Latency::PostgreSQL, sequencer::Stats::Now() - start);
+    
     std::string error_msg = "";
     
     try {
@@ -1755,7 +4231,9 @@ void casper::job::Sequencer::ExecuteQueryAndWait (const casper::job::sequencer::
         } else {
             // ... notify ...
             if ( nullptr != a_success_callback ) {
-                a_success_callback(( nullptr != table ? *table : Json::Value::null ));
+                // ... callback owns rows, it can move them out ...
+                Json::Value empty = Json::Value::null;
+                a_success_callback(( nullptr != table ? *table : empty ));
             }
         }
         
@@ -1830,40 +4308,22 @@ const ::ev::postgresql::Value* casper::job::Sequencer::EnsurePostgreSQLValue (co
 */
 const Json::Value& casper::job::Sequencer::MSG2JSON (const std::string& a_value, Json::Value& o_value)
 {
-    CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+    // ... stateless, safe to call from any thread ...
     // ... invalid, primitive or JSON protocol?
     if ( 0 == a_value.length() ) {
         throw ::cc::Exception("Invalid message: '%s' - no data to process!", a_value.c_str());
-    } else if ( '*' == a_value.c_str()[0] ) {
-        // expecting: *<status-code-int-value>,<content-type-length-in-bytes>,<content-type-string-value>,<body-length-bytes>,<body>
-        const char* const c_str = a_value.c_str();
-        struct P { const char* start_; const char* end_; unsigned unsigned_value_; };
-        P p [3];
-        p[0] = { c_str + 1, strchr(c_str + 1, ','), 0 }; /* status code @ unsigned_value            */
-        p[1] = { nullptr  , nullptr               , 0 }; /* content-type - IGNORED - EXPECTING JSON */
-        p[2] = { nullptr  , nullptr               , 0 }; /* body         - IGNORED                  */
-        // ... read status code ....
-        if ( nullptr == p[0].end_ || 1 != sscanf(p[0].start_, "%u", &p[0].unsigned_value_) ) {
-            throw ::cc::Exception("Invalid message: unable to read '%s' from primitive protocol message!", "status code");
-        } else {
-            // ... read all other components ...
-            for ( size_t idx = 1 ; idx < ( sizeof(p) / sizeof(p[0]) ) ; ++idx ) {
-                if ( 1 != sscanf(p[idx-1].end_ + sizeof(char), "%u", &p[idx].unsigned_value_) ) {
-                    throw ::cc::Exception("Invalid message: unable to read field #'" SIZET_FMT "' from primitive protocol message!", idx);
-                }
-                p[idx].start_ = strchr(p[idx-1].end_ + sizeof(char), ',');
-                if ( nullptr == p[idx].start_ ) {
-                    throw ::cc::Exception("Invalid message: invalid field #'" SIZET_FMT "' value read from primitive protocol message!", idx);
-                }
-                p[idx].start_ += sizeof(char);
-                p[idx].end_    = p[idx].start_ + p[idx].unsigned_value_;
-            }
-            // ... good to go ...
-            ParseJSON(std::string(p[2].start_, p[2].unsigned_value_), o_value);
-        }
-    } else {
-        // ... JSON is expected ...
-        ParseJSON(a_value, o_value);
+    }
+    // ... JSON is expected ...
+    const char* body   = a_value.data();
+    size_t      length = a_value.length();
+    if ( '*' == body[0] ) {
+        // ... primitive protocol, body is a slice of a_value ...
+        sequencer::Protocol::Unwrap(a_value, body, length);
+    }
+    // ... parse it in place, no intermediate copies ...
+    Json::Reader reader;
+    if ( false == reader.parse(body, body + length, o_value, /* a_collect_comments */ false) ) {
+        throw ::cc::Exception("Invalid message: unable to parse JSON body - %s!", reader.getFormattedErrorMessages().c_str());
     }
     // ... done ...
     return o_value;
@@ -1875,28 +4335,25 @@ const Json::Value& casper::job::Sequencer::MSG2JSON (const std::string& a_value,
  * @param a_tracking     Call tracking purposes.
  * @param a_activity     Activity info.
  * @param o_abort_result Abort expression result as JSON object, Json::value::null of none.
+ * @param a_items_expr   'map' step items expression, empty if none.
+ * @param o_items        'map' step items expression result as JSON array, only set when not aborted nor skipped.
+ * @param io_branch      'skip_if' and 'next_if' expressions in, their evaluation results out, only set when not aborted.
  */
 void casper::job::Sequencer::PatchActivity (const casper::job::sequencer::Tracking& a_tracking,
-                                            casper::job::sequencer::Activity& a_activity, Json::Value& o_abort_result)
+                                            casper::job::sequencer::Activity& a_activity, Json::Value& o_abort_result,
+                                            const std::string& a_items_expr, Json::Value& o_items, casper::job::Sequencer::Branch& io_branch)
 {
     CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
         
     // ... load previous activities responses to V8 engine ..
-    std::stringstream ss; ss.clear(); ss.str("");
-    
-    // ... js.get_activities_responses (sid INTEGER) ...
-    ss << "SELECT * FROM js.get_activities_responses(";
-    ss <<  a_activity.sequence().did();
-    ss << ");";
-    
-    
-    Json::Value object = Json::Value::null;
+    Json::Value    object          = Json::Value::null;
+    const uint64_t responses_start = sequencer::Stats::Now();
     
     // ... register @ DB ...
     ExecuteQueryAndWait(/* a_tracking         */ SEQUENCER_TRACK_CALL(a_activity.sequence().bjid(), "GETTING ACTIVITIES RESPONSES"),
-                        /* a_query            */ ss.str(), /* a_expected */ ExecStatusType::PGRES_TUPLES_OK,
+                        /* a_query            */ sequencer::SQL::GetActivitiesResponses(a_activity.sequence()), /* a_expected */ ExecStatusType::PGRES_TUPLES_OK,
                         /* a_success_callback */
-                        [&object] (const Json::Value& a_value) {
+                        [&object] (Json::Value& a_value) {
         
                             //
                             // EXPECTING:
@@ -1914,24 +4371,28 @@ void casper::job::Sequencer::PatchActivity (const casper::job::sequencer::Tracki
                                 return;
                             }
         
-                            const Json::Value& first = a_value[0];
+                            Json::Value& first = a_value[0];
                             if ( true == first["id"].isNull() || false == first.isMember("sequence") ) {
                                 return;
                             }
         
-                            object              = first["sequence"];
-                            object["responses"] = Json::Value(Json::ValueType::arrayValue);
-                            object["responses"].append(first["response"]);
+                            // ... rows are no longer needed, move them ...
+                            object.swap(first["sequence"]);
+                            Json::Value& responses = object["responses"];
+                            responses = Json::Value(Json::ValueType::arrayValue);
+                            responses.append(Json::Value::null).swap(first["response"]);
                 
                             for ( Json::ArrayIndex idx = 1 ; idx < a_value.size() ; ++idx ) {
                                 if ( false == a_value[idx]["id"].isNull() && true == a_value[idx].isMember("sequence") ) {
-                                    object["responses"].append(a_value[idx]["response"]);
+                                    responses.append(Json::Value::null).swap(a_value[idx]["response"]);
                                 }
                             }
 
                         }
     );
     
+    stats_.Record(a_activity.rcnm(), sequencer::Stats::Stage::Responses, responses_start);
+    
     // ... data must be previously set on DB ...
     if ( true == object.isNull() ) {
         throw sequencer::Exception(a_tracking, /* a_code */ 500, "No data available for this activity ( from db )!");
@@ -1940,6 +4401,7 @@ void casper::job::Sequencer::PatchActivity (const casper::job::sequencer::Tracki
     //
     // V8 evaluation
     //
+    const uint64_t                patch_start = sequencer::Stats::Now();
     ::v8::Persistent<::v8::Value> data;
     
     Json::FastWriter ljfw; ljfw.omitEndingLineFeed();
@@ -1978,7 +4440,8 @@ void casper::job::Sequencer::PatchActivity (const casper::job::sequencer::Tracki
         throw sequencer::V8ExpressionEvaluationException(a_tracking, a_v8e);
     }
         
-    Json::Value payload = a_activity.payload();
+    // ... payload will be replaced by the patched one, move it out ...
+    Json::Value payload = a_activity.DetachPayload();
     
     // ... log ...
     SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_VBS, a_activity, CC_JOB_LOG_STEP_V8,
@@ -1987,45 +4450,24 @@ void casper::job::Sequencer::PatchActivity (const casper::job::sequencer::Tracki
     );
     
     // ... traverse JSON and evaluate 'String' fields ...
-    ::cc::v8::Value value;
-    script_->PatchObject(payload, [this, &a_tracking, &data, &value] (const std::string& a_expression) -> Json::Value {
-        // ... start as null ...
-        value.SetNull();
-        // ...
-        try {
-            script_->Evaluate(data, a_expression, value);
-        } catch (const ::cc::v8::Exception& a_v8e) {
-            throw sequencer::V8ExpressionEvaluationException(a_tracking, a_v8e);
-        }
-        // ...
-        switch(value.type()) {
-            case ::cc::v8::Value::Type::Int32:
-                return Json::Value(value.operator int());
-            case ::cc::v8::Value::Type::UInt32:
-                return Json::Value(value.operator unsigned int());
-            case ::cc::v8::Value::Type::Double:
-                return Json::Value(value.operator double());
-            case ::cc::v8::Value::Type::String:
-                return Json::Value(value.AsString());
-            case ::cc::v8::Value::Type::Boolean:
-                return Json::Value(value.operator const bool());
-            case ::cc::v8::Value::Type::Object:
-                return value.operator const Json::Value &();
-            case ::cc::v8::Value::Type::Date:
-            case ::cc::v8::Value::Type::Undefined:
-            case ::cc::v8::Value::Type::Null:
-                return Json::Value(Json::Value::null);
-        }
-    });
+    try {
+        script_->Patch(data, payload);
+    } catch (const ::cc::v8::Exception& a_v8e) {
+        throw sequencer::V8ExpressionEvaluationException(a_tracking, a_v8e);
+    }
     
+    // ... set patched payload as activity new payload ....
+    a_activity.SetPayload(std::move(payload));
+    // ... and serialize it only once, it will be used to log, register and push it ...
+    a_activity.SerializePayload();
+
     // ... log ...
     SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, a_activity, CC_JOB_LOG_STEP_V8,
                            "Payload patched: " CC_JOB_LOG_COLOR(LIGHT_CYAN) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
-                           ljfw.write(payload).c_str()
+                           a_activity.payload_str().c_str()
     );
 
-    // ... set patched payload as activity new payload ....
-    a_activity.SetPayload(payload);
+    ::cc::v8::Value value;
 
     // ... check abort condition?
     if ( 0 != a_activity.abort_expr().length() ) {
@@ -2067,6 +4509,90 @@ void casper::job::Sequencer::PatchActivity (const casper::job::sequencer::Tracki
                                           value.type_cstr(), "Object");
         }
     }
+    
+    // ... NOT aborted? check skip condition ...
+    if ( 0 != io_branch.skip_if_.length() && true == o_abort_result.isNull() ) {
+        // ... log ...
+        SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, a_activity, CC_JOB_LOG_STEP_STEP,
+                               "Evaluating skip expression " CC_JOB_LOG_COLOR(WHITE) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
+                               io_branch.skip_if_.c_str()
+        );
+        // ... evaluate expression ...
+        script_->Evaluate(data, io_branch.skip_if_, value);
+        switch(value.type()) {
+            case ::cc::v8::Value::Type::Boolean:
+                io_branch.skip_ = value.operator const bool();
+                break;
+            case ::cc::v8::Value::Type::Undefined:
+            case ::cc::v8::Value::Type::Null:
+                io_branch.skip_ = false;
+                break;
+            default:
+                throw ::cc::v8::Exception("Unsupported V8 expression evaluation result type '%s' expected '%s'!",
+                                          value.type_cstr(), "Boolean");
+        }
+    }
+    
+    // ... NOT aborted nor skipped? check branch condition ...
+    if ( 0 != io_branch.next_if_.length() && true == o_abort_result.isNull() && false == io_branch.skip_ ) {
+        // ... log ...
+        SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, a_activity, CC_JOB_LOG_STEP_STEP,
+                               "Evaluating branch expression " CC_JOB_LOG_COLOR(WHITE) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
+                               io_branch.next_if_.c_str()
+        );
+        // ... evaluate expression, a job name or index to branch to ...
+        script_->Evaluate(data, io_branch.next_if_, value);
+        switch(value.type()) {
+            case ::cc::v8::Value::Type::String:
+                io_branch.next_ = Json::Value(value.AsString());
+                break;
+            case ::cc::v8::Value::Type::Int32:
+                io_branch.next_ = Json::Value(value.operator int());
+                break;
+            case ::cc::v8::Value::Type::UInt32:
+                io_branch.next_ = Json::Value(value.operator unsigned int());
+                break;
+            case ::cc::v8::Value::Type::Boolean:
+                if ( true == value.operator const bool() ) {
+                    throw ::cc::v8::Exception("Unsupported V8 expression evaluation result '%s' expected '%s'!",
+                                              "true", "String, Integer, false or null");
+                }
+                io_branch.next_ = Json::Value::null;
+                break;
+            case ::cc::v8::Value::Type::Undefined:
+            case ::cc::v8::Value::Type::Null:
+                io_branch.next_ = Json::Value::null;
+                break;
+            default:
+                throw ::cc::v8::Exception("Unsupported V8 expression evaluation result type '%s' expected '%s'!",
+                                          value.type_cstr(), "String, Integer, false or null");
+        }
+        // ... branching skips this activity ...
+        io_branch.skip_ = ( false == io_branch.next_.isNull() );
+    }
+    
+    // ... 'map' step NOT aborted nor skipped? evaluate items expression ...
+    if ( 0 != a_items_expr.length() && true == o_abort_result.isNull() && false == io_branch.skip_ ) {
+        // ... log ...
+        SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, a_activity, CC_JOB_LOG_STEP_STEP,
+                               "Evaluating map items expression " CC_JOB_LOG_COLOR(WHITE) "%s" CC_LOGS_LOGGER_RESET_ATTRS,
+                               a_items_expr.c_str()
+        );
+        // ... evaluate expression ...
+        script_->Evaluate(data, a_items_expr, value);
+        if ( ::cc::v8::Value::Type::Object != value.type() || false == value.operator const Json::Value &().isArray() ) {
+            throw ::cc::v8::Exception("Unsupported V8 expression evaluation result type '%s' expected '%s'!",
+                                      value.type_cstr(), "Array");
+        }
+        o_items = value.operator const Json::Value &();
+        // ... log ...
+        SEQUENCER_LOG_ACTIVITY(CC_JOB_LOG_LEVEL_INF, a_activity, CC_JOB_LOG_STEP_STEP,
+                               "Map items expression result is an array of %u item(s)",
+                               static_cast<unsigned>(o_items.size())
+        );
+    }
+    
+    metrics_.Observe(sequencer::Metrics::Latency::V8, stats_.Record(a_activity.rcnm(), sequencer::Stats::Stage::Patch, patch_start));
 }
 
 // MARK: -
@@ -2119,13 +4645,11 @@ void casper::job::Sequencer::ValidateSequenceTimeouts (const sequencer::Tracking
     Json::UInt seq_acts_validity_sum = 0;
 
     // ... ensure mandatory fields ...
-    const auto seq_ttr       = GetJSONObject(a_payload, "ttr"      , Json::ValueType::uintValue  , /* a_default */ 0, seq_iomkmp).asUInt();
-    const auto seq_validity  = GetJSONObject(a_payload, "validity" , Json::ValueType::uintValue  , /* a_default */ 0, seq_iomkmp).asUInt();
-    const auto seq_acts      = GetJSONObject(a_payload, "jobs"     , Json::ValueType::arrayValue , /* a_default */ nullptr, seq_iomkmp);
-    for ( Json::ArrayIndex idx = 0 ; idx < seq_acts.size() ; ++idx ) {
-        seq_acts_ttr_sum      += GetJSONObject(seq_acts[idx], "ttr"     , Json::ValueType::uintValue, &activity_config_.ttr_).asUInt();
-        seq_acts_validity_sum += GetJSONObject(seq_acts[idx], "validity", Json::ValueType::uintValue, &activity_config_.validity_).asUInt();
-    }
+    const auto  seq_ttr       = GetJSONObject(a_payload, "ttr"      , Json::ValueType::uintValue  , /* a_default */ 0, seq_iomkmp).asUInt();
+    const auto  seq_validity  = GetJSONObject(a_payload, "validity" , Json::ValueType::uintValue  , /* a_default */ 0, seq_iomkmp).asUInt();
+    const auto& seq_acts      = GetJSONObject(a_payload, "jobs"     , Json::ValueType::arrayValue , /* a_default */ nullptr, seq_iomkmp);
+
+    SumSequenceTimeouts(a_tracking, seq_acts, activity_config_.ttr_.asUInt(), activity_config_.validity_.asUInt(), map_concurrency_, seq_acts_ttr_sum, seq_acts_validity_sum);
     
     const Json::UInt seq_acts_timeout_sum = ( seq_acts_ttr_sum + seq_acts_validity_sum );
     // TODO: unused ? const Json::UInt seq_job_timeout_sum  = ( seq_ttr + seq_validity );
@@ -2204,6 +4728,92 @@ void casper::job::Sequencer::ValidateSequenceTimeouts (const sequencer::Tracking
     }
 }
 
+/**
+ * @brief Sum the 'ttr' and 'validity' values of a sequence activities.
+ *
+ * @param a_tracking Call tracking purposes.
+ * @param a_jobs     Sequence 'jobs' payload, JSON array.
+ * @param a_ttr      Default activity 'ttr', used when not provided.
+ * @param a_validity        Default activity 'validity', used when not provided.
+ * @param a_map_concurrency Default maximum number of running items of a 'map' step.
+ * @param o_ttr             Sum of activities 'ttr' values.
+ * @param o_validity        Sum of activities 'validity' values.
+ *
+ * A 'map' step runs it's items in ceil(max_items / concurrency) waves, each one counts as a full activity.
+ * A 'retry' policy counts 'attempts' times the activity plus the ( capped ) backoff between them and
+ * a 'hedge' counts the extra attempt, launched 'after' ms ( up to 'ttr' when the tube's p95 is used ).
+ */
+void casper::job::Sequencer::SumSequenceTimeouts (const sequencer::Tracking& a_tracking, const Json::Value& a_jobs, const Json::UInt a_ttr, const Json::UInt a_validity,
+                                                  const size_t a_map_concurrency, Json::UInt& o_ttr, Json::UInt& o_validity)
+{
+    const auto get = [&a_tracking] (const Json::Value& a_job, const char* const a_name, const Json::UInt a_default) -> Json::UInt {
+        const Json::Value& value = a_job[a_name];
+        if ( true == value.isNull() ) {
+            return a_default;
+        }
+        if ( false == value.isUInt() ) {
+            throw sequencer::BadRequestException(a_tracking, ( std::string("Invalid activity '") + a_name + "' value!" ).c_str());
+        }
+        return value.asUInt();
+    };
+
+    o_ttr      = 0;
+    o_validity = 0;
+
+    Json::UInt group_ttr      = 0;
+    Json::UInt group_validity = 0;
+    for ( Json::ArrayIndex idx = 0 ; idx < a_jobs.size() ; ++idx ) {
+        Json::UInt ttr      = get(a_jobs[idx], "ttr"     , a_ttr);
+        Json::UInt validity = get(a_jobs[idx], "validity", a_validity);
+        // ... hedged? the extra attempt may still be running up to 'after' ms after the first one would have timed out ...
+        const Json::Value& hedge = a_jobs[idx]["hedge"];
+        if ( true == hedge.isObject() && ( true == hedge["after"].isNull() || 0 != get(hedge, "after", 0) ) ) {
+            const Json::UInt after = get(hedge, "after", 0);
+            ttr      += ( 0 == after ? ttr : std::min(ttr, ( after + 999 ) / 1000) );
+            validity += validity;
+        }
+        // ... 'map' step? without 'max_items' a single wave is accounted for ( and it's items are not retried ) ...
+        const Json::Value& map   = a_jobs[idx]["map"];
+        const Json::Value& retry = a_jobs[idx]["retry"];
+        if ( true == retry.isObject() && false == map.isObject() ) {
+            // ... same defaults as \link LaunchActivity \link ...
+            const Json::UInt attempts    = std::max(Json::UInt(1), get(retry, "attempts", 3));
+            const uint64_t   backoff     = static_cast<uint64_t>(get(retry, "backoff"    , 1000));
+            const uint64_t   max_backoff = static_cast<uint64_t>(get(retry, "max_backoff", 60000));
+            // ... worst case: every attempt times out and waits the full ( capped ) backoff before the next one ...
+            uint64_t waits = 0;
+            for ( Json::UInt attempt = 1 ; attempt < attempts ; ++attempt ) {
+                waits += std::min(backoff << std::min(attempt - 1, Json::UInt(31)), max_backoff);
+            }
+            ttr      = ( ttr * attempts ) + static_cast<Json::UInt>(( waits + 999 ) / 1000);
+            validity = ( validity * attempts );
+        }
+        if ( true == map.isObject() ) {
+            const Json::UInt concurrency = std::max(Json::UInt(1), get(map, "concurrency", static_cast<Json::UInt>(a_map_concurrency)));
+            const Json::UInt max_items   = get(map, "max_items", concurrency);
+            const Json::UInt waves       = std::max(Json::UInt(1), ( max_items + concurrency - 1 ) / concurrency);
+            ttr      *= waves;
+            validity *= waves;
+        }
+        size_t first = 0;
+        size_t count = 0;
+        if ( false == sequencer::Parallel::Get(a_jobs[idx], first, count) ) {
+            o_ttr      += ttr;
+            o_validity += validity;
+            continue;
+        }
+        // ... parallel group, activities run together so only the slowest one counts ...
+        group_ttr      = std::max(group_ttr, ttr);
+        group_validity = std::max(group_validity, validity);
+        if ( static_cast<size_t>(idx) + 1 == first + count ) {
+            o_ttr         += group_ttr;
+            o_validity    += group_validity;
+            group_ttr      = 0;
+            group_validity = 0;
+        }
+    }
+}
+
 /**
  * @brief Call to log some sequence info.
  *
@@ -32,6 +32,16 @@
 #include "casper/job/sequencer/config.h"
 #include "casper/job/sequencer/exception.h"
 #include "casper/job/sequencer/activity.h"
+#include "casper/job/sequencer/index.h"
+#include "casper/job/sequencer/ring.h"
+#include "casper/job/sequencer/logger.h"
+#include "casper/job/sequencer/stats.h"
+#include "casper/job/sequencer/metrics.h"
+#include "casper/job/sequencer/protocol.h"
+#include "casper/job/sequencer/sql.h"
+#include "casper/job/sequencer/parallel.h"
+#include "casper/job/sequencer/memo.h"
+#include "casper/job/sequencer/producer.h"
 
 #include "cc/v8/exception.h"
 
@@ -41,6 +51,14 @@
 
 #include "cc/easy/job/volatile.h"
 
+#include <atomic>
+#include <deque>
+#include <map>
+#include <memory> // std::shared_ptr
+#include <mutex>
+#include <set>
+#include <vector>
+
 namespace casper
 {
 
@@ -54,23 +72,47 @@ namespace casper
 #define SEQUENCER_LOG_KEY_SEQUENCE  "SEQUENCE"
 #define SEQUENCER_LOG_KEY_ACTIVITY  "ACTIVITY"
 
+// ... define CASPER_JOB_SEQUENCER_LOG_STRIP_VERBOSE ( release builds ) to compile out VBS and DBG levels ...
+#if defined(CASPER_JOB_SEQUENCER_LOG_STRIP_VERBOSE)
+    #define SEQUENCER_LOG_COMPILED(a_level) \
+        ( CC_JOB_LOG_LEVEL_VBS != ( a_level ) && CC_JOB_LOG_LEVEL_DBG != ( a_level ) )
+#else
+    #define SEQUENCER_LOG_COMPILED(a_level) true
+#endif
+
+// ... arguments are only evaluated if level is enabled ( they might be expensive e.g. JSON serialization ) ...
+#define SEQUENCER_LOG_ENABLED(a_level) \
+    ( SEQUENCER_LOG_COMPILED(a_level) && ( a_level ) <= log_level_ )
+
+// ... when binary logger is enabled, formatting is deferred to it's decoder ( a_format MUST be a literal ) ...
+#define SEQUENCER_LOG_EMIT(a_level, a_bjid, a_step, a_format, ...) \
+    do { \
+        if ( SEQUENCER_LOG_ENABLED(a_level) ) { \
+            if ( nullptr != logger_ ) { \
+                logger_->Log(a_level, a_bjid, a_step, a_format, __VA_ARGS__); \
+            } else { \
+                CC_JOB_LOG(a_level, a_bjid, a_format, __VA_ARGS__); \
+            } \
+        } \
+    } while(0)
+
 #define SEQUENCER_LOG_SEQUENCE(a_level, a_sequence, a_step, a_format, ...) \
-    CC_JOB_LOG(a_level, a_sequence.bjid(), \
-                CC_JOB_LOG_COLOR(LIGHT_BLUE) "%-8.8s" CC_LOGS_LOGGER_RESET_ATTRS ": %-8.8s, " a_format, \
-                SEQUENCER_LOG_KEY_SEQUENCE , a_step, __VA_ARGS__ \
-    );
+    SEQUENCER_LOG_EMIT(a_level, a_sequence.bjid(), a_step, \
+                       CC_JOB_LOG_COLOR(LIGHT_BLUE) "%-8.8s" CC_LOGS_LOGGER_RESET_ATTRS ": %-8.8s, " a_format, \
+                       SEQUENCER_LOG_KEY_SEQUENCE , a_step, __VA_ARGS__ \
+    )
 
 #define SEQUENCER_LOG_ACTIVITY(a_level, a_activity, a_step, a_format, ...) \
-    CC_JOB_LOG(a_level, a_activity.sequence().bjid(), \
-               CC_JOB_LOG_COLOR(WHITE) "%-8.8s" CC_LOGS_LOGGER_RESET_ATTRS ": %-8.8s, { " SIZET_FMT "/" SIZET_FMT " } " a_format, \
-               SEQUENCER_LOG_KEY_ACTIVITY, a_step, ( a_activity.index() + 1 ), a_activity.sequence().count(), __VA_ARGS__ \
-    );
+    SEQUENCER_LOG_EMIT(a_level, a_activity.sequence().bjid(), a_step, \
+                       CC_JOB_LOG_COLOR(WHITE) "%-8.8s" CC_LOGS_LOGGER_RESET_ATTRS ": %-8.8s, { " SIZET_FMT "/" SIZET_FMT " } " a_format, \
+                       SEQUENCER_LOG_KEY_ACTIVITY, a_step, ( a_activity.index() + 1 ), a_activity.sequence().count(), __VA_ARGS__ \
+    )
 
 #define SEQUENCER_LOG_JOB(a_level, a_bjid, a_step, a_format, ...) \
-    CC_JOB_LOG(a_level, a_bjid, \
-                CC_JOB_LOG_COLOR(MAGENTA) "%-8.8s" CC_LOGS_LOGGER_RESET_ATTRS ": %-8.8s, " a_format, \
-                SEQUENCER_LOG_KEY_JOB, a_step, __VA_ARGS__ \
-    );
+    SEQUENCER_LOG_EMIT(a_level, a_bjid, a_step, \
+                       CC_JOB_LOG_COLOR(MAGENTA) "%-8.8s" CC_LOGS_LOGGER_RESET_ATTRS ": %-8.8s, " a_format, \
+                       SEQUENCER_LOG_KEY_JOB, a_step, __VA_ARGS__ \
+    )
 
 #define SEQUENCER_LOG_CRITICAL_EXCEPTION(a_format, ...) \
     CC_JOB_LOG(CC_JOB_LOG_LEVEL_CRT, uint64_t(0), \
@@ -87,17 +129,149 @@ namespace casper
         private: // Static Const Data
             
             static const std::map<std::string, sequencer::Status> s_irj_teminal_status_map_;
+            static const char* const                              sk_messages_callback_id_;
+            static const char* const                              sk_stats_callback_id_;
+            static const char* const                              sk_metrics_callback_id_;
+
+        private: // Data Type(s)
+            
+            enum class MessageType : uint8_t {
+                NotSet = 0x00,
+                Activity,
+                Signal,
+                Reservation
+            };
+            
+            typedef struct {
+                MessageType type_;     //!< One of \link MessageType \link.
+                uint64_t    id_;       //!< Signal and Reservation only: sequence REDIS job number.
+                std::string channel_;  //!< Activity only: REDIS channel id.
+                std::string data_;     //!< Activity: REDIS message, Signal: status.
+                Json::Value object_;   //!< Signal: message, Reservation: reserved REDIS job number, 'queued' status already set ( null on failure ).
+            } Message;
+            
+            typedef struct {
+                std::string message_;    //!< Latest 'in-progress' message not relayed yet, empty if none.
+                uint64_t    relayed_at_; //!< Last relay, as returned by \link sequencer::Stats::Now \link.
+                bool        scheduled_;  //!< True when a flush callback is pending.
+            } ProgressRelay;
+            
+            typedef struct {
+                osal::ConditionVariable cv_;    //!< Woken up when relay is done.
+                std::string             error_; //!< Error message, empty on success.
+            } RelayTicket;
+            
+            typedef struct {
+                uint64_t    rjnr_;    //!< Activity RJNR ( REDIS job number ).
+                std::string channel_; //!< Sequence REDIS channel, ( forged ) reset message destination.
+                std::string key_;     //!< Sequence REDIS job key.
+                std::string message_; //!< ( forged ) reset message.
+                std::string error_;   //!< BEANSTALKD push error message, empty on success.
+                bool        started_; //!< True when relay was started.
+                RelayTicket ticket_;  //!< ( forged ) reset message relay ticket.
+            } PendingPush;
+            
+            typedef struct {
+                size_t                               first_;    //!< Index of the group first activity.
+                size_t                               count_;    //!< Number of activities in group.
+                size_t                               pending_;  //!< Number of activities not returned yet.
+                std::shared_ptr<sequencer::Activity> ended_;    //!< Returned activity that ended the sequence, nullptr if none.
+                Json::Value                          response_; //!< Sequence final response, only valid when ended_ is set.
+            } ParallelGroup;
+            
+            typedef struct {
+                std::shared_ptr<sequencer::Activity> parent_;      //!< 'map' activity, registered @ DB but never pushed.
+                Json::Value                          payload_;     //!< Patched payload, template of each item activity.
+                Json::Value                          items_;       //!< Items to map, as evaluated by \link PatchActivity \link.
+                int64_t                              expires_in_;  //!< Item REDIS job key validity, in seconds.
+                size_t                               concurrency_; //!< Maximum number of running items.
+                size_t                               next_;        //!< Index of next item to launch.
+                std::map<uint64_t, size_t>           running_;     //!< Item RJNR ( REDIS job number ) -> item index.
+                Json::Value                          results_;     //!< Items responses, in items order.
+                bool                                 failed_;      //!< True when an item did not complete, no more items are launched.
+                Json::Value                          failure_;     //!< First failed item response, only valid when failed_ is set.
+            } MapStep;
+            
+            typedef struct {
+                std::string skip_if_; //!< 'skip_if' V8 expression, empty if none.
+                std::string next_if_; //!< 'next_if' V8 expression, empty if none.
+                bool        skip_;    //!< True when activity must be skipped.
+                Json::Value next_;    //!< 'next_if' evaluation result, target job name or index, null if none.
+            } Branch;
+            
+            typedef struct {
+                uint64_t    id_;   //!< Reserved REDIS job number, 0 while being reserved.
+                std::string tube_; //!< Tube it was reserved for, REDIS job key is already set with 'queued' status.
+            } Reservation;
+            
+            typedef struct {
+                uint64_t                               key_;      //!< Idempotency key, as returned by \link IdempotencyKey \link.
+                std::string                            identity_; //!< Lead sequence identity, compared on a key hit.
+                std::vector<sequencer::SharedSequence> attached_; //!< Sequences of identical jobs attached to this one, they get the same final response.
+            } Coalesced;
+            
+            typedef struct {
+                std::set<uint64_t>             running_;     //!< Running activities RJNRs ( REDIS job numbers ), in sync with running_activities_.
+                std::unique_ptr<ParallelGroup> group_;       //!< Running parallel group, nullptr if none.
+                std::unique_ptr<MapStep>       map_;         //!< Running 'map' step, nullptr if none.
+                std::unique_ptr<size_t>        branch_;      //!< Next activity index, set by 'next_if', nullptr if none.
+                std::unique_ptr<ProgressRelay> relay_;       //!< Coalesced 'in-progress' messages, nullptr if none.
+                std::unique_ptr<Reservation>   reservation_; //!< REDIS job speculatively reserved for it's next activity, nullptr if none.
+            } SequenceState;
+
+        protected: // Const Data
+            
+            const size_t                                log_level_;          //!< Max. log level, higher levels are skipped before evaluating arguments - job logger's configured one, unless 'log_level' is set.
+
+        protected: // Data
+            
+            sequencer::Logger*                          logger_;             //!< Optional, asynchronous binary logger.
 
         private: // Data
 
             sequencer::Config                           sequence_config_;
             sequencer::Config                           activity_config_;
             
-            std::map<std::string, sequencer::Activity*> running_activities_; //!< RCID ( REDIS Channel ID ) -> Activity
+            sequencer::Index<sequencer::Activity>       running_activities_; //!< Activity RJNR ( REDIS job number ) -> Activity, owned.
+            sequencer::Index<sequencer::Activity>       running_sequences_;  //!< Sequence RJNR ( REDIS job number ) -> running Activity, NOT owned.
+            std::set<uint64_t>                          subscribed_;         //!< RJNRs ( REDIS job numbers ) of activities subscribed to their REDIS channel ( looper thread only ).
+            std::map<uint64_t, SequenceState>           sequences_;          //!< Sequence RJNR ( REDIS job number ) -> it's looper state, forgotten by \link ReleaseSequence \link or once idle ( looper thread only ).
             casper::job::sequencer::v8::Script*         script_;
             
             ::cc::rollbar::v1::API*                     rollbar_;
             ::cc::easy::job::Volatile*                  volatile_;
+            
+            sequencer::Ring<Message>                    messages_;           //!< MAIN thread -> looper thread hand-off.
+            std::atomic<bool>                           messages_scheduled_; //!< True when a looper callback to drain messages_ is pending.
+            std::mutex                                  overflow_mutex_;     //!< Guards overflow_.
+            std::deque<Message>                         overflow_;           //!< MAIN thread -> looper thread hand-off, used only while messages_ is full.
+            std::atomic<size_t>                         overflow_size_;      //!< Number of messages in overflow_, while not 0 new messages are appended to it ( ordering ).
+            
+            sequencer::Stats                            stats_;              //!< Per tube, per stage, latency histograms ( looper thread only ).
+            sequencer::Metrics                          metrics_;            //!< Prometheus metrics.
+            std::string                                 metrics_uri_;        //!< Prometheus metrics file URI, empty when disabled.
+            
+            uint64_t                                    relay_interval_;     //!< Minimum interval, in microseconds, between 'in-progress' relays of a sequence, 0 to relay all.
+            
+            bool                                        pushes_deferred_;    //!< True while draining messages, launched activities are queued instead of pushed.
+            std::deque<PendingPush>                     pushes_;             //!< Activities waiting to be pushed to beanstalkd ( looper thread only ).
+            sequencer::Producer                         producer_;           //!< Pipelined producer to beanstalk_config() beanstalkd, enabled by 'pipelined_push', otherwise \link PushJob \link is used ( looper thread only ).
+            
+            size_t                                      map_concurrency_;    //!< Default maximum number of running items of a 'map' step.
+            
+            std::map<uint64_t, size_t>                  skips_;              //!< Skipped activity RJNR ( REDIS job number ) -> branch target index, npos if none ( looper thread only ).
+            uint64_t                                    local_rjnr_;         //!< Last job number assigned to an activity finalized without a REDIS job ( skipped or memoized ), above REDIS ones ( looper thread only ).
+            
+            std::map<uint64_t, uint64_t>                hedges_;             //!< Hedged activity RJNR ( REDIS job number ) -> other attempt RJNR, both ways ( looper thread only ).
+            std::map<uint64_t, Json::Value>             retries_;            //!< Activity RJNR ( REDIS job number ) waiting to be retried -> it's last response ( looper thread only ).
+            
+            sequencer::Memo                             memo_;               //!< Per tube activities results cache ( looper thread only ).
+            std::map<uint64_t, Json::Value>             memoized_;           //!< Memoized activity RJNR ( REDIS job number ) -> cached response, until finalized ( looper thread only ).
+            
+            bool                                        idempotency_derive_; //!< True when an idempotency key is derived from 'jobs' and origin, if not provided by payload.
+            std::map<uint64_t, uint64_t>                idempotency_keys_;   //!< Idempotency key -> in-flight sequence RJNR ( REDIS job number ) ( looper thread only ).
+            std::map<uint64_t, Coalesced>               coalesced_;          //!< In-flight sequence RJNR ( REDIS job number ) -> attached sequences ( looper thread only ).
+            sequencer::Memo                             completed_;          //!< Idempotency key -> recently completed sequences responses ( looper thread only ).
 
         public: // Constructor(s) / Destructor
             
@@ -115,27 +289,69 @@ namespace casper
             //
             // SEQUENCER
             //
-            sequencer::Activity                              RegisterSequence              (sequencer::Sequence& a_sequence, const Json::Value& a_payload);
+            sequencer::Activity                              RegisterSequence              (const std::shared_ptr<sequencer::Sequence>& a_sequence, const Json::Value& a_payload);
             void                                             CancelSequence                (const sequencer::Activity& a_activity, const Json::Value& a_response);
+            void                                             ReleaseSequence               (const sequencer::Sequence& a_sequence, const Json::Value& a_response);
             void                                             FinalizeSequence              (const sequencer::Activity& a_activity, const Json::Value& a_response,
                                                                                             double& o_rtt);
+            void                                             FinishSequence                (const sequencer::Activity& a_activity, const Json::Value& a_response);
+            uint64_t                                         IdempotencyKey                (const Json::Value& a_payload, const Json::Value& a_origin, std::string& o_identity) const;
+            bool                                             AttachSequence                (const uint64_t a_key, const std::string& a_identity, const sequencer::SharedSequence& a_sequence);
+            void                                             LeadSequence                  (const uint64_t a_key, const std::string& a_identity, const sequencer::SharedSequence& a_sequence);
             
             //
             // ACTIVITY
             //
+            uint16_t                                         LaunchStep                    (const sequencer::Tracking& a_tracking, sequencer::Activity& a_activity, const bool a_at_run);
             uint16_t                                         LaunchActivity                (const sequencer::Tracking& a_tracking, sequencer::Activity& a_activity, const bool a_at_run);
-            void                                             ActivityMessageRelay          (const sequencer::Tracking& a_tracking, const sequencer::Activity& a_activity, const Json::Value& a_message);
+            void                                             GroupActivityReturned         (const sequencer::Tracking& a_tracking, const sequencer::Activity& a_activity,
+                                                                                            const Json::Value* a_response);
+            void                                             GroupReturned                 (const sequencer::Tracking& a_tracking, const sequencer::SharedSequence& a_sequence);
+            bool                                             LoadActivity                  (const sequencer::SharedSequence& a_sequence, const size_t a_index,
+                                                                                            sequencer::Activity& o_activity);
+            void                                             StartMap                      (const sequencer::Tracking& a_tracking, const sequencer::Activity& a_activity,
+                                                                                            Json::Value&& a_items, const int64_t a_expires_in, const size_t a_concurrency);
+            void                                             MapNext                       (const sequencer::Tracking& a_tracking, const uint64_t a_rjnr, const bool a_deferred);
+            void                                             LaunchMapItem                 (const sequencer::Tracking& a_tracking, MapStep& a_map, const size_t a_index);
+            void                                             MapItemReturned               (const sequencer::Tracking& a_tracking, const sequencer::Activity& a_activity,
+                                                                                            const Json::Value* a_response);
+            void                                             MapReturned                   (const sequencer::Tracking& a_tracking, const uint64_t a_rjnr);
+            void                                             OnMapTimer                    (const std::string& a_id);
+            size_t                                           ResolveBranch                 (const sequencer::Activity& a_activity, const Json::Value& a_target);
+            void                                             OnSkipTimer                   (const std::string& a_id);
+            void                                             SkipActivities                (const sequencer::SharedSequence& a_sequence, const size_t a_first, const size_t a_last);
+            void                                             OnMemoTimer                   (const std::string& a_id);
+            void                                             ActivityMessageRelay          (const sequencer::Tracking& a_tracking, const sequencer::Activity& a_activity, const char* const a_message, const size_t a_length);
+            void                                             RelayActivityMessage          (const sequencer::Activity& a_activity, const std::string& a_message);
+            void                                             FlushActivityMessages         (const sequencer::Activity& a_activity, const bool a_relay);
+            void                                             OnActivityMessagesTimer       (const std::string& a_id);
             void                                             ActivityReturned              (const sequencer::Tracking& a_tracking, const sequencer::Activity& a_activity, const Json::Value* a_response);
+            bool                                             RetryActivity                 (const sequencer::Tracking& a_tracking, const sequencer::Activity& a_activity, const Json::Value* a_response);
+            bool                                             LaunchAttempt                 (sequencer::Activity& io_activity, const uint64_t a_peer, std::string& o_error);
             
             void                                             RegisterActivity              (const sequencer::Activity& a_activity);
+            uint16_t                                         ReserveActivityJob            (const uint64_t a_rjnr, const std::string& a_tube, const int64_t a_expires_in,
+                                                                                            uint64_t& o_id, std::string& o_key, std::string& o_channel, std::string& o_error);
+            void                                             ReserveNextActivityJob        (const sequencer::Activity& a_activity);
+            void                                             ReserveNextJob                (const uint64_t a_rjnr, const std::string& a_tube, const int64_t a_expires_in);
+            void                                             ProcessReservation            (const uint64_t a_rjnr, const Json::Value& a_id);
             
             // REDIS
             void                                             SubscribeActivity             (const sequencer::Activity& a_activity);
             EV_REDIS_SUBSCRIPTIONS_DATA_POST_NOTIFY_CALLBACK OnActivityMessageReceived     (const std::string& a_id, const std::string& a_message);
+            void                                             ProcessActivityMessage        (const std::string& a_id, const std::string& a_message);
             void                                             UnsubscribeActivity           (const sequencer::Activity& a_activity);
+            void                                             RelayMessage                  (const std::string& a_channel, const std::string& a_key, const std::string& a_message);
+            void                                             StartRelayMessage             (const std::string& a_channel, const std::string& a_key, const std::string& a_message,
+                                                                                            RelayTicket& o_ticket);
+            void                                             WaitRelayMessage              (RelayTicket& a_ticket);
 
             // BEANSTALKD
             void                                             PushActivity                  (const sequencer::Activity& a_activity);
+            void                                             QueueActivityPush             (const sequencer::Activity& a_activity);
+            void                                             FlushActivityPushes           ();
+            static sequencer::Producer::Job                  ProducerJob                   (const sequencer::Activity& a_activity, const std::string& a_tube);
+            std::string                                      ForgeResetMessage             (const sequencer::Activity& a_activity);
 
             // REDIS
             void                                             FinalizeActivity              (const sequencer::Activity& a_activity, const Json::Value* a_response,
@@ -149,6 +365,10 @@ namespace casper
             void                                             UntrackActivity               (const sequencer::Activity& a_activity);
             
             void                                             OnActivityTimeout             (const std::string& a_rcid);
+            void                                             OnHedgeTimer                  (const std::string& a_id);
+            void                                             OnRetryTimer                  (const std::string& a_id);
+            void                                             OnStatsTimer                  (const std::string& a_id);
+            void                                             OnMetricsTimer                (const std::string& a_id);
 
             //
             // JOB
@@ -156,13 +376,21 @@ namespace casper
             void                                             FinalizeJob                     (const sequencer::Sequence& a_sequence,
                                                                                               const Json::Value& a_response);
             void                                             OnJobsSignalReceived            (const uint64_t& a_id, const std::string& a_status, const Json::Value& a_message);
+            void                                             ProcessJobsSignal               (const uint64_t& a_id, const Json::Value& a_message);
+
+            //
+            // MAIN THREAD -> LOOPER THREAD
+            //
+            void                                             PostMessage                     (Message&& a_message);
+            void                                             OnMessagesPosted                (const std::string& a_id);
+            void                                             ProcessMessage                  (const Message& a_message);
 
             //
             // POSTGRESQL
             //
             void                                            ExecuteQueryAndWait            (const sequencer::Tracking& a_tracking,
                                                                                             const std::string& a_query, const ExecStatusType& a_expected,
-                                                                                            const std::function<void(const Json::Value& a_value)> a_success_callback = nullptr,
+                                                                                            const std::function<void(Json::Value& a_value)> a_success_callback = nullptr,
                                                                                             const std::function<void(const ev::Exception& a_exception)> a_failure_callback = nullptr);
                                                                                             
             const ::ev::postgresql::Value*                  EnsurePostgreSQLValue          (const ::ev::Object* a_object, const ExecStatusType& a_expected);
@@ -170,9 +398,10 @@ namespace casper
             //
             // SERIALIZATION HELPERS
             //
-            const Json::Value& MSG2JSON           (const std::string& a_value, Json::Value& o_value);
+            static const Json::Value& MSG2JSON    (const std::string& a_value, Json::Value& o_value);
             
-            void               PatchActivity      (const sequencer::Tracking& a_tracking, sequencer::Activity& a_activity, Json::Value& o_abort_result);
+            void               PatchActivity      (const sequencer::Tracking& a_tracking, sequencer::Activity& a_activity, Json::Value& o_abort_result,
+                                                   const std::string& a_items_expr, Json::Value& o_items, Branch& io_branch);
             
             //
             // DEBUG HELPER(S)
@@ -186,6 +415,8 @@ namespace casper
             //
             void ValidateSequenceTimeouts (const sequencer::Tracking& a_tracking, const sequencer::Sequence& a_sequence, const Json::Value& a_payload,
                                            Json::UInt& o_ttr, Json::UInt& o_validity, Json::UInt& o_timeout);
+            static void SumSequenceTimeouts (const sequencer::Tracking& a_tracking, const Json::Value& a_jobs, const Json::UInt a_ttr, const Json::UInt a_validity,
+                                             const size_t a_map_concurrency, Json::UInt& o_ttr, Json::UInt& o_validity);
             void LogSequenceAlert         (const sequencer::Sequence& a_sequence, const Json::Value& a_acts,
                                            const size_t a_level, const char* const a_step, const Json::Value& a_definitions,
                                            const Json::UInt a_timeout);
@@ -208,21 +439,28 @@ namespace casper
 
         protected: // Inline Method(s) // Function(s)
             
-            void        LogStats () const;
-            std::string MakeID   (const char* const a_name, const std::string a_rcid);
+            void        LogStats  ();
+            static std::string MakeID (const char* const a_name, const std::string a_rcid);
+            static std::string IdempotencyDigest (const std::string& a_identity);
+            uint64_t    RCID2RJNR (const std::string& a_rcid) const;
+            SequenceState* FindSequenceState (const uint64_t a_rjnr);
+            void           TrimSequenceState (const uint64_t a_rjnr);
 
         }; // end of class 'Sequencer'
     
         /**
-         * @brief Log some statistics.
+         * @brief Log some statistics and latency histograms collected since last call.
          */
-        inline void Sequencer::LogStats () const
+        inline void Sequencer::LogStats ()
         {
             CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
             owner_log_callback_(tube_.c_str(),
                                 "STATS",
                                 std::to_string(running_activities_.size()) + " " + ( 1 == running_activities_.size()  ? "activity is"  : "activities are" ) + " running"
             );
+            stats_.Dump([this] (const std::string& a_line) {
+                owner_log_callback_(tube_.c_str(), "STATS", a_line);
+            });
         }
         
         /**
@@ -242,7 +480,83 @@ namespace casper
             }
             return std::string(a_name) + "-" + a_rcid + "-" + ss.str();
         }
-              
+
+        /**
+         * @brief Compact a sequence identity, to be kept with it's recently completed response.
+         *
+         * @param a_identity Sequence identity, as set by \link IdempotencyKey \link.
+         *
+         * @return Provided keys as is ( they are short ), derived ones are reduced to a second hash - independent of the key one.
+         */
+        inline std::string Sequencer::IdempotencyDigest (const std::string& a_identity)
+        {
+            if ( 0 == a_identity.compare(0, 4, "key:") ) {
+                return a_identity;
+            }
+            return "jobs:" + std::to_string(std::hash<std::string>()(a_identity));
+        }
+
+        /**
+         * @brief Extract an activity REDIS job number from it's channel id.
+         *
+         * @param a_rcid Activity REDIS channel id ( <service_id>:<tube>:<rjnr> ), optionally prefixed by a callback tag ( <tag>:<rcid> ).
+         *
+         * @return REDIS job number, 0 if not a valid channel id ( no ':' separator, no digits, a non-digit or an overflowing number ).
+         */
+        inline uint64_t Sequencer::RCID2RJNR (const std::string& a_rcid) const
+        {
+            const size_t separator = a_rcid.rfind(':');
+            if ( std::string::npos == separator || separator + 1 == a_rcid.length() ) {
+                return 0;
+            }
+            uint64_t rjnr = 0;
+            for ( size_t idx = separator + 1 ; idx < a_rcid.length() ; ++idx ) {
+                const char c = a_rcid[idx];
+                if ( c < '0' || c > '9' ) {
+                    return 0;
+                }
+                const uint64_t digit = static_cast<uint64_t>(c - '0');
+                if ( rjnr > ( UINT64_MAX - digit ) / 10 ) {
+                    return 0;
+                }
+                rjnr = rjnr * 10 + digit;
+            }
+            return rjnr;
+        }
+
+        /**
+         * @brief Obtain a sequence looper state.
+         *
+         * @param a_rjnr Sequence REDIS job number.
+         *
+         * @return Sequence state, nullptr if none ( it's never created here ).
+         */
+        inline Sequencer::SequenceState* Sequencer::FindSequenceState (const uint64_t a_rjnr)
+        {
+            CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+            const auto it = sequences_.find(a_rjnr);
+            return ( sequences_.end() != it ? &it->second : nullptr );
+        }
+
+        /**
+         * @brief Forget a sequence looper state, if it's idle ( no running activities nor pending group, step, branch, relay or reservation ).
+         *
+         * @param a_rjnr Sequence REDIS job number.
+         */
+        inline void Sequencer::TrimSequenceState (const uint64_t a_rjnr)
+        {
+            CC_DEBUG_FAIL_IF_NOT_AT_THREAD(thread_id_);
+            const auto it = sequences_.find(a_rjnr);
+            if ( sequences_.end() == it ) {
+                return;
+            }
+            const SequenceState& state = it->second;
+            if ( true == state.running_.empty() && nullptr == state.group_ && nullptr == state.map_
+                && nullptr == state.branch_ && nullptr == state.relay_ && nullptr == state.reservation_ ) {
+                sequences_.erase(it);
+            }
+        }
+
     } // end of namespace 'job'
 
 } // end of namespace 'casper'
@@ -29,7 +29,7 @@
  * @param a_index
  * @param a_attempt
  */
-casper::job::sequencer::Activity::Activity (const Sequence& a_sequence, const std::string& a_did, const size_t& a_index, const size_t& a_attempt)
+casper::job::sequencer::Activity::Activity (const SharedSequence& a_sequence, const std::string& a_did, const size_t& a_index, const size_t& a_attempt)
  : sequence_(a_sequence)
 {
     did_      = a_did;
@@ -43,6 +43,8 @@ casper::job::sequencer::Activity::Activity (const Sequence& a_sequence, const st
     status_   = casper::job::sequencer::Status::NotSet;
     validity_ = 0;
     ttr_      = 0;
+    memo_key_ = 0;
+    pushed_at_ = 0;
 }
 
 /**
@@ -56,6 +58,7 @@ casper::job::sequencer::Activity::Activity (const casper::job::sequencer::Activi
     did_         = a_activity.did_;
     index_       = a_activity.index_;
     payload_     = a_activity.payload_;
+    payload_str_ = a_activity.payload_str_;
     attempt_     = a_activity.attempt_;
     rjnr_        = a_activity.rjnr_;
     rjid_        = a_activity.rjid_;
@@ -66,6 +69,26 @@ casper::job::sequencer::Activity::Activity (const casper::job::sequencer::Activi
     ttr_         = a_activity.ttr_;
     abort_expr_  = a_activity.abort_expr_;
     abort_msg_   = a_activity.abort_msg_;
+    retry_       = a_activity.retry_;
+    memo_key_    = a_activity.memo_key_;
+    memo_data_   = a_activity.memo_data_;
+    pushed_at_   = a_activity.pushed_at_;
+}
+
+/**
+ * @brief Move constructor.
+ *
+ * @param a_activity Object to move.
+ */
+casper::job::sequencer::Activity::Activity (casper::job::sequencer::Activity&& a_activity)
+    : sequence_(std::move(a_activity.sequence_)),
+      did_(std::move(a_activity.did_)), index_(a_activity.index_), payload_(std::move(a_activity.payload_)), payload_str_(std::move(a_activity.payload_str_)), attempt_(a_activity.attempt_),
+      rjnr_(a_activity.rjnr_), rjid_(std::move(a_activity.rjid_)), rcnm_(std::move(a_activity.rcnm_)), rcid_(std::move(a_activity.rcid_)),
+      status_(a_activity.status_), validity_(a_activity.validity_), ttr_(a_activity.ttr_),
+      abort_expr_(std::move(a_activity.abort_expr_)), abort_msg_(std::move(a_activity.abort_msg_)), retry_(std::move(a_activity.retry_)),
+      memo_key_(a_activity.memo_key_), memo_data_(std::move(a_activity.memo_data_)), pushed_at_(a_activity.pushed_at_)
+{
+    /* empty */
 }
 
 /**
@@ -75,3 +98,12 @@ casper::job::sequencer::Activity::~Activity ()
 {
     payload_.clear();
 }
+
+/**
+ * @brief Serialize current payload, result is kept and shared by all copies of this activity until payload changes.
+ */
+void casper::job::sequencer::Activity::SerializePayload ()
+{
+    Json::FastWriter fw; fw.omitEndingLineFeed();
+    payload_str_ = std::make_shared<const std::string>(fw.write(payload_));
+}
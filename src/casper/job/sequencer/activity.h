@@ -22,10 +22,10 @@
 #ifndef CASPER_JOB_SEQUENCER_ACTIVITY_H_
 #define CASPER_JOB_SEQUENCER_ACTIVITY_H_
 
-#include "cc/non-movable.h"
-
 #include <inttypes.h> // uint64_t
 #include <string>
+#include <memory>     // std::shared_ptr
+#include <utility>    // std::move
 
 #include "json/json.h"
 
@@ -44,18 +44,16 @@ namespace casper
         namespace sequencer
         {
 
-            class Activity final : public cc::NonMovable
+            class Activity final
             {
                 
-            private: // Const Data
-                
-                const Sequence    sequence_;    //!< SEQUENCER beanstald job info.
-                
             private: // Data
-                                                
+                
+                SharedSequence     sequence_;    //!< SEQUENCER beanstald job info ( shared by all activities, R/O ).
                 std::string        did_;         //!< DB id ( form table js.activities[id] as string ).
                 size_t             index_;       //!< JOB index.
                 Json::Value        payload_;     //!< JOB payload.
+                std::shared_ptr<const std::string> payload_str_; //!< JOB payload, serialized once after patch ( shared by copies ).
                 size_t             attempt_;     //!< JOB attempt number.
                 uint64_t           rjnr_;        //!< REDIS job number.
                 std::string        rjid_;        //!< JOB REDIS id.
@@ -66,34 +64,49 @@ namespace casper
                 uint32_t           ttr_;         //!< JOB TTR.
                 std::string        abort_expr_;  //!< Optional, abort condition ( V8 expression to evaluate ).
                 std::string        abort_msg_;   //!< Optional, abort message.
+                Json::Value        retry_;       //!< Optional, retry policy.
+                uint64_t           memo_key_;    //!< Memoization key ( patched payload hash ), 0 if result is not memoizable.
+                std::shared_ptr<const std::string> memo_data_; //!< Memoization key data ( patched payload, without 'id', serialized ), shared by copies.
+                uint64_t           pushed_at_;   //!< Monotonic timestamp ( µs ) of beanstalkd push, 0 if not pushed yet.
                 
             public: // Constructor(s) / Destructor
                 
                 Activity () = delete;
-                Activity (const Sequence& a_sequence, const std::string& a_did, const size_t& a_index, const size_t& a_attempt);
+                Activity (const SharedSequence& a_sequence, const std::string& a_did, const size_t& a_index, const size_t& a_attempt);
                 Activity (const Activity& a_activity);
+                Activity (Activity&& a_activity);
                 virtual ~Activity();
                 
             public: // Method(s) / Function(s)
                 
                 void      Bind    (const uint64_t a_rjnr, const std::string& a_rjid, const std::string& a_rcnm, const std::string& a_rcid, const bool a_new_attempt);
                 Activity& Bind    (const Status& a_status, const uint32_t& a_validity, const uint32_t& a_ttr, const Json::Value& a_payload);
+                Activity& Bind    (const Status& a_status, const uint32_t& a_validity, const uint32_t& a_ttr, Json::Value&& a_payload);
                 void      Reset   (const Status& a_status, const Json::Value& a_payload, const uint32_t& a_validity = 0, const uint32_t& a_ttr = 0);
+                void      Reset   (const Status& a_status, Json::Value&& a_payload, const uint32_t& a_validity = 0, const uint32_t& a_ttr = 0);
                 
-                void SetIndex          (const size_t& a_index);
-                void SetDID            (const std::string& a_did);
-                void SetPayload        (const Json::Value& a_payload);
-                void SetStatus         (const Status& a_status);
-                void SetValidity       (const uint32_t& a_validity);
-                void SetTTR            (const uint32_t& a_ttr);
-                void SetAbortCondition (const Json::Value& a_obj);
+                void        SetIndex          (const size_t& a_index);
+                void        SetDID            (const std::string& a_did);
+                void        SetPayload        (const Json::Value& a_payload);
+                void        SetPayload        (Json::Value&& a_payload);
+                Json::Value DetachPayload     ();
+                void        SerializePayload  ();
+                void        SetStatus         (const Status& a_status);
+                void        SetValidity       (const uint32_t& a_validity);
+                void        SetTTR            (const uint32_t& a_ttr);
+                void        SetAbortCondition (const Json::Value& a_obj);
+                void        SetRetryPolicy    (const Json::Value& a_policy);
+                void        SetMemoKey        (const uint64_t a_key, const std::shared_ptr<const std::string>& a_data);
+                void        SetPushedAt       (const uint64_t a_timestamp);
 
             public: // RO Method(s) / Function(s)
                 
-                const Sequence&     sequence   () const;
+                const Sequence&       sequence        () const;
+                const SharedSequence& shared_sequence () const;
                 const std::string&  did        () const;
                 const size_t&       index      () const;
                 const Json::Value&  payload    () const;
+                const std::string&  payload_str() const;
                 const size_t&       attempt    () const;
                 const uint64_t&     rjnr       () const;
                 const std::string&  rjid       () const;
@@ -105,10 +118,15 @@ namespace casper
                 uint64_t            timeout    () const;
                 const std::string&  abort_expr () const;
                 const std::string&  abort_msg  () const;
+                const Json::Value&  retry      () const;
+                const uint64_t&     memo_key   () const;
+                const std::string&  memo_data  () const;
+                const uint64_t&     pushed_at  () const;
                 
             public: // Operator(s) / Overload
                 
                 Activity& operator= (const Activity& a_activity) = delete;
+                Activity& operator= (Activity&& a_activity) = delete;
         
             }; // end of class 'Activity'            
 
@@ -127,6 +145,7 @@ namespace casper
                 rjid_ = a_rjid;
                 rcnm_ = a_rcnm;
                 rcid_ = a_rcid;
+                pushed_at_ = 0;
                 if ( true == a_new_attempt ) {
                     attempt_ += 1;
                 }
@@ -144,6 +163,24 @@ namespace casper
                 ttr_      = a_ttr;
                 payload_.clear();
                 payload_ = a_payload;
+                payload_str_.reset();
+                return *this;
+            }
+        
+            /**
+             * @brief Set some of the activity mutable properties scheduling.
+             *
+             * @param a_payload Payload to move into this activity.
+             *
+             * @return Ref to this object instance;
+             */
+            inline Activity& Activity::Bind (const Status& a_status, const uint32_t& a_validity, const uint32_t& a_ttr, Json::Value&& a_payload)
+            {
+                status_   = a_status;
+                validity_ = a_validity;
+                ttr_      = a_ttr;
+                payload_  = std::move(a_payload);
+                payload_str_.reset();
                 return *this;
             }
         
@@ -157,10 +194,33 @@ namespace casper
                 status_      = a_status;
                 payload_.clear();
                 payload_     = a_payload;
+                payload_str_.reset();
                 ttr_         = a_ttr;
                 validity_    = a_validity;
                 abort_expr_  = "";
                 abort_msg_   = "";
+                retry_       = Json::Value::null;
+                memo_key_    = 0;
+                memo_data_.reset();
+            }
+        
+            /**
+             * @brief Set some of the activity mutable properties scheduling.
+             *
+             * @param a_payload Payload to move into this activity.
+             */
+            inline void Activity::Reset (const Status& a_status, Json::Value&& a_payload, const uint32_t& a_validity, const uint32_t& a_ttr)
+            {
+                status_      = a_status;
+                payload_     = std::move(a_payload);
+                payload_str_.reset();
+                ttr_         = a_ttr;
+                validity_    = a_validity;
+                abort_expr_  = "";
+                abort_msg_   = "";
+                retry_       = Json::Value::null;
+                memo_key_    = 0;
+                memo_data_.reset();
             }
 
             /**
@@ -192,6 +252,31 @@ namespace casper
             {
                 payload_.clear();
                 payload_ = a_payload;
+                payload_str_.reset();
+            }
+        
+            /**
+             * @brief Set activity payload.
+             *
+             * @param a_payload Payload to move into this activity.
+             */
+            inline void Activity::SetPayload (Json::Value&& a_payload)
+            {
+                payload_ = std::move(a_payload);
+                payload_str_.reset();
+            }
+        
+            /**
+             * @brief Move activity payload out of this activity, leaving it as null.
+             *
+             * @return Activity payload.
+             */
+            inline Json::Value Activity::DetachPayload ()
+            {
+                Json::Value payload = Json::Value::null;
+                payload.swap(payload_);
+                payload_str_.reset();
+                return payload;
             }
         
             /**
@@ -224,6 +309,16 @@ namespace casper
                 ttr_ = a_ttr;
             }
         
+            /**
+             * @brief Set beanstalkd push timestamp.
+             *
+             * @param a_timestamp Monotonic timestamp, in microseconds.
+             */
+            inline void Activity::SetPushedAt (const uint64_t a_timestamp)
+            {
+                pushed_at_ = a_timestamp;
+            }
+        
             /**
              * @brief Set abort condition ( V8 expression to evaluate ).
              *
@@ -251,10 +346,40 @@ namespace casper
                 }
             }
                     
+            /**
+             * @brief Set retry policy.
+             *
+             * @param a_policy Retry policy, Json::Value::null if none.
+             */
+            inline void Activity::SetRetryPolicy (const Json::Value& a_policy)
+            {
+                retry_ = a_policy;
+            }
+        
+            /**
+             * @brief Set memoization key.
+             *
+             * @param a_key  Patched payload hash, 0 if result is not memoizable.
+             * @param a_data Hashed data, compared on lookup.
+             */
+            inline void Activity::SetMemoKey (const uint64_t a_key, const std::shared_ptr<const std::string>& a_data)
+            {
+                memo_key_  = a_key;
+                memo_data_ = a_data;
+            }
+        
             /**
              * @return RO access to sequence info.
              */
             inline const Sequence& Activity::sequence () const
+            {
+                return *sequence_;
+            }
+        
+            /**
+             * @return RO access to sequence handle, to keep sequence info alive after this activity is released.
+             */
+            inline const SharedSequence& Activity::shared_sequence () const
             {
                 return sequence_;
             }
@@ -283,6 +408,15 @@ namespace casper
                 return payload_;
             }
         
+            /**
+             * @return RO access to activity job payload serialization, empty if \link SerializePayload \link wasn't called since last payload change.
+             */
+            inline const std::string& Activity::payload_str() const
+            {
+                static const std::string sk_empty_ = "";
+                return ( nullptr != payload_str_ ? *payload_str_ : sk_empty_ );
+            }
+        
             /**
              * @return RO access to activity job attempt number.
              */
@@ -371,6 +505,39 @@ namespace casper
             {
                 return abort_msg_;
             }
+        
+            /**
+             * @return RO access to activity retry policy, Json::Value::null if none.
+             */
+            inline const Json::Value& Activity::retry () const
+            {
+                return retry_;
+            }
+        
+            /**
+             * @return RO access to activity memoization key, 0 if result is not memoizable.
+             */
+            inline const uint64_t& Activity::memo_key () const
+            {
+                return memo_key_;
+            }
+        
+            /**
+             * @return RO access to activity memoization key data, empty if result is not memoizable.
+             */
+            inline const std::string& Activity::memo_data () const
+            {
+                static const std::string sk_empty_ = "";
+                return ( nullptr != memo_data_ ? *memo_data_ : sk_empty_ );
+            }
+        
+            /**
+             * @return RO access to activity beanstalkd push timestamp, 0 if not pushed yet.
+             */
+            inline const uint64_t& Activity::pushed_at () const
+            {
+                return pushed_at_;
+            }
 
         } // end of namespace 'sequencer'
     
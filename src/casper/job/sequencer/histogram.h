@@ -0,0 +1,238 @@
+/**
+* @file histogram.h
+*
+* Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+*
+* This file is part of casper-job-sequencer.
+*
+* casper-job-sequencer is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Affero General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* casper-job-sequencer  is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU Affero General Public License
+* along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#ifndef CASPER_JOB_SEQUENCER_HISTOGRAM_H_
+#define CASPER_JOB_SEQUENCER_HISTOGRAM_H_
+
+#include <inttypes.h> // uint64_t
+#include <stddef.h>   // size_t
+#include <vector>
+
+namespace casper
+{
+
+    namespace job
+    {
+
+        namespace sequencer
+        {
+
+            /**
+             * @brief HDR style ( log-linear ) histogram of unsigned values.
+             *
+             * Values below 2^sk_sub_bits_ are exact, above that each power of 2 is split in 2^sk_sub_bits_
+             * linear buckets ( ~6% relative error ). Recording is O(1) and never allocates.
+             * Not thread safe.
+             */
+            class Histogram final
+            {
+
+            private: // Static Const Data
+
+                static const size_t   sk_sub_bits_  = 4;
+                static const size_t   sk_sub_count_ = ( size_t(1) << sk_sub_bits_ );
+                static const size_t   sk_max_bits_  = 40; // ~12 days in microseconds, higher values are clamped.
+                static const uint64_t sk_max_value_ = ( uint64_t(1) << sk_max_bits_ ) - 1;
+                static const size_t   sk_buckets_   = sk_sub_count_ + ( sk_max_bits_ - sk_sub_bits_ ) * sk_sub_count_;
+
+            private: // Data
+
+                std::vector<uint64_t> counts_; //!< Number of values per bucket.
+                uint64_t              count_;  //!< Number of values.
+                uint64_t              sum_;    //!< Sum of all values.
+                uint64_t              min_;    //!< Minimum value.
+                uint64_t              max_;    //!< Maximum value.
+
+            public: // Constructor(s) / Destructor
+
+                Histogram ();
+                virtual ~Histogram ();
+
+            public: // Method(s) / Function(s)
+
+                void     Record     (uint64_t a_value);
+                uint64_t Percentile (const double a_percentile) const;
+                void     Reset      ();
+
+                uint64_t count () const;
+                uint64_t min   () const;
+                uint64_t max   () const;
+                uint64_t mean  () const;
+
+            private: // Static Method(s) / Function(s)
+
+                static size_t   Bucket     (const uint64_t a_value);
+                static uint64_t UpperBound (const size_t a_bucket);
+
+            }; // end of class 'Histogram'
+
+            /**
+             * @brief Default constructor.
+             */
+            inline Histogram::Histogram ()
+                : counts_(sk_buckets_, 0)
+            {
+                count_ = 0;
+                sum_   = 0;
+                min_   = 0;
+                max_   = 0;
+            }
+
+            /**
+             * @brief Destructor.
+             */
+            inline Histogram::~Histogram ()
+            {
+                /* empty */
+            }
+
+            /**
+             * @brief Record a value.
+             *
+             * @param a_value Value to record.
+             */
+            inline void Histogram::Record (uint64_t a_value)
+            {
+                if ( a_value > sk_max_value_ ) {
+                    a_value = sk_max_value_;
+                }
+                counts_[Bucket(a_value)]++;
+                if ( 0 == count_ || a_value < min_ ) {
+                    min_ = a_value;
+                }
+                if ( a_value > max_ ) {
+                    max_ = a_value;
+                }
+                sum_ += a_value;
+                count_++;
+            }
+
+            /**
+             * @brief Calculate a percentile.
+             *
+             * @param a_percentile Percentile, ]0, 100].
+             *
+             * @return Upper bound of the bucket where percentile is, 0 if empty.
+             */
+            inline uint64_t Histogram::Percentile (const double a_percentile) const
+            {
+                if ( 0 == count_ ) {
+                    return 0;
+                }
+                uint64_t target = static_cast<uint64_t>(( a_percentile / 100.0 ) * static_cast<double>(count_) + 0.5);
+                if ( target < 1 ) {
+                    target = 1;
+                } else if ( target > count_ ) {
+                    target = count_;
+                }
+                uint64_t accumulated = 0;
+                for ( size_t idx = 0 ; idx < counts_.size() ; ++idx ) {
+                    accumulated += counts_[idx];
+                    if ( accumulated >= target ) {
+                        const uint64_t bound = UpperBound(idx);
+                        return ( bound < max_ ? bound : max_ );
+                    }
+                }
+                return max_;
+            }
+
+            /**
+             * @brief Forget all values.
+             */
+            inline void Histogram::Reset ()
+            {
+                if ( 0 == count_ ) {
+                    return;
+                }
+                for ( auto& count : counts_ ) {
+                    count = 0;
+                }
+                count_ = 0;
+                sum_   = 0;
+                min_   = 0;
+                max_   = 0;
+            }
+
+            /**
+             * @return Number of values.
+             */
+            inline uint64_t Histogram::count () const
+            {
+                return count_;
+            }
+
+            /**
+             * @return Minimum value.
+             */
+            inline uint64_t Histogram::min () const
+            {
+                return min_;
+            }
+
+            /**
+             * @return Maximum value.
+             */
+            inline uint64_t Histogram::max () const
+            {
+                return max_;
+            }
+
+            /**
+             * @return Mean value.
+             */
+            inline uint64_t Histogram::mean () const
+            {
+                return ( 0 != count_ ? sum_ / count_ : 0 );
+            }
+
+            /**
+             * @return Bucket index for a value.
+             */
+            inline size_t Histogram::Bucket (const uint64_t a_value)
+            {
+                if ( a_value < sk_sub_count_ ) {
+                    return static_cast<size_t>(a_value);
+                }
+                const size_t msb   = static_cast<size_t>(63 - __builtin_clzll(a_value));
+                const size_t shift = msb - sk_sub_bits_;
+                return sk_sub_count_ + shift * sk_sub_count_ + static_cast<size_t>(( a_value >> shift ) - sk_sub_count_);
+            }
+
+            /**
+             * @return Highest value that falls in a bucket.
+             */
+            inline uint64_t Histogram::UpperBound (const size_t a_bucket)
+            {
+                if ( a_bucket < sk_sub_count_ ) {
+                    return static_cast<uint64_t>(a_bucket);
+                }
+                const size_t shift = ( a_bucket - sk_sub_count_ ) / sk_sub_count_;
+                const size_t sub   = ( a_bucket - sk_sub_count_ ) % sk_sub_count_;
+                return ( static_cast<uint64_t>(sk_sub_count_ + sub + 1) << shift ) - 1;
+            }
+
+        } // end of namespace 'sequencer'
+
+    } // end of namespace 'job'
+
+} // end of namespace 'casper'
+
+#endif // CASPER_JOB_SEQUENCER_HISTOGRAM_H_
@@ -0,0 +1,271 @@
+/**
+* @file index.h
+*
+* Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+*
+* This file is part of casper-job-sequencer.
+*
+* casper-job-sequencer is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Affero General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* casper-job-sequencer  is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU Affero General Public License
+* along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#ifndef CASPER_JOB_SEQUENCER_INDEX_H_
+#define CASPER_JOB_SEQUENCER_INDEX_H_
+
+#include "cc/non-movable.h"
+#include "cc/non-copyable.h"
+
+#include <inttypes.h> // uint64_t
+#include <stddef.h>   // size_t
+#include <vector>
+
+namespace casper
+{
+
+    namespace job
+    {
+
+        namespace sequencer
+        {
+
+            /**
+             * @brief Open-addressing ( linear probing ) hash table keyed by REDIS job numbers.
+             *
+             * Values are non-owned pointers, nullptr means 'not found'.
+             * Not thread safe, expected to be used only at the looper thread.
+             */
+            template <typename T>
+            class Index final : public cc::NonMovable, public cc::NonCopyable
+            {
+
+            private: // Data Type(s)
+
+                typedef struct {
+                    uint64_t key_;
+                    T*       value_;
+                } Slot;
+
+            private: // Data
+
+                std::vector<Slot> slots_; //!< Table, size is always a power of 2.
+                size_t            mask_;  //!< slots_.size() - 1.
+                size_t            count_; //!< Number of used slots.
+
+            public: // Constructor(s) / Destructor
+
+                Index (const size_t a_capacity = 64);
+                virtual ~Index ();
+
+            public: // Method(s) / Function(s)
+
+                T*     Find    (const uint64_t a_key) const;
+                void   Insert  (const uint64_t a_key, T* a_value);
+                T*     Erase   (const uint64_t a_key);
+                void   Clear   ();
+                size_t size    () const;
+
+                template <typename F>
+                void   ForEach (const F& a_callback) const;
+
+            private: // Method(s) / Function(s)
+
+                size_t Slot4Key (const uint64_t a_key) const;
+                void   Grow     ();
+
+            private: // Static Method(s) / Function(s)
+
+                static uint64_t Mix (uint64_t a_key);
+
+            }; // end of class 'Index'
+
+            /**
+             * @brief Default constructor.
+             *
+             * @param a_capacity Initial capacity, rounded up to a power of 2.
+             */
+            template <typename T>
+            Index<T>::Index (const size_t a_capacity)
+            {
+                size_t capacity = 8;
+                while ( capacity < a_capacity ) {
+                    capacity <<= 1;
+                }
+                slots_.resize(capacity, Slot{ 0, nullptr });
+                mask_  = capacity - 1;
+                count_ = 0;
+            }
+
+            /**
+             * @brief Destructor.
+             */
+            template <typename T>
+            Index<T>::~Index ()
+            {
+                /* empty */
+            }
+
+            /**
+             * @brief Search for a value.
+             *
+             * @param a_key REDIS job number.
+             *
+             * @return Value or nullptr if not found.
+             */
+            template <typename T>
+            inline T* Index<T>::Find (const uint64_t a_key) const
+            {
+                const Slot& slot = slots_[Slot4Key(a_key)];
+                return slot.value_;
+            }
+
+            /**
+             * @brief Insert or replace a value.
+             *
+             * @param a_key   REDIS job number.
+             * @param a_value Non-owned pointer, can't be nullptr.
+             */
+            template <typename T>
+            inline void Index<T>::Insert (const uint64_t a_key, T* a_value)
+            {
+                // ... keep load factor below 50% ...
+                if ( ( count_ + 1 ) * 2 > slots_.size() ) {
+                    Grow();
+                }
+                Slot& slot = slots_[Slot4Key(a_key)];
+                if ( nullptr == slot.value_ ) {
+                    count_++;
+                }
+                slot.key_   = a_key;
+                slot.value_ = a_value;
+            }
+
+            /**
+             * @brief Remove a value.
+             *
+             * @param a_key REDIS job number.
+             *
+             * @return Removed value or nullptr if not found.
+             */
+            template <typename T>
+            inline T* Index<T>::Erase (const uint64_t a_key)
+            {
+                size_t hole  = Slot4Key(a_key);
+                T*     value = slots_[hole].value_;
+                if ( nullptr == value ) {
+                    return nullptr;
+                }
+                // ... backward shift deletion, no tombstones ...
+                size_t idx = hole;
+                while ( true ) {
+                    idx = ( idx + 1 ) & mask_;
+                    if ( nullptr == slots_[idx].value_ ) {
+                        break;
+                    }
+                    const size_t home = static_cast<size_t>(Mix(slots_[idx].key_)) & mask_;
+                    // ... can entry at idx be moved to the hole ( is home cyclically outside ]hole, idx] ) ?
+                    if ( ( hole <= idx ) ? ( home <= hole || home > idx ) : ( home <= hole && home > idx ) ) {
+                        slots_[hole] = slots_[idx];
+                        hole         = idx;
+                    }
+                }
+                slots_[hole] = Slot{ 0, nullptr };
+                count_--;
+                return value;
+            }
+
+            /**
+             * @brief Forget all values ( values are NOT released ).
+             */
+            template <typename T>
+            inline void Index<T>::Clear ()
+            {
+                for ( auto& slot : slots_ ) {
+                    slot = Slot{ 0, nullptr };
+                }
+                count_ = 0;
+            }
+
+            /**
+             * @return Number of values.
+             */
+            template <typename T>
+            inline size_t Index<T>::size () const
+            {
+                return count_;
+            }
+
+            /**
+             * @brief Visit all values, table MUST NOT be changed while iterating.
+             *
+             * @param a_callback Function to call for each ( key, value ) pair.
+             */
+            template <typename T>
+            template <typename F>
+            inline void Index<T>::ForEach (const F& a_callback) const
+            {
+                for ( const auto& slot : slots_ ) {
+                    if ( nullptr != slot.value_ ) {
+                        a_callback(slot.key_, slot.value_);
+                    }
+                }
+            }
+
+            /**
+             * @return Slot where a key is or should be placed.
+             */
+            template <typename T>
+            inline size_t Index<T>::Slot4Key (const uint64_t a_key) const
+            {
+                size_t idx = static_cast<size_t>(Mix(a_key)) & mask_;
+                while ( nullptr != slots_[idx].value_ && a_key != slots_[idx].key_ ) {
+                    idx = ( idx + 1 ) & mask_;
+                }
+                return idx;
+            }
+
+            /**
+             * @brief Double table capacity and rehash all values.
+             */
+            template <typename T>
+            inline void Index<T>::Grow ()
+            {
+                std::vector<Slot> old;
+                old.swap(slots_);
+                slots_.resize(old.size() * 2, Slot{ 0, nullptr });
+                mask_ = slots_.size() - 1;
+                for ( const auto& slot : old ) {
+                    if ( nullptr != slot.value_ ) {
+                        slots_[Slot4Key(slot.key_)] = slot;
+                    }
+                }
+            }
+
+            /**
+             * @brief SplitMix64 finalizer, sequential job numbers must not cluster.
+             */
+            template <typename T>
+            inline uint64_t Index<T>::Mix (uint64_t a_key)
+            {
+                a_key ^= a_key >> 30; a_key *= 0xbf58476d1ce4e5b9ULL;
+                a_key ^= a_key >> 27; a_key *= 0x94d049bb133111ebULL;
+                a_key ^= a_key >> 31;
+                return a_key;
+            }
+
+        } // end of namespace 'sequencer'
+
+    } // end of namespace 'job'
+
+} // end of namespace 'casper'
+
+#endif // CASPER_JOB_SEQUENCER_INDEX_H_
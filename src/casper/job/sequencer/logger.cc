@@ -0,0 +1,482 @@
+/**
+ * @file logger.cc
+ *
+ * Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-job-sequencer.
+ *
+ * casper-job-sequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-job-sequencer  is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "casper/job/sequencer/logger.h"
+
+#include <algorithm> // std::min
+#include <cerrno>
+#include <chrono>
+#include <map>
+#include <stdexcept> // std::runtime_error
+#include <vector>
+
+const char    casper::job::sequencer::Logger::sk_magic_[4] = { 'C', 'J', 'S', 'L' };
+const uint8_t casper::job::sequencer::Logger::sk_version_  = 1;
+
+/**
+ * @brief Default constructor.
+ *
+ * @param a_uri      Binary file URI.
+ * @param a_capacity Max. number of pending records, when full new records are dropped.
+ * @param a_max_size Rotate file when it reaches this size, in bytes ( 0 never rotates ).
+ */
+casper::job::sequencer::Logger::Logger (const std::string& a_uri, const size_t a_capacity, const uint64_t a_max_size)
+    : uri_(a_uri), max_size_(a_max_size), records_(a_capacity)
+{
+    running_.store(false);
+    dropped_.store(0);
+    thread_  = nullptr;
+    file_    = nullptr;
+    size_    = 0;
+    next_id_ = 1;
+}
+
+/**
+ * @brief Destructor.
+ */
+casper::job::sequencer::Logger::~Logger ()
+{
+    Stop();
+}
+
+/**
+ * @brief Open binary file and start writer thread.
+ */
+void casper::job::sequencer::Logger::Start ()
+{
+    if ( nullptr != thread_ ) {
+        return;
+    }
+    Open("ab");
+    if ( nullptr == file_ ) {
+        throw std::runtime_error("Unable to open binary log file '" + uri_ + "': " + strerror(errno) + "!");
+    }
+    fflush(file_);
+    running_.store(true);
+    thread_ = new std::thread(&casper::job::sequencer::Logger::Loop, this);
+}
+
+/**
+ * @brief Stop writer thread, pending records are written before returning.
+ */
+void casper::job::sequencer::Logger::Stop ()
+{
+    if ( nullptr == thread_ ) {
+        return;
+    }
+    running_.store(false);
+    thread_->join();
+    delete thread_;
+    thread_ = nullptr;
+    if ( nullptr != file_ ) {
+        fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Open binary file and start a new session.
+ *
+ * @param a_mode fopen mode.
+ */
+void casper::job::sequencer::Logger::Open (const char* const a_mode)
+{
+    // ... string ids are per session ...
+    formats_.clear();
+    steps_.clear();
+    next_id_ = 1;
+    file_ = fopen(uri_.c_str(), a_mode);
+    if ( nullptr == file_ ) {
+        size_ = 0;
+        return;
+    }
+    fseek(file_, 0, SEEK_END);
+    const long size = ftell(file_);
+    size_ = ( size > 0 ? static_cast<uint64_t>(size) : 0 );
+    // ... always start with a header, a file can have several sessions ...
+    fwrite(sk_magic_, sizeof(char), sizeof(sk_magic_), file_);
+    fwrite(&sk_version_, sizeof(sk_version_), 1, file_);
+    size_ += sizeof(sk_magic_) + sizeof(sk_version_);
+}
+
+/**
+ * @brief Writer thread only: move current file to '<uri>.1' ( replacing previous one ) and start a new one.
+ */
+void casper::job::sequencer::Logger::Rotate ()
+{
+    fclose(file_);
+    file_ = nullptr;
+    // ... if rename fails, file is truncated - size must stay bounded ...
+    const std::string rotated = uri_ + ".1";
+    Open(( 0 == rename(uri_.c_str(), rotated.c_str()) ? "ab" : "wb" ));
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Writer thread loop.
+ */
+void casper::job::sequencer::Logger::Loop ()
+{
+    Record record;
+    size_t idle = 0;
+    while ( true ) {
+        if ( true == records_.Pop(record) ) {
+            // ... file could not be reopened on rotation? records are dropped ...
+            if ( nullptr == file_ ) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            Write(record);
+            if ( 0 != max_size_ && size_ >= max_size_ ) {
+                Rotate();
+            }
+            idle = 0;
+            continue;
+        }
+        // ... nothing pending, flush what we've got so far ...
+        if ( 0 == idle && nullptr != file_ ) {
+            fflush(file_);
+        }
+        // ... stop requested and ring drained?
+        if ( false == running_.load() ) {
+            break;
+        }
+        // ... back off up to 10ms, producers never wait for us ...
+        idle = std::min(idle + 1, static_cast<size_t>(10));
+        std::this_thread::sleep_for(std::chrono::milliseconds(idle));
+    }
+    if ( nullptr != file_ ) {
+        fflush(file_);
+    }
+}
+
+/**
+ * @brief Writer thread only: write a record, and the strings it uses if not written yet.
+ *
+ * @param a_record Record to write.
+ */
+void casper::job::sequencer::Logger::Write (const casper::job::sequencer::Logger::Record& a_record)
+{
+    uint32_t format_id;
+    const auto f_it = formats_.find(a_record.format_);
+    if ( formats_.end() == f_it ) {
+        format_id = WriteString(a_record.format_, strlen(a_record.format_));
+        formats_[a_record.format_] = format_id;
+    } else {
+        format_id = f_it->second;
+    }
+
+    uint32_t step_id;
+    const auto s_it = steps_.find(a_record.step_);
+    if ( steps_.end() == s_it ) {
+        step_id = WriteString(a_record.step_, strlen(a_record.step_));
+        steps_[a_record.step_] = step_id;
+    } else {
+        step_id = s_it->second;
+    }
+
+    const char     type   = 'R';
+    const uint32_t length = a_record.args_.length_;
+    fwrite(&type               , sizeof(type)               , 1, file_);
+    fwrite(&a_record.timestamp_, sizeof(a_record.timestamp_), 1, file_);
+    fwrite(&a_record.bjid_     , sizeof(a_record.bjid_)     , 1, file_);
+    fwrite(&a_record.level_    , sizeof(a_record.level_)    , 1, file_);
+    fwrite(&step_id            , sizeof(step_id)            , 1, file_);
+    fwrite(&format_id          , sizeof(format_id)          , 1, file_);
+    fwrite(&length             , sizeof(length)             , 1, file_);
+    fwrite(a_record.args_.data_, sizeof(char), length, file_);
+    size_ += sizeof(type) + sizeof(a_record.timestamp_) + sizeof(a_record.bjid_) + sizeof(a_record.level_)
+           + sizeof(step_id) + sizeof(format_id) + sizeof(length) + length;
+}
+
+/**
+ * @brief Writer thread only: write a string table entry.
+ *
+ * @param a_value  String.
+ * @param a_length String length.
+ *
+ * @return Assigned string id.
+ */
+uint32_t casper::job::sequencer::Logger::WriteString (const char* const a_value, const size_t a_length)
+{
+    const char     type   = 'S';
+    const uint32_t id     = next_id_++;
+    const uint32_t length = static_cast<uint32_t>(a_length);
+    fwrite(&type  , sizeof(type)  , 1, file_);
+    fwrite(&id    , sizeof(id)    , 1, file_);
+    fwrite(&length, sizeof(length), 1, file_);
+    fwrite(a_value, sizeof(char), length, file_);
+    size_ += sizeof(type) + sizeof(id) + sizeof(length) + length;
+    return id;
+}
+
+/**
+ * @return µs since epoch.
+ */
+uint64_t casper::job::sequencer::Logger::Now ()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count()
+    );
+}
+
+#ifdef __APPLE__
+#pragma mark -
+#endif
+
+/**
+ * @brief Decode a binary log file.
+ *
+ * @param a_file     Binary file, positioned at a header.
+ * @param a_callback Function to call for each record.
+ *
+ * @return True if the whole file was decoded, false if it's truncated or corrupted.
+ */
+bool casper::job::sequencer::Logger::Decode (FILE* a_file,
+                                             const std::function<void(const uint64_t a_timestamp, const uint64_t a_bjid, const uint32_t a_level,
+                                                                      const std::string& a_step, const std::string& a_text)>& a_callback)
+{
+    std::map<uint32_t, std::string> strings;
+    std::string                      args;
+    std::string                      text;
+
+    char type;
+    while ( 1 == fread(&type, sizeof(type), 1, a_file) ) {
+        switch (type) {
+            case 'C':
+            {
+                // ... header ( new session ) ...
+                char    magic[sizeof(sk_magic_) - 1];
+                uint8_t version;
+                if ( 1 != fread(magic, sizeof(magic), 1, a_file) || 0 != memcmp(magic, sk_magic_ + 1, sizeof(magic))
+                    || 1 != fread(&version, sizeof(version), 1, a_file) || sk_version_ != version ) {
+                    return false;
+                }
+                strings.clear();
+            }
+                break;
+            case 'S':
+            {
+                uint32_t id, length;
+                if ( 1 != fread(&id, sizeof(id), 1, a_file) || 1 != fread(&length, sizeof(length), 1, a_file) ) {
+                    return false;
+                }
+                std::string& value = strings[id];
+                value.resize(length);
+                if ( length > 0 && 1 != fread(&value[0], length, 1, a_file) ) {
+                    return false;
+                }
+            }
+                break;
+            case 'R':
+            {
+                uint64_t timestamp, bjid;
+                uint32_t level, step_id, format_id, length;
+                if ( 1 != fread(&timestamp, sizeof(timestamp), 1, a_file) || 1 != fread(&bjid, sizeof(bjid), 1, a_file)
+                    || 1 != fread(&level, sizeof(level), 1, a_file) || 1 != fread(&step_id, sizeof(step_id), 1, a_file)
+                    || 1 != fread(&format_id, sizeof(format_id), 1, a_file) || 1 != fread(&length, sizeof(length), 1, a_file) ) {
+                    return false;
+                }
+                args.resize(length);
+                if ( length > 0 && 1 != fread(&args[0], length, 1, a_file) ) {
+                    return false;
+                }
+                const auto s_it = strings.find(step_id);
+                const auto f_it = strings.find(format_id);
+                if ( strings.end() == s_it || strings.end() == f_it ) {
+                    return false;
+                }
+                text.clear();
+                Format(f_it->second, args, text);
+                a_callback(timestamp, bjid, level, s_it->second, text);
+            }
+                break;
+            default:
+                return false;
+        }
+    }
+    return ( 0 != feof(a_file) );
+}
+
+/**
+ * @brief Reproduce printf output from a format and encoded arguments.
+ *
+ * @param a_format printf like format.
+ * @param a_args   Encoded arguments.
+ * @param o_text   Formatted text.
+ */
+void casper::job::sequencer::Logger::Format (const std::string& a_format, const std::string& a_args, std::string& o_text)
+{
+    typedef struct {
+        char     type_;
+        int64_t  i_;
+        uint64_t u_;
+        double   d_;
+        std::string s_;
+    } Arg;
+
+    // ... decode arguments ...
+    std::vector<Arg> args;
+    size_t           pos = 0;
+    while ( pos < a_args.length() ) {
+        Arg arg = { a_args[pos++], 0, 0, 0.0, "" };
+        switch (arg.type_) {
+            case 'i':
+                if ( pos + sizeof(arg.i_) > a_args.length() ) { pos = a_args.length(); continue; }
+                memcpy(&arg.i_, a_args.data() + pos, sizeof(arg.i_)); pos += sizeof(arg.i_);
+                arg.u_ = static_cast<uint64_t>(arg.i_); arg.d_ = static_cast<double>(arg.i_);
+                break;
+            case 'u':
+                if ( pos + sizeof(arg.u_) > a_args.length() ) { pos = a_args.length(); continue; }
+                memcpy(&arg.u_, a_args.data() + pos, sizeof(arg.u_)); pos += sizeof(arg.u_);
+                arg.i_ = static_cast<int64_t>(arg.u_); arg.d_ = static_cast<double>(arg.u_);
+                break;
+            case 'd':
+                if ( pos + sizeof(arg.d_) > a_args.length() ) { pos = a_args.length(); continue; }
+                memcpy(&arg.d_, a_args.data() + pos, sizeof(arg.d_)); pos += sizeof(arg.d_);
+                arg.i_ = static_cast<int64_t>(arg.d_); arg.u_ = static_cast<uint64_t>(arg.d_);
+                break;
+            case 's':
+            {
+                uint32_t length = 0;
+                if ( pos + sizeof(length) > a_args.length() ) { pos = a_args.length(); continue; }
+                memcpy(&length, a_args.data() + pos, sizeof(length)); pos += sizeof(length);
+                if ( pos + length > a_args.length() ) { pos = a_args.length(); continue; }
+                arg.s_ = a_args.substr(pos, length); pos += length;
+            }
+                break;
+            default:
+                // ... corrupted ...
+                pos = a_args.length();
+                continue;
+        }
+        args.push_back(arg);
+    }
+
+    // ... walk format, one conversion at a time ...
+    std::vector<char> buffer(128);
+    const auto print = [&buffer, &o_text] (const std::string& a_spec, const std::function<int(char*, size_t, const char*)>& a_snprintf) {
+        int rv = a_snprintf(buffer.data(), buffer.size(), a_spec.c_str());
+        if ( rv >= static_cast<int>(buffer.size()) ) {
+            buffer.resize(static_cast<size_t>(rv) + 1);
+            rv = a_snprintf(buffer.data(), buffer.size(), a_spec.c_str());
+        }
+        if ( rv > 0 ) {
+            o_text.append(buffer.data(), static_cast<size_t>(rv));
+        }
+    };
+
+    size_t      next = 0;
+    const char* it   = a_format.c_str();
+    while ( '\0' != *it ) {
+        if ( '%' != *it ) {
+            o_text += *(it++);
+            continue;
+        }
+        if ( '%' == *(it + 1) ) {
+            o_text += '%';
+            it += 2;
+            continue;
+        }
+        // ... flags, width and precision are kept, '*' is replaced by argument value ...
+        std::string spec = "%";
+        it++;
+        while ( nullptr != strchr("-+ #0", *it) && '\0' != *it ) {
+            spec += *(it++);
+        }
+        for ( int part = 0 ; part < 2 ; ++part ) {
+            if ( 1 == part ) {
+                if ( '.' != *it ) {
+                    break;
+                }
+                spec += *(it++);
+            }
+            if ( '*' == *it ) {
+                spec += std::to_string(( next < args.size() ? args[next++].i_ : 0 ));
+                it++;
+            } else {
+                while ( *it >= '0' && *it <= '9' ) {
+                    spec += *(it++);
+                }
+            }
+        }
+        // ... length modifiers are dropped, arguments were widened when encoded ...
+        while ( nullptr != strchr("hlLqjzt", *it) && '\0' != *it ) {
+            it++;
+        }
+        const char conversion = *it;
+        if ( '\0' == conversion ) {
+            break;
+        }
+        it++;
+        if ( next >= args.size() ) {
+            o_text += "<?>";
+            continue;
+        }
+        const Arg& arg = args[next++];
+        switch (conversion) {
+            case 'd': case 'i':
+                print(spec + "lld", [&arg] (char* a_buffer, size_t a_size, const char* a_spec) {
+                    return snprintf(a_buffer, a_size, a_spec, static_cast<long long>(arg.i_));
+                });
+                break;
+            case 'u': case 'o': case 'x': case 'X':
+                print(spec + "ll" + conversion, [&arg] (char* a_buffer, size_t a_size, const char* a_spec) {
+                    return snprintf(a_buffer, a_size, a_spec, static_cast<unsigned long long>(arg.u_));
+                });
+                break;
+            case 'c':
+                print(spec + 'c', [&arg] (char* a_buffer, size_t a_size, const char* a_spec) {
+                    return snprintf(a_buffer, a_size, a_spec, static_cast<int>(arg.i_));
+                });
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                print(spec + conversion, [&arg] (char* a_buffer, size_t a_size, const char* a_spec) {
+                    return snprintf(a_buffer, a_size, a_spec, arg.d_);
+                });
+                break;
+            case 's':
+            {
+                const std::string value = ( 's' == arg.type_ ? arg.s_ : ( 'd' == arg.type_ ? std::to_string(arg.d_) : ( 'i' == arg.type_ ? std::to_string(arg.i_) : std::to_string(arg.u_) ) ) );
+                print(spec + 's', [&value] (char* a_buffer, size_t a_size, const char* a_spec) {
+                    return snprintf(a_buffer, a_size, a_spec, value.c_str());
+                });
+            }
+                break;
+            case 'p':
+                print(spec + "llx", [&arg] (char* a_buffer, size_t a_size, const char* a_spec) {
+                    return snprintf(a_buffer, a_size, a_spec, static_cast<unsigned long long>(arg.u_));
+                });
+                break;
+            default:
+                // ... unsupported, keep it as is ...
+                o_text += spec + conversion;
+                break;
+        }
+    }
+}
@@ -0,0 +1,310 @@
+/**
+* @file logger.h
+*
+* Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+*
+* This file is part of casper-job-sequencer.
+*
+* casper-job-sequencer is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Affero General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* casper-job-sequencer  is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU Affero General Public License
+* along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#ifndef CASPER_JOB_SEQUENCER_LOGGER_H_
+#define CASPER_JOB_SEQUENCER_LOGGER_H_
+
+#include "cc/non-movable.h"
+#include "cc/non-copyable.h"
+
+#include "casper/job/sequencer/ring.h"
+
+#include <inttypes.h>    // uint64_t
+#include <stdio.h>       // FILE
+#include <string.h>      // memcpy, strnlen, strncpy
+#include <algorithm>     // std::min
+#include <string>
+#include <atomic>
+#include <functional>    // std::function
+#include <thread>
+#include <type_traits>   // std::enable_if, std::is_integral, ...
+#include <unordered_map>
+
+namespace casper
+{
+
+    namespace job
+    {
+
+        namespace sequencer
+        {
+
+            /**
+             * @brief Asynchronous binary logger.
+             *
+             * Producers only copy a compact record ( timestamp, bjid, level, step, format literal and typed arguments )
+             * into a lock-free ring, formatting is deferred to an offline decoder ( see \link Logger::Decode \link ).
+             * A background thread writes records to a binary file, rotated to '<uri>.1' when it reaches it's maximum size.
+             *
+             * FILE FORMAT ( native endianness ):
+             *
+             * - header: 'C' 'J' 'S' 'L' + version ( 1 byte )
+             * - string: 'S' + id ( uint32 ) + length ( uint32 ) + bytes   - emitted once, before first record that uses it
+             * - record: 'R' + timestamp ( uint64, µs since epoch ) + bjid ( uint64 ) + level ( uint32 ) + step id ( uint32 )
+             *               + format id ( uint32 ) + arguments length ( uint32 ) + arguments
+             *
+             * ARGUMENTS: 'i' + int64, 'u' + uint64, 'd' + double, 's' + length ( uint32 ) + bytes
+             *
+             * Arguments are encoded into a fixed size buffer inside the ring slot, so logging never allocates;
+             * a string that does not fit is truncated and any argument after it is dropped ( decoded as '<?>' ).
+             */
+            class Logger final : public cc::NonMovable, public cc::NonCopyable
+            {
+
+            public: // Static Const Data
+
+                static const char    sk_magic_[4];
+                static const uint8_t sk_version_;
+                static const size_t  sk_args_capacity_ = 224;
+
+            private: // Data Type(s)
+
+                typedef struct {
+                    uint32_t length_;                   //!< Number of bytes used.
+                    bool     full_;                     //!< True when an argument did not fit, following ones are dropped.
+                    char     data_[sk_args_capacity_];  //!< Encoded arguments.
+                } Args;
+
+                typedef struct {
+                    uint64_t    timestamp_;  //!< µs since epoch.
+                    uint64_t    bjid_;       //!< BEANSTALKD job id.
+                    uint32_t    level_;      //!< LOG level.
+                    char        step_[16];   //!< LOG step, copied ( truncated ).
+                    const char* format_;     //!< Format, MUST be a literal.
+                    Args        args_;       //!< Encoded arguments, inline.
+                } Record;
+
+            private: // Data
+
+                const std::string                         uri_;      //!< Binary file URI.
+                const uint64_t                            max_size_; //!< Rotate file when it reaches this size, in bytes ( 0 never rotates ).
+                Ring<Record>                              records_;  //!< Producers -> writer thread hand-off.
+                std::atomic<bool>                         running_;  //!< True while writer thread should keep running.
+                std::atomic<uint64_t>                     dropped_;  //!< Number of records dropped because ring was full.
+                std::thread*                              thread_;   //!< Writer thread.
+                FILE*                                     file_;     //!< Writer thread only: binary file.
+                uint64_t                                  size_;     //!< Writer thread only: binary file size, in bytes.
+                std::unordered_map<const char*, uint32_t> formats_;  //!< Writer thread only: format literal -> string id.
+                std::unordered_map<std::string, uint32_t> steps_;    //!< Writer thread only: step -> string id.
+                uint32_t                                  next_id_;  //!< Writer thread only: next string id.
+
+            public: // Constructor(s) / Destructor
+
+                Logger () = delete;
+                Logger (const std::string& a_uri, const size_t a_capacity = 16384, const uint64_t a_max_size = 0);
+                virtual ~Logger ();
+
+            public: // Method(s) / Function(s)
+
+                void Start ();
+                void Stop  ();
+
+                template <typename... A>
+                void Log (const size_t a_level, const uint64_t a_bjid, const char* const a_step, const char* const a_format, const A... a_args);
+
+                uint64_t dropped () const;
+
+            public: // Static Method(s) / Function(s)
+
+                static bool Decode (FILE* a_file,
+                                    const std::function<void(const uint64_t a_timestamp, const uint64_t a_bjid, const uint32_t a_level,
+                                                             const std::string& a_step, const std::string& a_text)>& a_callback);
+                static void Format (const std::string& a_format, const std::string& a_args, std::string& o_text);
+
+            private: // Method(s) / Function(s)
+
+                void     Open        (const char* const a_mode);
+                void     Rotate      ();
+                void     Loop        ();
+                void     Write       (const Record& a_record);
+                uint32_t WriteString (const char* const a_value, const size_t a_length);
+
+            private: // Static Method(s) / Function(s)
+
+                static uint64_t Now ();
+
+                static void Append (Args& o_args, const char a_type, const void* const a_value, const size_t a_length);
+
+                static void Encode (Args& o_args, const char* const a_value);
+                static void Encode (Args& o_args, const std::string& a_value);
+
+                template <typename T>
+                static typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+                Encode (Args& o_args, const T a_value);
+
+                template <typename T>
+                static typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type
+                Encode (Args& o_args, const T a_value);
+
+                template <typename T>
+                static typename std::enable_if<std::is_floating_point<T>::value>::type
+                Encode (Args& o_args, const T a_value);
+
+                static void EncodeAll (Args& o_args);
+
+                template <typename T, typename... A>
+                static void EncodeAll (Args& o_args, const T& a_value, const A&... a_args);
+
+            }; // end of class 'Logger'
+
+            /**
+             * @brief Enqueue a log record, called from producer(s) thread(s), never blocks.
+             *
+             * @param a_level  LOG level.
+             * @param a_bjid   BEANSTALKD job id.
+             * @param a_step   LOG step.
+             * @param a_format printf like format, MUST be a literal.
+             * @param a_args   Format arguments.
+             */
+            template <typename... A>
+            inline void Logger::Log (const size_t a_level, const uint64_t a_bjid, const char* const a_step, const char* const a_format, const A... a_args)
+            {
+                Record record;
+                record.timestamp_ = Now();
+                record.bjid_      = a_bjid;
+                record.level_     = static_cast<uint32_t>(a_level);
+                record.format_    = a_format;
+                strncpy(record.step_, ( nullptr != a_step ? a_step : "" ), sizeof(record.step_) - 1);
+                record.step_[sizeof(record.step_) - 1] = '\0';
+                record.args_.length_ = 0;
+                record.args_.full_   = false;
+                EncodeAll(record.args_, a_args...);
+                // ... full? drop it, logging must not add latency to caller ...
+                if ( false == records_.Push(std::move(record)) ) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+
+            /**
+             * @return Number of records dropped so far.
+             */
+            inline uint64_t Logger::dropped () const
+            {
+                return dropped_.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Append a fixed size argument, or mark arguments as full if it does not fit.
+             *
+             * @param o_args   Encoded arguments.
+             * @param a_type   Argument type.
+             * @param a_value  Argument value.
+             * @param a_length Argument value length, in bytes.
+             */
+            inline void Logger::Append (Args& o_args, const char a_type, const void* const a_value, const size_t a_length)
+            {
+                if ( true == o_args.full_ || o_args.length_ + sizeof(a_type) + a_length > sizeof(o_args.data_) ) {
+                    o_args.full_ = true;
+                    return;
+                }
+                o_args.data_[o_args.length_] = a_type;
+                memcpy(o_args.data_ + o_args.length_ + sizeof(a_type), a_value, a_length);
+                o_args.length_ += static_cast<uint32_t>(sizeof(a_type) + a_length);
+            }
+
+            /**
+             * @brief Encode a string argument, truncated to the available space.
+             */
+            inline void Logger::Encode (Args& o_args, const char* const a_value)
+            {
+                const size_t header = sizeof(char) + sizeof(uint32_t);
+                if ( true == o_args.full_ || o_args.length_ + header > sizeof(o_args.data_) ) {
+                    o_args.full_ = true;
+                    return;
+                }
+                const size_t      available = sizeof(o_args.data_) - o_args.length_ - header;
+                const char* const value     = ( nullptr != a_value ? a_value : "(null)" );
+                const uint32_t    length    = static_cast<uint32_t>(strnlen(value, available + 1));
+                const uint32_t    copied    = std::min(length, static_cast<uint32_t>(available));
+                o_args.data_[o_args.length_] = 's';
+                memcpy(o_args.data_ + o_args.length_ + sizeof(char), &copied, sizeof(copied));
+                memcpy(o_args.data_ + o_args.length_ + header, value, copied);
+                o_args.length_ += static_cast<uint32_t>(header + copied);
+                // ... truncated? no room left for following arguments ...
+                o_args.full_ = ( copied < length );
+            }
+
+            /**
+             * @brief Encode a string argument.
+             */
+            inline void Logger::Encode (Args& o_args, const std::string& a_value)
+            {
+                Encode(o_args, a_value.c_str());
+            }
+
+            /**
+             * @brief Encode a signed integer argument.
+             */
+            template <typename T>
+            inline typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+            Logger::Encode (Args& o_args, const T a_value)
+            {
+                const int64_t value = static_cast<int64_t>(a_value);
+                Append(o_args, 'i', &value, sizeof(value));
+            }
+
+            /**
+             * @brief Encode an unsigned integer argument.
+             */
+            template <typename T>
+            inline typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type
+            Logger::Encode (Args& o_args, const T a_value)
+            {
+                const uint64_t value = static_cast<uint64_t>(a_value);
+                Append(o_args, 'u', &value, sizeof(value));
+            }
+
+            /**
+             * @brief Encode a floating point argument.
+             */
+            template <typename T>
+            inline typename std::enable_if<std::is_floating_point<T>::value>::type
+            Logger::Encode (Args& o_args, const T a_value)
+            {
+                const double value = static_cast<double>(a_value);
+                Append(o_args, 'd', &value, sizeof(value));
+            }
+
+            /**
+             * @brief Recursion terminator.
+             */
+            inline void Logger::EncodeAll (Args& /* o_args */)
+            {
+                /* empty */
+            }
+
+            /**
+             * @brief Encode all arguments, in order.
+             */
+            template <typename T, typename... A>
+            inline void Logger::EncodeAll (Args& o_args, const T& a_value, const A&... a_args)
+            {
+                Encode(o_args, a_value);
+                EncodeAll(o_args, a_args...);
+            }
+
+        } // end of namespace 'sequencer'
+
+    } // end of namespace 'job'
+
+} // end of namespace 'casper'
+
+#endif // CASPER_JOB_SEQUENCER_LOGGER_H_
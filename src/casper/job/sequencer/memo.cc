@@ -0,0 +1,127 @@
+/**
+ * @file memo.cc
+ *
+ * Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-job-sequencer.
+ *
+ * casper-job-sequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-job-sequencer  is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "casper/job/sequencer/memo.h"
+
+#include "casper/job/sequencer/stats.h"
+
+/**
+ * @brief Default constructor.
+ */
+casper::job::sequencer::Memo::Memo ()
+{
+    /* empty */
+}
+
+/**
+ * @brief Destructor.
+ */
+casper::job::sequencer::Memo::~Memo ()
+{
+    /* empty */
+}
+
+/**
+ * @brief Enable memoization of activities results for a tube.
+ *
+ * @param a_tube        Target tube.
+ * @param a_ttl         Entries TTL, in seconds.
+ * @param a_max_entries Maximum number of entries, oldest ones are evicted first.
+ */
+void casper::job::sequencer::Memo::Enable (const std::string& a_tube, const uint64_t a_ttl, const size_t a_max_entries)
+{
+    Tube& tube = tubes_[a_tube];
+    tube.ttl_         = a_ttl * 1000000;
+    tube.max_entries_ = a_max_entries;
+    tube.entries_.clear();
+    tube.order_.clear();
+}
+
+/**
+ * @brief Lookup a memoized activity response.
+ *
+ * @param a_tube Target tube.
+ * @param a_key  Patched payload hash, as returned by \link Hash \link.
+ * @param a_data Patched payload, as hashed.
+ *
+ * @return Memoized response, nullptr if not found, expired or hash collision - only valid until next \link Put \link call.
+ */
+const Json::Value* casper::job::sequencer::Memo::Get (const std::string& a_tube, const uint64_t a_key, const std::string& a_data)
+{
+    const auto tube = tubes_.find(a_tube);
+    if ( tubes_.end() == tube ) {
+        return nullptr;
+    }
+    const auto entry = tube->second.entries_.find(a_key);
+    if ( tube->second.entries_.end() == entry ) {
+        return nullptr;
+    }
+    // ... same hash, but not the same data?
+    if ( 0 != entry->second.data_.compare(a_data) ) {
+        return nullptr;
+    }
+    // ... expired?
+    if ( entry->second.expires_at_ <= Stats::Now() ) {
+        tube->second.order_.erase(entry->second.order_);
+        tube->second.entries_.erase(entry);
+        return nullptr;
+    }
+    return &entry->second.response_;
+}
+
+/**
+ * @brief Memoize an activity response.
+ *
+ * @param a_tube     Target tube.
+ * @param a_key      Patched payload hash, as returned by \link Hash \link.
+ * @param a_data     Patched payload, as hashed.
+ * @param a_response Activity response.
+ */
+void casper::job::sequencer::Memo::Put (const std::string& a_tube, const uint64_t a_key, const std::string& a_data, const Json::Value& a_response)
+{
+    const auto it = tubes_.find(a_tube);
+    if ( tubes_.end() == it || 0 == it->second.max_entries_ ) {
+        return;
+    }
+    Tube&          tube = it->second;
+    const uint64_t now  = Stats::Now();
+    // ... evict expired entries ...
+    while ( tube.order_.size() > 0 && tube.entries_[tube.order_.front()].expires_at_ <= now ) {
+        tube.entries_.erase(tube.order_.front());
+        tube.order_.pop_front();
+    }
+    // ... already memoized? replace it in place, it's now the newest one ...
+    auto entry = tube.entries_.find(a_key);
+    if ( tube.entries_.end() != entry ) {
+        tube.order_.erase(entry->second.order_);
+    } else {
+        // ... full? evict oldest ones ...
+        while ( tube.order_.size() > 0 && tube.entries_.size() >= tube.max_entries_ ) {
+            tube.entries_.erase(tube.order_.front());
+            tube.order_.pop_front();
+        }
+        entry = tube.entries_.insert(std::make_pair(a_key, Entry())).first;
+    }
+    entry->second.expires_at_ = now + tube.ttl_;
+    entry->second.data_       = a_data;
+    entry->second.response_   = a_response;
+    entry->second.order_      = tube.order_.insert(tube.order_.end(), a_key);
+}
@@ -0,0 +1,123 @@
+/**
+* @file memo.h
+*
+* Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+*
+* This file is part of casper-job-sequencer.
+*
+* casper-job-sequencer is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Affero General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* casper-job-sequencer  is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU Affero General Public License
+* along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#ifndef CASPER_JOB_SEQUENCER_MEMO_H_
+#define CASPER_JOB_SEQUENCER_MEMO_H_
+
+#include "cc/non-movable.h"
+#include "cc/non-copyable.h"
+
+#include "json/json.h"
+
+#include <inttypes.h> // uint64_t
+#include <list>
+#include <map>
+#include <string>
+
+namespace casper
+{
+
+    namespace job
+    {
+
+        namespace sequencer
+        {
+
+            /**
+             * @brief Per target tube activities results cache, keyed by patched payload hash - hashed data is kept and compared on lookup.
+             *
+             * Not thread safe, expected to be used only at the looper thread.
+             */
+            class Memo final : public cc::NonMovable, public cc::NonCopyable
+            {
+
+            private: // Data Type(s)
+
+                typedef struct {
+                    uint64_t                      expires_at_; //!< As returned by \link Stats::Now \link.
+                    std::string                   data_;       //!< Hashed data, a different one with the same hash is a miss.
+                    Json::Value                   response_;   //!< Activity response.
+                    std::list<uint64_t>::iterator order_;      //!< This entry key position at \link Tube::order_ \link.
+                } Entry;
+
+                typedef struct {
+                    uint64_t                  ttl_;         //!< Entries TTL, in microseconds.
+                    size_t                    max_entries_; //!< Maximum number of entries.
+                    std::map<uint64_t, Entry> entries_;     //!< Key -> entry.
+                    std::list<uint64_t>       order_;       //!< Keys of all entries, by write ( and expiration ) order - always in sync with entries_.
+                } Tube;
+
+            private: // Data
+
+                std::map<std::string, Tube> tubes_; //!< Tube -> cache, only for memoized tubes.
+
+            public: // Constructor(s) / Destructor
+
+                Memo ();
+                virtual ~Memo ();
+
+            public: // Method(s) / Function(s)
+
+                void               Enable  (const std::string& a_tube, const uint64_t a_ttl, const size_t a_max_entries);
+                bool               Enabled (const std::string& a_tube) const;
+                const Json::Value* Get     (const std::string& a_tube, const uint64_t a_key, const std::string& a_data);
+                void               Put     (const std::string& a_tube, const uint64_t a_key, const std::string& a_data, const Json::Value& a_response);
+
+            public: // Static Method(s) / Function(s)
+
+                static uint64_t Hash (const std::string& a_data);
+
+            }; // end of class 'Memo'
+
+            /**
+             * @return True if results of activities for the provided tube are memoized.
+             *
+             * @param a_tube Target tube.
+             */
+            inline bool Memo::Enabled (const std::string& a_tube) const
+            {
+                return ( tubes_.end() != tubes_.find(a_tube) );
+            }
+
+            /**
+             * @brief FNV-1a 64 bits hash, fast and non-cryptographic.
+             *
+             * @param a_data Data to hash.
+             *
+             * @return Hash, never 0.
+             */
+            inline uint64_t Memo::Hash (const std::string& a_data)
+            {
+                uint64_t hash = 14695981039346656037ULL;
+                for ( const char c : a_data ) {
+                    hash ^= static_cast<uint64_t>(static_cast<unsigned char>(c));
+                    hash *= 1099511628211ULL;
+                }
+                return ( 0 != hash ? hash : 1 );
+            }
+
+        } // end of namespace 'sequencer'
+
+    } // end of namespace 'job'
+
+} // end of namespace 'casper'
+
+#endif // CASPER_JOB_SEQUENCER_MEMO_H_
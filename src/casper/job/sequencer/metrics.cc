@@ -0,0 +1,174 @@
+/**
+ * @file metrics.cc
+ *
+ * Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-job-sequencer.
+ *
+ * casper-job-sequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-job-sequencer  is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "casper/job/sequencer/metrics.h"
+
+#include <stdio.h>  // fopen, fprintf, rename
+#include <string.h> // strerror
+#include <errno.h>
+
+#define CASPER_JOB_SEQUENCER_METRICS_PREFIX "casper_job_sequencer_"
+
+const char* const casper::job::sequencer::Metrics::sk_counters_names_[casper::job::sequencer::Metrics::sk_counters_count_] = {
+    "activities_launched_total",
+    "activities_returned_total",
+    "activities_timed_out_total",
+    "activities_cancelled_total",
+    "activities_aborted_total",
+    "activities_skipped_total",
+    "activities_hedged_total",
+    "activities_retried_total",
+    "activities_memo_hits_total",
+    "activities_memo_misses_total"
+};
+
+const char* const casper::job::sequencer::Metrics::sk_counters_help_[casper::job::sequencer::Metrics::sk_counters_count_] = {
+    "Activities launched, per target tube.",
+    "Activities returned, per target tube.",
+    "Activities timed-out, per target tube.",
+    "Activities cancelled, per target tube.",
+    "Activities aborted by 'abort_expr', per target tube.",
+    "Activities skipped by 'skip_if' or 'next_if', per target tube.",
+    "Activities duplicate attempts launched by 'hedge', per target tube.",
+    "Activities relaunched by 'retry', per target tube.",
+    "Activities results reused from memoization cache, per target tube.",
+    "Activities results not found at memoization cache, per target tube."
+};
+
+const char* const casper::job::sequencer::Metrics::sk_latencies_names_[casper::job::sequencer::Metrics::sk_latencies_count_] = {
+    "v8_evaluation_seconds",
+    "postgresql_round_trip_seconds",
+    "redis_round_trip_seconds"
+};
+
+const char* const casper::job::sequencer::Metrics::sk_latencies_help_[casper::job::sequencer::Metrics::sk_latencies_count_] = {
+    "V8 expressions evaluation time.",
+    "PostgreSQL queries round-trip time.",
+    "REDIS commands round-trip time."
+};
+
+/**
+ * @brief Default constructor.
+ */
+casper::job::sequencer::Metrics::Metrics ()
+{
+    for ( auto& latency : latencies_ ) {
+        latency.count_.store(0, std::memory_order_relaxed);
+        latency.sum_.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Destructor.
+ */
+casper::job::sequencer::Metrics::~Metrics ()
+{
+    for ( auto it : tubes_ ) {
+        delete it.second;
+    }
+}
+
+/**
+ * @brief Write all metrics to a file, in Prometheus text exposition format.
+ *
+ * File is first written to '<uri>.tmp' and then renamed, so readers never see a partial file.
+ *
+ * @param a_uri    File URI.
+ * @param a_gauges Current gauges values.
+ * @param o_error  Set with error message, when writing fails.
+ *
+ * @return True on success, false otherwise.
+ */
+bool casper::job::sequencer::Metrics::Write (const std::string& a_uri, const casper::job::sequencer::Metrics::Gauges& a_gauges,
+                                             std::string& o_error) const
+{
+    const std::string tmp = a_uri + ".tmp";
+
+    FILE* file = fopen(tmp.c_str(), "w");
+    if ( nullptr == file ) {
+        o_error = "unable to open '" + tmp + "': " + strerror(errno);
+        return false;
+    }
+
+    // ... gauges ...
+    const struct {
+        const char* const name_;
+        const char* const help_;
+        const size_t      value_;
+    } gauges[3] = {
+        { "running_sequences" , "Sequences in-flight."                     , a_gauges.running_sequences_  },
+        { "running_activities", "Activities in-flight."                    , a_gauges.running_activities_ },
+        { "queue_depth"       , "Messages pending at looper thread queue." , a_gauges.queue_depth_        }
+    };
+    for ( const auto& gauge : gauges ) {
+        fprintf(file,
+                "# HELP " CASPER_JOB_SEQUENCER_METRICS_PREFIX "%s %s\n"
+                "# TYPE " CASPER_JOB_SEQUENCER_METRICS_PREFIX "%s gauge\n"
+                CASPER_JOB_SEQUENCER_METRICS_PREFIX "%s %zu\n",
+                gauge.name_, gauge.help_, gauge.name_, gauge.name_, gauge.value_
+        );
+    }
+
+    // ... per tube counters ...
+    for ( size_t idx = 0 ; idx < sk_counters_count_ ; ++idx ) {
+        fprintf(file,
+                "# HELP " CASPER_JOB_SEQUENCER_METRICS_PREFIX "%s %s\n"
+                "# TYPE " CASPER_JOB_SEQUENCER_METRICS_PREFIX "%s counter\n",
+                sk_counters_names_[idx], sk_counters_help_[idx], sk_counters_names_[idx]
+        );
+        for ( const auto& it : tubes_ ) {
+            fprintf(file, CASPER_JOB_SEQUENCER_METRICS_PREFIX "%s{tube=\"%s\"} %" PRIu64 "\n",
+                    sk_counters_names_[idx], it.first.c_str(), it.second->values_[idx].load(std::memory_order_relaxed)
+            );
+        }
+    }
+
+    // ... latencies, as summaries without quantiles ...
+    for ( size_t idx = 0 ; idx < sk_latencies_count_ ; ++idx ) {
+        const uint64_t count = latencies_[idx].count_.load(std::memory_order_relaxed);
+        const uint64_t sum   = latencies_[idx].sum_.load(std::memory_order_relaxed);
+        fprintf(file,
+                "# HELP " CASPER_JOB_SEQUENCER_METRICS_PREFIX "%s %s\n"
+                "# TYPE " CASPER_JOB_SEQUENCER_METRICS_PREFIX "%s summary\n"
+                CASPER_JOB_SEQUENCER_METRICS_PREFIX "%s_sum %.6f\n"
+                CASPER_JOB_SEQUENCER_METRICS_PREFIX "%s_count %" PRIu64 "\n",
+                sk_latencies_names_[idx], sk_latencies_help_[idx], sk_latencies_names_[idx],
+                sk_latencies_names_[idx], static_cast<double>(sum) / 1000000.0,
+                sk_latencies_names_[idx], count
+        );
+    }
+
+    const bool failed = ( 0 != ferror(file) );
+    if ( 0 != fclose(file) || true == failed ) {
+        o_error = "unable to write '" + tmp + "'!";
+        (void)remove(tmp.c_str());
+        return false;
+    }
+
+    // ... atomically replace previous file ...
+    if ( 0 != rename(tmp.c_str(), a_uri.c_str()) ) {
+        o_error = "unable to rename '" + tmp + "' to '" + a_uri + "': " + strerror(errno);
+        (void)remove(tmp.c_str());
+        return false;
+    }
+
+    return true;
+}
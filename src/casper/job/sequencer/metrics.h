@@ -0,0 +1,155 @@
+/**
+* @file metrics.h
+*
+* Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+*
+* This file is part of casper-job-sequencer.
+*
+* casper-job-sequencer is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Affero General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* casper-job-sequencer  is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU Affero General Public License
+* along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#ifndef CASPER_JOB_SEQUENCER_METRICS_H_
+#define CASPER_JOB_SEQUENCER_METRICS_H_
+
+#include "cc/non-movable.h"
+#include "cc/non-copyable.h"
+
+#include <inttypes.h> // uint64_t
+#include <stddef.h>   // size_t
+#include <atomic>
+#include <map>
+#include <string>
+
+namespace casper
+{
+
+    namespace job
+    {
+
+        namespace sequencer
+        {
+
+            /**
+             * @brief Prometheus ( text exposition format ) metrics.
+             *
+             * Counters are relaxed atomics, updating them never locks.
+             * Per tube counters are created, and the exposition file is written, only at the looper thread.
+             */
+            class Metrics final : public cc::NonMovable, public cc::NonCopyable
+            {
+
+            public: // Data Type(s)
+
+                enum class Counter : uint8_t {
+                    Launched = 0, //!< Activity launched ( pushed to beanstalkd ).
+                    Returned,     //!< Activity returned ( completed, failed, timed-out or aborted ).
+                    TimedOut,     //!< Activity timed-out.
+                    Cancelled,    //!< Activity cancelled.
+                    Aborted,      //!< Activity aborted by 'abort_expr' evaluation.
+                    Skipped,      //!< Activity skipped by 'skip_if' or 'next_if' evaluation.
+                    Hedged,       //!< Activity duplicate attempt launched ( hedging ).
+                    Retried,      //!< Activity relaunched by it's 'retry' policy.
+                    MemoHit,      //!< Activity result reused from memoization cache.
+                    MemoMiss      //!< Activity result not found at memoization cache.
+                };
+
+                enum class Latency : uint8_t {
+                    V8 = 0,       //!< V8 expressions evaluation.
+                    PostgreSQL,   //!< PostgreSQL round-trip.
+                    Redis         //!< REDIS round-trip.
+                };
+
+                typedef struct {
+                    size_t running_sequences_;  //!< In-flight sequences.
+                    size_t running_activities_; //!< In-flight activities.
+                    size_t queue_depth_;        //!< Main thread -> looper thread pending messages.
+                } Gauges;
+
+            private: // Static Const Data
+
+                static const size_t      sk_counters_count_  = static_cast<size_t>(Counter::MemoMiss) + 1;
+                static const size_t      sk_latencies_count_ = static_cast<size_t>(Latency::Redis) + 1;
+                static const char* const sk_counters_names_[sk_counters_count_];
+                static const char* const sk_counters_help_[sk_counters_count_];
+                static const char* const sk_latencies_names_[sk_latencies_count_];
+                static const char* const sk_latencies_help_[sk_latencies_count_];
+
+            private: // Data Type(s)
+
+                typedef struct {
+                    std::atomic<uint64_t> count_; //!< Number of observations.
+                    std::atomic<uint64_t> sum_;   //!< Sum of all observations, in microseconds.
+                } Observation;
+
+                typedef struct {
+                    std::atomic<uint64_t> values_[sk_counters_count_]; //!< One per \link Counter \link.
+                } Counters;
+
+            private: // Data
+
+                std::map<std::string, Counters*> tubes_;                         //!< Tube -> counters, owned.
+                Observation                      latencies_[sk_latencies_count_];
+
+            public: // Constructor(s) / Destructor
+
+                Metrics ();
+                virtual ~Metrics ();
+
+            public: // Method(s) / Function(s)
+
+                void Count   (const std::string& a_tube, const Counter a_counter);
+                void Observe (const Latency a_latency, const uint64_t a_elapsed);
+                bool Write   (const std::string& a_uri, const Gauges& a_gauges, std::string& o_error) const;
+
+            }; // end of class 'Metrics'
+
+            /**
+             * @brief Increment a per tube counter.
+             *
+             * @param a_tube    Target tube.
+             * @param a_counter One of \link Counter \link.
+             */
+            inline void Metrics::Count (const std::string& a_tube, const Metrics::Counter a_counter)
+            {
+                auto it = tubes_.find(a_tube);
+                if ( tubes_.end() == it ) {
+                    Counters* counters = new Counters();
+                    for ( auto& value : counters->values_ ) {
+                        value.store(0, std::memory_order_relaxed);
+                    }
+                    it = tubes_.insert(std::make_pair(a_tube, counters)).first;
+                }
+                it->second->values_[static_cast<size_t>(a_counter)].fetch_add(1, std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Account for a round-trip / evaluation.
+             *
+             * @param a_latency One of \link Latency \link.
+             * @param a_elapsed Elapsed time, in microseconds.
+             */
+            inline void Metrics::Observe (const Metrics::Latency a_latency, const uint64_t a_elapsed)
+            {
+                Observation& observation = latencies_[static_cast<size_t>(a_latency)];
+                observation.count_.fetch_add(1, std::memory_order_relaxed);
+                observation.sum_.fetch_add(a_elapsed, std::memory_order_relaxed);
+            }
+
+        } // end of namespace 'sequencer'
+
+    } // end of namespace 'job'
+
+} // end of namespace 'casper'
+
+#endif // CASPER_JOB_SEQUENCER_METRICS_H_
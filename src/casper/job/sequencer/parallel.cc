@@ -0,0 +1,105 @@
+/**
+ * @file parallel.cc
+ *
+ * Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-job-sequencer.
+ *
+ * casper-job-sequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-job-sequencer  is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "casper/job/sequencer/parallel.h"
+
+#include "cc/exception.h"
+
+/**
+ * @brief Flatten a sequence 'jobs' array, expanding all parallel groups.
+ *
+ * @param a_jobs Sequence 'jobs' array, as received.
+ * @param o_jobs Set with flattened 'jobs' array, only when at least one group was found.
+ *
+ * @return True if at least one group was found, false otherwise ( o_jobs is untouched ).
+ */
+bool casper::job::sequencer::Parallel::Flatten (const Json::Value& a_jobs, Json::Value& o_jobs)
+{
+    // ... fast path: no groups, nothing to do ...
+    bool found = false;
+    for ( Json::ArrayIndex idx = 0 ; idx < a_jobs.size() ; ++idx ) {
+        if ( true == a_jobs[idx].isObject() && true == a_jobs[idx].isMember("parallel") ) {
+            found = true;
+            break;
+        }
+    }
+    if ( false == found ) {
+        return false;
+    }
+    
+    o_jobs = Json::Value(Json::ValueType::arrayValue);
+    for ( Json::ArrayIndex idx = 0 ; idx < a_jobs.size() ; ++idx ) {
+        const Json::Value& job = a_jobs[idx];
+        if ( false == job.isObject() || false == job.isMember("parallel") ) {
+            o_jobs.append(job);
+            continue;
+        }
+        const Json::Value& members = job["parallel"];
+        if ( false == members.isArray() || 0 == members.size() ) {
+            throw ::cc::Exception("Invalid 'parallel' group at jobs[%u]: a non-empty array is expected!", static_cast<unsigned>(idx));
+        }
+        const Json::ArrayIndex first = o_jobs.size();
+        for ( Json::ArrayIndex member = 0 ; member < members.size() ; ++member ) {
+            if ( false == members[member].isObject() || true == members[member].isMember("parallel") ) {
+                throw ::cc::Exception("Invalid 'parallel' group at jobs[%u]: member #%u is not a job object!",
+                                      static_cast<unsigned>(idx), static_cast<unsigned>(member)
+                );
+            }
+            // ... a 'map' step tracks it's items per sequence, it can't run alongside other activities ...
+            if ( members.size() > 1 && true == members[member].isMember("map") ) {
+                throw ::cc::Exception("Invalid 'parallel' group at jobs[%u]: member #%u is a 'map' step!",
+                                      static_cast<unsigned>(idx), static_cast<unsigned>(member)
+                );
+            }
+            Json::Value& flat = o_jobs.append(members[member]);
+            // ... a single member group is just a job ...
+            if ( members.size() > 1 ) {
+                flat["group"]["first"] = static_cast<Json::UInt>(first);
+                flat["group"]["count"] = static_cast<Json::UInt>(members.size());
+            }
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Read parallel group info from a ( flattened ) job.
+ *
+ * @param a_job   Job object.
+ * @param o_first Set with index of the group first activity.
+ * @param o_count Set with number of activities in group.
+ *
+ * @return True if job belongs to a parallel group, false otherwise.
+ */
+bool casper::job::sequencer::Parallel::Get (const Json::Value& a_job, size_t& o_first, size_t& o_count)
+{
+    if ( false == a_job.isObject() ) {
+        return false;
+    }
+    const Json::Value& group = a_job["group"];
+    if ( false == group.isObject() || false == group["first"].isUInt() || false == group["count"].isUInt() || group["count"].asUInt() < 2 ) {
+        return false;
+    }
+    o_first = static_cast<size_t>(group["first"].asUInt());
+    o_count = static_cast<size_t>(group["count"].asUInt());
+    return true;
+}
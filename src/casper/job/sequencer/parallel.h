@@ -0,0 +1,68 @@
+/**
+* @file parallel.h
+*
+* Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+*
+* This file is part of casper-job-sequencer.
+*
+* casper-job-sequencer is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Affero General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* casper-job-sequencer  is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU Affero General Public License
+* along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#ifndef CASPER_JOB_SEQUENCER_PARALLEL_H_
+#define CASPER_JOB_SEQUENCER_PARALLEL_H_
+
+#include "cc/non-movable.h"
+#include "cc/non-copyable.h"
+
+#include "json/json.h"
+
+#include <stddef.h> // size_t
+
+namespace casper
+{
+
+    namespace job
+    {
+
+        namespace sequencer
+        {
+
+            /**
+             * @brief Parallel ( fan-out / fan-in ) activities groups helpers.
+             *
+             * A sequence 'jobs' entry can be a group, { "parallel": [ <job>, ... ] }, whose jobs are launched together.
+             * Groups are flattened before the sequence is registered, so each job still is one activity, and each
+             * member is tagged with { "group": { "first": <index>, "count": <number of members> } }.
+             */
+            class Parallel final : public cc::NonMovable, public cc::NonCopyable
+            {
+
+            public: // Constructor(s) / Destructor
+
+                Parallel () = delete;
+
+            public: // Static Method(s) / Function(s)
+
+                static bool Flatten (const Json::Value& a_jobs, Json::Value& o_jobs);
+                static bool Get     (const Json::Value& a_job, size_t& o_first, size_t& o_count);
+
+            }; // end of class 'Parallel'
+
+        } // end of namespace 'sequencer'
+
+    } // end of namespace 'job'
+
+} // end of namespace 'casper'
+
+#endif // CASPER_JOB_SEQUENCER_PARALLEL_H_
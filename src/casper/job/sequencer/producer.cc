@@ -0,0 +1,260 @@
+/**
+ * @file producer.cc
+ *
+ * Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-job-sequencer.
+ *
+ * casper-job-sequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-job-sequencer  is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "casper/job/sequencer/producer.h"
+
+#include "cc/exception.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h> // strtoull
+#include <netdb.h>
+#include <string.h> // strerror
+#include <unistd.h> // close
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+const uint32_t casper::job::sequencer::Producer::sk_default_timeout_ms_ = 5000;
+
+/**
+ * @brief Default constructor.
+ */
+casper::job::sequencer::Producer::Producer ()
+    : port_(-1), timeout_(0), fd_(-1)
+{
+    /* empty */
+}
+
+/**
+ * @brief Destructor.
+ */
+casper::job::sequencer::Producer::~Producer ()
+{
+    Disconnect();
+}
+
+/**
+ * @brief Enable this producer, connection is only established on first \link Put \link call.
+ *
+ * @param a_host    BEANSTALKD host.
+ * @param a_port    BEANSTALKD port.
+ * @param a_timeout Connect timeout and max. time without progress while writing / reading, in milliseconds, 0 for \link sk_default_timeout_ms_ \link.
+ */
+void casper::job::sequencer::Producer::Setup (const std::string& a_host, const int a_port, const uint32_t a_timeout)
+{
+    Disconnect();
+    host_    = a_host;
+    port_    = a_port;
+    timeout_ = ( 0 != a_timeout ? a_timeout : sk_default_timeout_ms_ );
+}
+
+/**
+ * @brief Push a batch of jobs, all 'use' and 'put' commands are written while their replies are read, in the same order.
+ *
+ * @param io_jobs Jobs to push, on return each one has it's id set, it's error message set ( NOT inserted ) or it's
+ *                outcome is unknown ( written, but connection failed before it's reply ).
+ */
+void casper::job::sequencer::Producer::Put (std::vector<casper::job::sequencer::Producer::Job>& io_jobs)
+{
+    if ( 0 == io_jobs.size() ) {
+        return;
+    }
+    // ... expected replies, in commands order ...
+    typedef struct {
+        size_t job_; //!< Job index, npos for a 'use' reply.
+        size_t end_; //!< Offset, in commands, right after the command.
+    } Reply;
+    std::string        commands;
+    std::vector<Reply> replies;
+    replies.reserve(io_jobs.size() * 2);
+    // ... ( a new connection always starts with a 'use' command, used_ is empty until connected ) ...
+    std::string used = used_;
+    for ( size_t idx = 0 ; idx < io_jobs.size() ; ++idx ) {
+        const Job& job = io_jobs[idx];
+        if ( 0 != used.compare(*job.tube_) ) {
+            used = *job.tube_;
+            commands += "use " + used + "\r\n";
+            replies.push_back({ std::string::npos, commands.length() });
+        }
+        commands += "put " + std::to_string(job.priority_) + ' ' + std::to_string(job.delay_) + ' ' + std::to_string(job.ttr_) + ' ' + std::to_string(job.payload_->length()) + "\r\n";
+        commands += *job.payload_;
+        commands += "\r\n";
+        replies.push_back({ idx, commands.length() });
+    }
+    size_t written = 0;
+    size_t replied = 0;
+    try {
+        // ... connect, if needed ...
+        if ( -1 == fd_ ) {
+            Connect();
+        }
+        // ... write commands while reading replies, so neither side blocks on a full buffer ...
+        while ( replied < replies.size() ) {
+            short revents = 0;
+            Wait(static_cast<short>(POLLIN | ( written < commands.length() ? POLLOUT : 0 )), revents);
+            if ( 0 != ( revents & POLLOUT ) ) {
+                const ssize_t rv = send(fd_, commands.data() + written, commands.length() - written, MSG_NOSIGNAL | MSG_DONTWAIT);
+                if ( rv < 0 && EINTR != errno && EAGAIN != errno && EWOULDBLOCK != errno ) {
+                    throw ::cc::Exception("Unable to write to beanstalkd: %s!", strerror(errno));
+                }
+                written += static_cast<size_t>(rv > 0 ? rv : 0);
+            }
+            if ( 0 != ( revents & ( POLLIN | POLLHUP | POLLERR ) ) ) {
+                char          chunk[512];
+                const ssize_t rv = recv(fd_, chunk, sizeof(chunk), MSG_DONTWAIT);
+                if ( 0 == rv || ( rv < 0 && EINTR != errno && EAGAIN != errno && EWOULDBLOCK != errno ) ) {
+                    throw ::cc::Exception("Unable to read from beanstalkd: %s!", ( 0 == rv ? "connection closed" : strerror(errno) ));
+                }
+                buffer_.append(chunk, static_cast<size_t>(rv > 0 ? rv : 0));
+            }
+            // ... consume complete replies ...
+            size_t pos;
+            while ( replied < replies.size() && std::string::npos != ( pos = buffer_.find("\r\n") ) ) {
+                const std::string line = buffer_.substr(0, pos);
+                buffer_.erase(0, pos + 2);
+                const Reply& reply = replies[replied];
+                if ( std::string::npos == reply.job_ ) {
+                    // ... a 'use' is always followed by a 'put' ...
+                    const std::string& tube = *io_jobs[replies[replied + 1].job_].tube_;
+                    if ( 0 != line.compare(0, 6, "USING ") ) {
+                        throw ::cc::Exception("Unable to use beanstalkd tube '%s': %s!", tube.c_str(), line.c_str());
+                    }
+                    used_ = tube;
+                } else if ( 0 == line.compare(0, 9, "INSERTED ") ) {
+                    io_jobs[reply.job_].id_    = static_cast<uint64_t>(strtoull(line.c_str() + 9, nullptr, 10));
+                } else {
+                    io_jobs[reply.job_].error_ = "Unable to push job to beanstalkd: " + line + '!';
+                }
+                ++replied;
+            }
+        }
+    } catch (const ::cc::Exception& a_cc_exception) {
+        // ... connection is no longer usable ...
+        Disconnect();
+        // ... jobs not replied to: fully written ones might have been inserted, others were not ...
+        for ( size_t idx = replied ; idx < replies.size() ; ++idx ) {
+            const Reply& reply = replies[idx];
+            if ( std::string::npos == reply.job_ ) {
+                continue;
+            }
+            if ( reply.end_ <= written ) {
+                io_jobs[reply.job_].unknown_ = true;
+            } else {
+                io_jobs[reply.job_].error_   = a_cc_exception.what();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Connect to BEANSTALKD, socket is left in non-blocking mode.
+ */
+void casper::job::sequencer::Producer::Connect ()
+{
+    struct addrinfo  hints;
+    struct addrinfo* result = nullptr;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    const int rv = getaddrinfo(host_.c_str(), std::to_string(port_).c_str(), &hints, &result);
+    if ( 0 != rv ) {
+        throw ::cc::Exception("Unable to resolve beanstalkd host '%s': %s!", host_.c_str(), gai_strerror(rv));
+    }
+    int error = ECONNREFUSED;
+    for ( struct addrinfo* it = result ; nullptr != it && -1 == fd_ ; it = it->ai_next ) {
+        fd_ = socket(it->ai_family, it->ai_socktype, it->ai_protocol);
+        if ( -1 == fd_ ) {
+            error = errno;
+            continue;
+        }
+        // ... connect, without waiting longer than timeout ...
+        (void)fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL, 0) | O_NONBLOCK);
+        if ( 0 != connect(fd_, it->ai_addr, it->ai_addrlen) ) {
+            error = errno;
+            if ( EINPROGRESS == error ) {
+                struct pollfd pfd = { fd_, POLLOUT, 0 };
+                int           prv;
+                while ( -1 == ( prv = poll(&pfd, 1, static_cast<int>(timeout_)) ) && EINTR == errno ) {
+                    /* retry */
+                }
+                socklen_t length = sizeof(error);
+                if ( 1 != prv ) {
+                    error = ( 0 == prv ? ETIMEDOUT : errno );
+                } else if ( 0 != getsockopt(fd_, SOL_SOCKET, SO_ERROR, &error, &length) ) {
+                    error = errno;
+                }
+            }
+            if ( 0 != error ) {
+                close(fd_);
+                fd_ = -1;
+            }
+        }
+    }
+    freeaddrinfo(result);
+    if ( -1 == fd_ ) {
+        throw ::cc::Exception("Unable to connect to beanstalkd @ %s:%d: %s!", host_.c_str(), port_, strerror(error));
+    }
+    // ... small writes must not wait for previous ones to be acknowledged ...
+    const int one = 1;
+    (void)setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    // ... a new connection starts using 'default' tube ...
+    used_ = "default";
+    buffer_.clear();
+}
+
+/**
+ * @brief Close connection to BEANSTALKD, if any.
+ */
+void casper::job::sequencer::Producer::Disconnect ()
+{
+    if ( -1 != fd_ ) {
+        close(fd_);
+        fd_ = -1;
+    }
+    used_.clear();
+    buffer_.clear();
+}
+
+/**
+ * @brief Wait until socket is ready, for no longer than timeout.
+ *
+ * @param a_events  Events to wait for, POLLIN and / or POLLOUT.
+ * @param o_revents Events that occurred.
+ */
+void casper::job::sequencer::Producer::Wait (const short a_events, short& o_revents)
+{
+    struct pollfd pfd = { fd_, a_events, 0 };
+    int           rv;
+    while ( -1 == ( rv = poll(&pfd, 1, static_cast<int>(timeout_)) ) && EINTR == errno ) {
+        /* retry */
+    }
+    if ( rv < 0 ) {
+        throw ::cc::Exception("Unable to wait for beanstalkd: %s!", strerror(errno));
+    }
+    if ( 0 == rv ) {
+        throw ::cc::Exception("Timed out after %u ms waiting for beanstalkd!", static_cast<unsigned>(timeout_));
+    }
+    o_revents = pfd.revents;
+}
@@ -0,0 +1,109 @@
+/**
+* @file producer.h
+*
+* Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+*
+* This file is part of casper-job-sequencer.
+*
+* casper-job-sequencer is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Affero General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* casper-job-sequencer  is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU Affero General Public License
+* along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#ifndef CASPER_JOB_SEQUENCER_PRODUCER_H_
+#define CASPER_JOB_SEQUENCER_PRODUCER_H_
+
+#include "cc/non-movable.h"
+#include "cc/non-copyable.h"
+
+#include <inttypes.h> // uint32_t, uint64_t
+#include <string>
+#include <vector>
+
+namespace casper
+{
+
+    namespace job
+    {
+
+        namespace sequencer
+        {
+
+            /**
+             * @brief Pipelined BEANSTALKD producer, a batch of 'put' commands is written while replies are read ( non-blocking socket ).
+             *
+             * Not thread safe, expected to be used only at the looper thread - it blocks it, as a push would, but never longer
+             * than it's timeout without progress.
+             */
+            class Producer final : public cc::NonMovable, public cc::NonCopyable
+            {
+
+            public: // Data Type(s)
+
+                typedef struct {
+                    const std::string* tube_;     //!< Target tube, MUST be kept alive until \link Put \link returns.
+                    const std::string* payload_;  //!< Job payload, MUST be kept alive until \link Put \link returns.
+                    uint32_t           priority_; //!< Priority, lower is more urgent.
+                    uint32_t           delay_;    //!< Delay, in seconds, before job is ready.
+                    uint32_t           ttr_;      //!< Time to run, in seconds.
+                    uint64_t           id_;       //!< BEANSTALKD job id, set on success.
+                    std::string        error_;    //!< Error message, set when job was NOT inserted.
+                    bool               unknown_;  //!< True when job was written but connection failed before it's reply, it might have been inserted.
+                } Job;
+
+            public: // Static Const Data
+
+                static const uint32_t sk_default_timeout_ms_; //!< Used when no timeout is provided, there's always one.
+
+            private: // Data
+
+                std::string host_;    //!< BEANSTALKD host.
+                int         port_;    //!< BEANSTALKD port, -1 if not enabled.
+                uint32_t    timeout_; //!< Connect timeout and max. time without progress while writing / reading, in milliseconds.
+                int         fd_;      //!< Socket, -1 if not connected.
+                std::string used_;    //!< Tube currently in use by this connection.
+                std::string buffer_;  //!< Received data, not consumed yet.
+
+            public: // Constructor(s) / Destructor
+
+                Producer ();
+                virtual ~Producer ();
+
+            public: // Method(s) / Function(s)
+
+                void Setup   (const std::string& a_host, const int a_port, const uint32_t a_timeout);
+                bool Enabled () const;
+                void Put     (std::vector<Job>& io_jobs);
+
+            private: // Method(s) / Function(s)
+
+                void Connect    ();
+                void Disconnect ();
+                void Wait       (const short a_events, short& o_revents);
+
+            }; // end of class 'Producer'
+
+            /**
+             * @return True if \link Setup \link was called with a valid port.
+             */
+            inline bool Producer::Enabled () const
+            {
+                return ( port_ > 0 );
+            }
+
+        } // end of namespace 'sequencer'
+
+    } // end of namespace 'job'
+
+} // end of namespace 'casper'
+
+#endif // CASPER_JOB_SEQUENCER_PRODUCER_H_
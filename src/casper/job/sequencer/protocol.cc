@@ -0,0 +1,264 @@
+/**
+ * @file protocol.cc
+ *
+ * Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-job-sequencer.
+ *
+ * casper-job-sequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-job-sequencer  is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "casper/job/sequencer/protocol.h"
+
+#include "cc/exception.h"
+#include "cc/types.h"
+
+#include <string.h> // strncmp
+
+
+/**
+ * @brief Extract body from a primitive protocol message.
+ *
+ * Expecting: *<status-code-int-value>,<content-type-length-in-bytes>,<content-type-string-value>,<body-length-bytes>,<body>
+ *
+ * Message is tokenized in one pass, never reading past it's end, and declared lengths are validated against the buffer size.
+ *
+ * @param a_message Message to unwrap.
+ * @param o_body    Set with a pointer to the first body byte ( inside a_message, no copies are made ).
+ * @param o_length  Set with body length, in bytes.
+ */
+void casper::job::sequencer::Protocol::Unwrap (const std::string& a_message, const char*& o_body, size_t& o_length)
+{
+    const char*       ptr = a_message.data();
+    const char* const end = ptr + a_message.size();
+    if ( ptr == end || '*' != *ptr ) {
+        throw ::cc::Exception("Invalid message: '%s' - not a primitive protocol message!", a_message.c_str());
+    }
+    ++ptr;
+    // ... status code - IGNORED ...
+    (void)ReadField(ptr, end, 0);
+    // ... content-type - IGNORED - EXPECTING JSON ...
+    const size_t content_type_length = ReadField(ptr, end, 1);
+    if ( content_type_length >= static_cast<size_t>(end - ptr) || ',' != ptr[content_type_length] ) {
+        throw ::cc::Exception("Invalid message: invalid field #'" SIZET_FMT "' value read from primitive protocol message!", static_cast<size_t>(1));
+    }
+    ptr += content_type_length + 1;
+    // ... body ...
+    const size_t body_length = ReadField(ptr, end, 2);
+    if ( body_length > static_cast<size_t>(end - ptr) ) {
+        throw ::cc::Exception("Invalid message: invalid field #'" SIZET_FMT "' value read from primitive protocol message!", static_cast<size_t>(2));
+    }
+    // ... good to go ...
+    o_body   = ptr;
+    o_length = body_length;
+}
+
+/**
+ * @brief Read an unsigned decimal value terminated by ','.
+ *
+ * @param io_ptr  Current position, on success set to the position after ','.
+ * @param a_end   End of buffer.
+ * @param a_field Field index, for error reporting purposes.
+ *
+ * @return Value read.
+ */
+size_t casper::job::sequencer::Protocol::ReadField (const char*& io_ptr, const char* const a_end, const size_t a_field)
+{
+    const char* ptr   = io_ptr;
+    size_t      value = 0;
+    while ( ptr < a_end && *ptr >= '0' && *ptr <= '9' ) {
+        const size_t digit = static_cast<size_t>(*ptr - '0');
+        // ... overflow?
+        if ( value > ( static_cast<size_t>(-1) - digit ) / 10 ) {
+            break;
+        }
+        value = value * 10 + digit;
+        ++ptr;
+    }
+    // ... at least one digit and ',' are required ...
+    if ( ptr == io_ptr || ptr >= a_end || ',' != *ptr ) {
+        if ( 0 == a_field ) {
+            throw ::cc::Exception("Invalid message: unable to read '%s' from primitive protocol message!", "status code");
+        }
+        throw ::cc::Exception("Invalid message: unable to read field #'" SIZET_FMT "' from primitive protocol message!", a_field);
+    }
+    io_ptr = ptr + 1;
+    return value;
+}
+
+/**
+ * @brief Extract top level 'status' string value from a JSON object without building a DOM.
+ *
+ * The whole document is scanned in a single pass, nested values are skipped but containers must be balanced, strings
+ * terminated, top level keys followed by ':', literals must be 'true', 'false' or 'null', numbers made of number
+ * characters and nothing but whitespace may follow the object. As a full parse does, the last top level 'status' wins.
+ *
+ * @param a_body   JSON object text.
+ * @param a_length JSON object text length, in bytes.
+ * @param o_status Set with 'status' value, when found.
+ *
+ * @return True if the document looks well formed and it's last top level 'status' is a string without escape sequences,
+ *         false otherwise - in that case a full parse is required to decide.
+ */
+bool casper::job::sequencer::Protocol::PeekStatus (const char* const a_body, const size_t a_length, std::string& o_status)
+{
+    const char*       ptr     = a_body;
+    const char* const end     = a_body + a_length;
+    char              open[64];
+    size_t            depth   = 0;
+    bool              key     = false;
+    bool              escaped = false;
+    const char*       status  = nullptr;
+    size_t            length  = 0;
+    // ... must be an object ...
+    while ( ptr < end && ( ' ' == *ptr || '\t' == *ptr || '\r' == *ptr || '\n' == *ptr ) ) {
+        ++ptr;
+    }
+    if ( ptr >= end || '{' != *ptr ) {
+        return false;
+    }
+    open[depth++] = *ptr;
+    key           = true;
+    ++ptr;
+    // ... single pass, until object is closed ...
+    while ( ptr < end && 0 != depth ) {
+        switch ( *ptr ) {
+            case '"':
+            {
+                const char* const start = ptr + 1;
+                if ( false == SkipString(ptr, end, escaped) ) {
+                    return false;
+                }
+                // ... top level key?
+                if ( 1 == depth && true == key ) {
+                    // ... an escaped key might still be 'status' ...
+                    if ( true == escaped ) {
+                        return false;
+                    }
+                    const size_t key_length = static_cast<size_t>(ptr - start - 1);
+                    while ( ptr < end && ( ' ' == *ptr || '\t' == *ptr || '\r' == *ptr || '\n' == *ptr ) ) {
+                        ++ptr;
+                    }
+                    if ( ptr >= end || ':' != *ptr ) {
+                        return false;
+                    }
+                    ++ptr;
+                    key = false;
+                    if ( 6 == key_length && 0 == strncmp(start, "status", 6) ) {
+                        while ( ptr < end && ( ' ' == *ptr || '\t' == *ptr || '\r' == *ptr || '\n' == *ptr ) ) {
+                            ++ptr;
+                        }
+                        // ... not a string, or escaped? let a full parse decide ...
+                        if ( ptr >= end || '"' != *ptr ) {
+                            return false;
+                        }
+                        const char* const value = ptr + 1;
+                        if ( false == SkipString(ptr, end, escaped) || true == escaped ) {
+                            return false;
+                        }
+                        // ... keep looking, a duplicate key overrides it ...
+                        status = value;
+                        length = static_cast<size_t>(ptr - value - 1);
+                    }
+                }
+                break;
+            }
+            case '{':
+            case '[':
+                if ( sizeof(open) == depth ) {
+                    return false;
+                }
+                open[depth++] = *ptr;
+                ++ptr;
+                break;
+            case '}':
+            case ']':
+                if ( ( '}' == *ptr ? '{' : '[' ) != open[depth - 1] ) {
+                    return false;
+                }
+                --depth;
+                ++ptr;
+                break;
+            case ',':
+                key = ( 1 == depth );
+                ++ptr;
+                break;
+            case ':':
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+                ++ptr;
+                break;
+            case 't':
+            case 'f':
+            case 'n':
+            {
+                const char* const literal = ( 't' == *ptr ? "true" : 'f' == *ptr ? "false" : "null" );
+                const size_t      size    = strlen(literal);
+                if ( static_cast<size_t>(end - ptr) < size || 0 != strncmp(ptr, literal, size) ) {
+                    return false;
+                }
+                ptr += size;
+                break;
+            }
+            default:
+                // ... number?
+                if ( ( *ptr < '0' || *ptr > '9' ) && '-' != *ptr && '+' != *ptr && '.' != *ptr && 'e' != *ptr && 'E' != *ptr ) {
+                    return false;
+                }
+                ++ptr;
+                break;
+        }
+    }
+    // ... object must be closed and followed by whitespace only ...
+    if ( 0 != depth ) {
+        return false;
+    }
+    while ( ptr < end && ( ' ' == *ptr || '\t' == *ptr || '\r' == *ptr || '\n' == *ptr ) ) {
+        ++ptr;
+    }
+    if ( ptr != end || nullptr == status ) {
+        return false;
+    }
+    o_status.assign(status, length);
+    return true;
+}
+
+/**
+ * @brief Skip a JSON string.
+ *
+ * @param io_ptr    Opening '"' position, on success set to the position after closing '"'.
+ * @param a_end     End of buffer.
+ * @param o_escaped Set to true if string contains escape sequences.
+ *
+ * @return True if string is terminated, false otherwise.
+ */
+bool casper::job::sequencer::Protocol::SkipString (const char*& io_ptr, const char* const a_end, bool& o_escaped)
+{
+    const char* ptr = io_ptr + 1;
+    o_escaped = false;
+    while ( ptr < a_end ) {
+        if ( '\\' == *ptr ) {
+            o_escaped = true;
+            ptr += 2;
+        } else if ( '"' == *ptr ) {
+            io_ptr = ptr + 1;
+            return true;
+        } else {
+            ++ptr;
+        }
+    }
+    return false;
+}
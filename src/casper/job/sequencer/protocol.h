@@ -0,0 +1,68 @@
+/**
+* @file protocol.h
+*
+* Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+*
+* This file is part of casper-job-sequencer.
+*
+* casper-job-sequencer is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Affero General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* casper-job-sequencer  is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU Affero General Public License
+* along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#ifndef CASPER_JOB_SEQUENCER_PROTOCOL_H_
+#define CASPER_JOB_SEQUENCER_PROTOCOL_H_
+
+#include "cc/non-movable.h"
+#include "cc/non-copyable.h"
+
+#include <stddef.h> // size_t
+#include <string>
+
+namespace casper
+{
+
+    namespace job
+    {
+
+        namespace sequencer
+        {
+
+            /**
+             * @brief JOB messages protocol helpers, stateless so they can be exercised in isolation.
+             */
+            class Protocol final : public cc::NonMovable, public cc::NonCopyable
+            {
+
+            public: // Constructor(s) / Destructor
+
+                Protocol () = delete;
+
+            public: // Static Method(s) / Function(s)
+
+                static void Unwrap     (const std::string& a_message, const char*& o_body, size_t& o_length);
+                static bool PeekStatus (const char* const a_body, const size_t a_length, std::string& o_status);
+
+            private: // Static Method(s) / Function(s)
+
+                static size_t ReadField  (const char*& io_ptr, const char* const a_end, const size_t a_field);
+                static bool   SkipString (const char*& io_ptr, const char* const a_end, bool& o_escaped);
+
+            }; // end of class 'Protocol'
+
+        } // end of namespace 'sequencer'
+
+    } // end of namespace 'job'
+
+} // end of namespace 'casper'
+
+#endif // CASPER_JOB_SEQUENCER_PROTOCOL_H_
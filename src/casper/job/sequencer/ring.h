@@ -0,0 +1,196 @@
+/**
+* @file ring.h
+*
+* Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+*
+* This file is part of casper-job-sequencer.
+*
+* casper-job-sequencer is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Affero General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* casper-job-sequencer  is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU Affero General Public License
+* along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#ifndef CASPER_JOB_SEQUENCER_RING_H_
+#define CASPER_JOB_SEQUENCER_RING_H_
+
+#include "cc/non-movable.h"
+#include "cc/non-copyable.h"
+
+#include <atomic>
+#include <stddef.h> // size_t
+#include <utility>  // std::move
+
+namespace casper
+{
+
+    namespace job
+    {
+
+        namespace sequencer
+        {
+
+            /**
+             * @brief Bounded lock-free multi-producer / single-consumer ring.
+             *
+             * Each cell carries a sequence number ( D. Vyukov's bounded queue ),
+             * values are moved in and out, no allocations after construction.
+             */
+            template <typename T>
+            class Ring final : public cc::NonMovable, public cc::NonCopyable
+            {
+
+            private: // Data Type(s)
+
+                typedef struct {
+                    std::atomic<size_t> sequence_;
+                    T                   value_;
+                } Cell;
+
+            private: // Data
+
+                Cell*               cells_;      //!< Cells, capacity is always a power of 2.
+                const size_t        mask_;       //!< Capacity - 1.
+                char                pad_0_[64];  //!< Keep producers and consumer positions on different cache lines.
+                std::atomic<size_t> head_;       //!< Next position to write, shared by producers.
+                char                pad_1_[64];  //!< Keep producers and consumer positions on different cache lines.
+                std::atomic<size_t> tail_;       //!< Next position to read, owned by consumer.
+
+            public: // Constructor(s) / Destructor
+
+                Ring () = delete;
+                Ring (const size_t a_capacity);
+                virtual ~Ring ();
+
+            public: // Method(s) / Function(s)
+
+                bool   Push (T&& a_value);
+                bool   Pop  (T& o_value);
+                size_t size () const;
+
+            private: // Static Method(s) / Function(s)
+
+                static size_t Capacity (const size_t a_capacity);
+
+            }; // end of class 'Ring'
+
+            /**
+             * @brief Default constructor.
+             *
+             * @param a_capacity Number of cells, rounded up to a power of 2.
+             */
+            template <typename T>
+            Ring<T>::Ring (const size_t a_capacity)
+                : cells_(new Cell[Capacity(a_capacity)]), mask_(Capacity(a_capacity) - 1)
+            {
+                for ( size_t idx = 0 ; idx <= mask_ ; ++idx ) {
+                    cells_[idx].sequence_.store(idx, std::memory_order_relaxed);
+                }
+                head_.store(0, std::memory_order_relaxed);
+                tail_.store(0, std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Destructor.
+             */
+            template <typename T>
+            Ring<T>::~Ring ()
+            {
+                delete [] cells_;
+            }
+
+            /**
+             * @brief Enqueue a value, can be called from any thread.
+             *
+             * @param a_value Value to move into ring.
+             *
+             * @return False if ring is full ( a_value is left untouched ), true otherwise.
+             */
+            template <typename T>
+            inline bool Ring<T>::Push (T&& a_value)
+            {
+                Cell*  cell;
+                size_t pos = head_.load(std::memory_order_relaxed);
+                while ( true ) {
+                    cell = &cells_[pos & mask_];
+                    const size_t    sequence = cell->sequence_.load(std::memory_order_acquire);
+                    const ptrdiff_t diff     = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(pos);
+                    if ( 0 == diff ) {
+                        if ( true == head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) ) {
+                            break;
+                        }
+                    } else if ( diff < 0 ) {
+                        // ... full ...
+                        return false;
+                    } else {
+                        pos = head_.load(std::memory_order_relaxed);
+                    }
+                }
+                cell->value_ = std::move(a_value);
+                cell->sequence_.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Dequeue a value, MUST only be called from the consumer thread.
+             *
+             * @param o_value Value to move out of ring.
+             *
+             * @return False if ring is empty, true otherwise.
+             */
+            template <typename T>
+            inline bool Ring<T>::Pop (T& o_value)
+            {
+                const size_t    pos      = tail_.load(std::memory_order_relaxed);
+                Cell*           cell     = &cells_[pos & mask_];
+                const size_t    sequence = cell->sequence_.load(std::memory_order_acquire);
+                if ( static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(pos + 1) < 0 ) {
+                    // ... empty ...
+                    return false;
+                }
+                tail_.store(pos + 1, std::memory_order_relaxed);
+                o_value      = std::move(cell->value_);
+                cell->value_ = T();
+                cell->sequence_.store(pos + mask_ + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @return Approximate number of queued values.
+             */
+            template <typename T>
+            inline size_t Ring<T>::size () const
+            {
+                const size_t head = head_.load(std::memory_order_relaxed);
+                const size_t tail = tail_.load(std::memory_order_relaxed);
+                return ( head > tail ? head - tail : 0 );
+            }
+
+            /**
+             * @return Capacity rounded up to a power of 2.
+             */
+            template <typename T>
+            inline size_t Ring<T>::Capacity (const size_t a_capacity)
+            {
+                size_t capacity = 2;
+                while ( capacity < a_capacity ) {
+                    capacity <<= 1;
+                }
+                return capacity;
+            }
+
+        } // end of namespace 'sequencer'
+
+    } // end of namespace 'job'
+
+} // end of namespace 'casper'
+
+#endif // CASPER_JOB_SEQUENCER_RING_H_
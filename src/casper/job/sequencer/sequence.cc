@@ -21,6 +21,8 @@
 
 #include "casper/job/sequencer/sequence.h"
 
+#include "casper/job/sequencer/stats.h"
+
 /**
  * @brief Default constructor.
  *
@@ -41,7 +43,7 @@ casper::job::sequencer::Sequence::Sequence (const Sequence::Source& a_source,
                                             const Json::Value& a_origin, const Json::Value& a_on_error)
     : source_(a_source), cid_(a_cid), iid_(a_iid), bjid_(a_bjid),
       rsid_(a_rsid), rjnr_(a_rjnr), rjid_(a_rjid), rcid_(a_rcid), count_(0),
-      origin_(a_origin), on_error_(a_on_error)
+      origin_(a_origin), on_error_(a_on_error), started_at_(Stats::Now())
 {
     /* empty */
 }
@@ -67,7 +69,7 @@ casper::job::sequencer::Sequence::Sequence (const Sequence::Source& a_source,
                                             const Json::Value& a_origin, const Json::Value& a_on_error)
     : source_(a_source), cid_(a_cid), iid_(a_iid), bjid_(a_bjid),
       rsid_(a_rsid), rjnr_(a_rjnr), rjid_(a_rjid), rcid_(a_rcid), did_(a_did), count_(0),
-      origin_(a_origin), on_error_(a_on_error)
+      origin_(a_origin), on_error_(a_on_error), started_at_(Stats::Now())
 {
     /* empty */
 }
@@ -91,7 +93,25 @@ casper::job::sequencer::Sequence::Sequence (const casper::job::sequencer::Sequen
     count_   = a_sequence.count_;
     origin_  = a_sequence.origin_;
     on_error_ = a_sequence.on_error_;
+    started_at_ = a_sequence.started_at_;
+    activities_ = a_sequence.activities_;
 }
+
+/**
+ * @brief Move constructor.
+ *
+ * @param a_sequence Object to move.
+ */
+casper::job::sequencer::Sequence::Sequence (casper::job::sequencer::Sequence&& a_sequence)
+    : source_(a_sequence.source_), cid_(a_sequence.cid_), iid_(a_sequence.iid_), bjid_(a_sequence.bjid_),
+      rsid_(std::move(a_sequence.rsid_)), rjnr_(a_sequence.rjnr_), rjid_(std::move(a_sequence.rjid_)), rcid_(std::move(a_sequence.rcid_)),
+      did_(std::move(a_sequence.did_)), count_(a_sequence.count_),
+      origin_(std::move(a_sequence.origin_)), on_error_(std::move(a_sequence.on_error_)), started_at_(a_sequence.started_at_),
+      activities_(std::move(a_sequence.activities_))
+{
+    /* empty */
+}
+
 /**
  * @brief Destructor.
  */
@@ -22,10 +22,9 @@
 #ifndef CASPER_JOB_SEQUENCER_SEQUENCE_H_
 #define CASPER_JOB_SEQUENCER_SEQUENCE_H_
 
-#include "cc/non-movable.h"
-
 #include <inttypes.h> // uint64_t
 #include <string>
+#include <memory>     // std::shared_ptr
 
 #include "json/json.h"
 
@@ -42,7 +41,13 @@ namespace casper
         namespace sequencer
         {
 
-            class Sequence final : public cc::NonMovable
+            /**
+             * @brief Sequence info, shared by all of it's activities.
+             *
+             * Only \link Bind \link can change it and it MUST be called before the
+             * object is shared ( see \link SharedSequence \link ), from then on it's immutable.
+             */
+            class Sequence final
             {
                 
             public: // Enum(s)
@@ -66,6 +71,8 @@ namespace casper
                 size_t      count_;     //!< NUMBER of activites related to this sequence.
                 Json::Value origin_;    //!< Origin info, if available.
                 Json::Value on_error_;  //!< JSON object with 'on_error' config.
+                uint64_t    started_at_; //!< Monotonic clock, in microseconds, when this sequence was created ( for statistics purposes ).
+                Json::Value activities_; //!< Registered activities ( as returned by DB ).
 
             public: // Constructor(s) / Destructor
 
@@ -77,11 +84,13 @@ namespace casper
                           const std::string& a_rsid, const uint64_t& a_rjnr, const std::string& a_rjid, const std::string& a_rcid, const std::string& a_did,
                           const Json::Value& a_origin, const Json::Value& a_on_error);
                 Sequence (const Sequence& a_sequence);
+                Sequence (Sequence&& a_sequence);
                 virtual ~Sequence();
                 
             public: // Operator(s) / Overload
                 
-                Sequence& operator= (const Sequence& a_sequence);
+                Sequence& operator= (const Sequence& a_sequence) = delete;
+                Sequence& operator= (Sequence&& a_sequence) = delete;
                 
             public:
                 
@@ -97,34 +106,14 @@ namespace casper
                 const size_t&      count    () const;
                 const Json::Value& origin   () const;
                 const Json::Value& on_error () const;
+                const uint64_t&    started_at () const;
+                const Json::Value& activities () const;
                 
-                void               Bind    (const std::string& a_id, const size_t& a_count);
+                void               Bind    (const std::string& a_id, const size_t& a_count, Json::Value&& a_activities = Json::Value());
 
             }; // end of class 'Sequence'
         
-            /**
-             * @brief Assigment operator overload.
-             *
-             * @param a_sequence Object to copy.
-             *
-             * @return Ref to this job.
-             */
-            inline Sequence& Sequence::operator = (const Sequence& a_sequence)
-            {
-                source_   = a_sequence.source_;
-                cid_      = a_sequence.cid_;
-                iid_      = a_sequence.iid_;
-                bjid_     = a_sequence.bjid_;
-                rsid_     = a_sequence.rsid_;
-                rjnr_     = a_sequence.rjnr_;
-                rjid_     = a_sequence.rjid_;
-                rcid_     = a_sequence.rcid_;
-                did_      = a_sequence.did_;
-                count_    = a_sequence.count_;
-                origin_   = a_sequence.origin_;
-                on_error_ = a_sequence.on_error_;
-                return *this;
-            }
+            typedef std::shared_ptr<const Sequence> SharedSequence; //!< Immutable, reference-counted, sequence handle.
         
             /**
              * @return R/O access to source.
@@ -221,17 +210,35 @@ namespace casper
             {
                 return on_error_;
             }
+            
+            /**
+             * @return Monotonic clock, in microseconds, when this sequence was created.
+             */
+            inline const uint64_t& Sequence::started_at () const
+            {
+                return started_at_;
+            }
+        
+            /**
+             * @return R/O access to registered activities, null until bound.
+             */
+            inline const Json::Value& Sequence::activities () const
+            {
+                return activities_;
+            }
         
             /**
              * @brief Set DB id and number of activites related to this sequence..
              *
-             * @param a_id DB id as string.
-             * @param a_count number of activites related to this sequence.
+             * @param a_id         DB id as string.
+             * @param a_count      number of activites related to this sequence.
+             * @param a_activities Registered activities to keep, optional.
              */
-            inline void Sequence::Bind (const std::string& a_id, const size_t& a_count)
+            inline void Sequence::Bind (const std::string& a_id, const size_t& a_count, Json::Value&& a_activities)
             {
-                did_   = a_id;
-                count_ = a_count;
+                did_        = a_id;
+                count_      = a_count;
+                activities_ = std::move(a_activities);
             }
         
        } // end of namespace 'sequencer'
@@ -0,0 +1,157 @@
+/**
+ * @file sql.cc
+ *
+ * Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-job-sequencer.
+ *
+ * casper-job-sequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-job-sequencer  is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "casper/job/sequencer/sql.h"
+
+#include "ev/postgresql/request.h"
+
+#include <sstream> // std::stringstream
+
+/**
+ * @brief Build js.register_sequence call.
+ *
+ * @param a_pid      PROJECT id.
+ * @param a_sequence Sequence info.
+ * @param a_payload  Serialized sequence payload.
+ * @param a_jobs     Serialized sequence jobs.
+ * @param a_ttr      Sequence TTR, in seconds.
+ * @param a_validity Sequence validity, in seconds.
+ * @param a_timeout  Sequence timeout, in seconds.
+ *
+ * @return SQL query.
+ */
+std::string casper::job::sequencer::SQL::RegisterSequence (const uint64_t a_pid, const casper::job::sequencer::Sequence& a_sequence,
+                                                           const std::string& a_payload, const std::string& a_jobs,
+                                                           const Json::UInt a_ttr, const Json::UInt a_validity, const Json::UInt a_timeout)
+{
+    std::stringstream ss;
+    // ... js.register_sequence (pid INTEGER, cid INTEGER, iid INTEGER, bjid INTEGER, rjid TEXT, rcid TEXT, payload JSONB, activities JSONB, ttr INTEGER, validity INTEGER, timeout INTEGER) ...
+    ss << "SELECT * FROM js.register_sequence(";
+    ss <<     a_pid << ',' << a_sequence.cid() << ',' << a_sequence.iid() << ',' << a_sequence.bjid();
+    ss <<     ',' <<  "'" << a_sequence.rjid() << "'" << ',' << "'" << a_sequence.rcid() << "'";
+    ss <<     ",'" << ::ev::postgresql::Request::SQLEscape(a_payload) << "'";
+    ss <<     ",'" << ::ev::postgresql::Request::SQLEscape(a_jobs) << "'";
+    ss <<     ',' << a_ttr << ',' << a_validity << ',' << a_timeout;
+    ss << ");";
+    return ss.str();
+}
+
+/**
+ * @brief Build js.cancel_sequence call.
+ *
+ * @param a_sequence Sequence info.
+ * @param a_response Serialized response.
+ *
+ * @return SQL query.
+ */
+std::string casper::job::sequencer::SQL::CancelSequence (const casper::job::sequencer::Sequence& a_sequence, const std::string& a_response)
+{
+    std::stringstream ss;
+    // ... js.cancel_sequence (id INTEGER, status js.status, response JSONB) ...
+    ss << "SELECT * FROM js.cancel_sequence(";
+    ss <<   a_sequence.did();
+    ss <<   ",'" << ::ev::postgresql::Request::SQLEscape(a_response) << "'";
+    ss << ");";
+    return ss.str();
+}
+
+/**
+ * @brief Build js.finalize_sequence call.
+ *
+ * @param a_sequence Sequence info.
+ * @param a_status   Final status.
+ * @param a_response Serialized response.
+ *
+ * @return SQL query.
+ */
+std::string casper::job::sequencer::SQL::FinalizeSequence (const casper::job::sequencer::Sequence& a_sequence, const casper::job::sequencer::Status a_status,
+                                                           const std::string& a_response)
+{
+    std::stringstream ss;
+    // ... js.finalize_sequence (id INTEGER, status js.status, response JSONB) ...
+    ss << "SELECT * FROM js.finalize_sequence(";
+    ss <<   a_sequence.did() << ",'" << a_status << "'";
+    ss <<   ",'" << ::ev::postgresql::Request::SQLEscape(a_response) << "'";
+    ss << ");";
+    return ss.str();
+}
+
+/**
+ * @brief Build js.register_activity call.
+ *
+ * @param a_activity Activity info.
+ * @param a_data     Serialized attempt data.
+ *
+ * @return SQL query.
+ */
+std::string casper::job::sequencer::SQL::RegisterActivity (const casper::job::sequencer::Activity& a_activity, const std::string& a_data)
+{
+    std::stringstream ss;
+    // ... js.register_activity (sid INTEGER, id INTEGER, bjid INTEGER, rjid TEXT, rcid TEXT, attempt INTEGER, payload JSONB, status js.status); ...
+    ss << "SELECT * FROM js.register_activity(";
+    ss <<   a_activity.sequence().did() << ',' << a_activity.did();
+    ss <<  ',' << a_activity.sequence().bjid() << ",'" << a_activity.rjid() << "','" << a_activity.rcid() << "'";
+    ss <<  ',' << a_activity.attempt();
+    ss <<   ",'" << ::ev::postgresql::Request::SQLEscape(a_data) << "'";
+    ss <<   ",'" << sequencer::Status::InProgress << "'";
+    ss << ");";
+    return ss.str();
+}
+
+/**
+ * @brief Build js.finalize_activity call.
+ *
+ * @param a_activity Activity info.
+ * @param a_attempt  Serialized attempt.
+ * @param a_response Serialized response.
+ *
+ * @return SQL query.
+ */
+std::string casper::job::sequencer::SQL::FinalizeActivity (const casper::job::sequencer::Activity& a_activity, const std::string& a_attempt,
+                                                           const std::string& a_response)
+{
+    std::stringstream ss;
+    // ... js.finalize_activity (sid INTEGER, id INTEGER, attempt INTEGER, payload JSONB, response JSONB, status js.status) ...
+    ss << "SELECT * FROM js.finalize_activity(";
+    ss <<   a_activity.sequence().did() << ',' << a_activity.did();
+    ss <<  ',' << a_activity.attempt() << ",'" << ::ev::postgresql::Request::SQLEscape(a_attempt) << "'";
+    ss <<  ",'" << ::ev::postgresql::Request::SQLEscape(a_response) << "'";
+    ss <<  ",'" << a_activity.status() << "'";
+    ss << ");";
+    return ss.str();
+}
+
+/**
+ * @brief Build js.get_activities_responses call.
+ *
+ * @param a_sequence Sequence info.
+ *
+ * @return SQL query.
+ */
+std::string casper::job::sequencer::SQL::GetActivitiesResponses (const casper::job::sequencer::Sequence& a_sequence)
+{
+    std::stringstream ss;
+    // ... js.get_activities_responses (sid INTEGER) ...
+    ss << "SELECT * FROM js.get_activities_responses(";
+    ss <<  a_sequence.did();
+    ss << ");";
+    return ss.str();
+}
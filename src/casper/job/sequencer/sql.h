@@ -0,0 +1,76 @@
+/**
+* @file sql.h
+*
+* Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+*
+* This file is part of casper-job-sequencer.
+*
+* casper-job-sequencer is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Affero General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* casper-job-sequencer  is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU Affero General Public License
+* along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#ifndef CASPER_JOB_SEQUENCER_SQL_H_
+#define CASPER_JOB_SEQUENCER_SQL_H_
+
+#include "cc/non-movable.h"
+#include "cc/non-copyable.h"
+
+#include "json/json.h"
+
+#include "casper/job/sequencer/status.h"
+#include "casper/job/sequencer/sequence.h"
+#include "casper/job/sequencer/activity.h"
+
+#include <inttypes.h> // uint64_t
+#include <string>
+
+namespace casper
+{
+
+    namespace job
+    {
+
+        namespace sequencer
+        {
+
+            /**
+             * @brief js.* functions calls builders, stateless so they can be exercised in isolation.
+             *
+             * JSON arguments are expected to be already serialized, they will be escaped here.
+             */
+            class SQL final : public cc::NonMovable, public cc::NonCopyable
+            {
+
+            public: // Constructor(s) / Destructor
+
+                SQL () = delete;
+
+            public: // Static Method(s) / Function(s)
+
+                static std::string RegisterSequence       (const uint64_t a_pid, const Sequence& a_sequence, const std::string& a_payload, const std::string& a_jobs,
+                                                           const Json::UInt a_ttr, const Json::UInt a_validity, const Json::UInt a_timeout);
+                static std::string CancelSequence         (const Sequence& a_sequence, const std::string& a_response);
+                static std::string FinalizeSequence       (const Sequence& a_sequence, const Status a_status, const std::string& a_response);
+                static std::string RegisterActivity       (const Activity& a_activity, const std::string& a_data);
+                static std::string FinalizeActivity       (const Activity& a_activity, const std::string& a_attempt, const std::string& a_response);
+                static std::string GetActivitiesResponses (const Sequence& a_sequence);
+
+            }; // end of class 'SQL'
+
+        } // end of namespace 'sequencer'
+
+    } // end of namespace 'job'
+
+} // end of namespace 'casper'
+
+#endif // CASPER_JOB_SEQUENCER_SQL_H_
@@ -0,0 +1,143 @@
+/**
+ * @file stats.cc
+ *
+ * Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-job-sequencer.
+ *
+ * casper-job-sequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-job-sequencer  is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "casper/job/sequencer/stats.h"
+
+#include <algorithm>      // std::min
+#include <stdio.h>        // snprintf, fopen
+#include <unistd.h>       // sysconf
+#include <sys/resource.h> // getrusage
+
+const char* const casper::job::sequencer::Stats::sk_stages_names_[casper::job::sequencer::Stats::sk_stages_count_] = {
+    "reserve",
+    "responses",
+    "patch",
+    "register",
+    "subscribe",
+    "relay",
+    "push",
+    "execution",
+    "finalize",
+    "launch",
+    "finalize_sequence",
+    "sequence"
+};
+
+/**
+ * @brief Default constructor.
+ */
+casper::job::sequencer::Stats::Stats ()
+{
+    dumped_at_ = Now();
+}
+
+/**
+ * @brief Destructor.
+ */
+casper::job::sequencer::Stats::~Stats ()
+{
+    /* empty */
+}
+
+/**
+ * @brief Report all non empty histograms, one line per tube and stage, and reset them.
+ *
+ * @param a_callback Function to call for each line.
+ */
+void casper::job::sequencer::Stats::Dump (const std::function<void(const std::string& a_line)>& a_callback)
+{
+    char buffer[256];
+    // ... throughput since last dump and memory usage ...
+    {
+        uint64_t sequences  = 0;
+        uint64_t activities = 0;
+        for ( const auto& it : tubes_ ) {
+            sequences  += it.second.histograms_[static_cast<size_t>(Stage::Sequence)].count();
+            activities += it.second.histograms_[static_cast<size_t>(Stage::Finalize)].count();
+        }
+        const uint64_t now     = Now();
+        const double   elapsed = static_cast<double>(now > dumped_at_ ? now - dumped_at_ : 1) / 1000000.0;
+        uint64_t       rss     = 0;
+        uint64_t       peak    = 0;
+        RSS(rss, peak);
+        const int length = snprintf(buffer, sizeof(buffer),
+                                    "throughput: %.2f sequences/s, %.2f activities/s over %.0fs, rss=%" PRIu64 "KB, peak rss=%" PRIu64 "KB",
+                                    static_cast<double>(sequences) / elapsed, static_cast<double>(activities) / elapsed, elapsed,
+                                    rss / 1024, peak / 1024
+        );
+        if ( length > 0 ) {
+            a_callback(std::string(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1)));
+        }
+        dumped_at_ = now;
+    }
+    // ... per tube, per stage, latencies ...
+    for ( auto& it : tubes_ ) {
+        for ( size_t idx = 0 ; idx < sk_stages_count_ ; ++idx ) {
+            Histogram& histogram = it.second.histograms_[idx];
+            if ( 0 == histogram.count() ) {
+                continue;
+            }
+            const int length = snprintf(buffer, sizeof(buffer),
+                                        "%s, %-17s: n=%" PRIu64 ", min=%" PRIu64 "us, mean=%" PRIu64 "us, p50=%" PRIu64 "us, p90=%" PRIu64 "us, p99=%" PRIu64 "us, p99.9=%" PRIu64 "us, max=%" PRIu64 "us",
+                                        it.first.c_str(), sk_stages_names_[idx], histogram.count(), histogram.min(), histogram.mean(),
+                                        histogram.Percentile(50.0), histogram.Percentile(90.0), histogram.Percentile(99.0), histogram.Percentile(99.9),
+                                        histogram.max()
+            );
+            if ( length > 0 ) {
+                a_callback(std::string(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1)));
+            }
+            histogram.Reset();
+        }
+    }
+}
+
+/**
+ * @brief Obtain this process memory usage.
+ *
+ * @param o_current Current resident set size, in bytes, 0 if not available.
+ * @param o_peak    Peak resident set size, in bytes.
+ */
+void casper::job::sequencer::Stats::RSS (uint64_t& o_current, uint64_t& o_peak)
+{
+    o_current = 0;
+    o_peak    = 0;
+    // ... peak ...
+    struct rusage usage;
+    if ( 0 == getrusage(RUSAGE_SELF, &usage) ) {
+#ifdef __APPLE__
+        o_peak = static_cast<uint64_t>(usage.ru_maxrss);        // ... bytes ...
+#else
+        o_peak = static_cast<uint64_t>(usage.ru_maxrss) * 1024; // ... kilobytes ...
+#endif
+    }
+    // ... current ...
+#ifdef __linux__
+    FILE* file = fopen("/proc/self/statm", "r");
+    if ( nullptr != file ) {
+        unsigned long long size     = 0;
+        unsigned long long resident = 0;
+        if ( 2 == fscanf(file, "%llu %llu", &size, &resident) ) {
+            o_current = static_cast<uint64_t>(resident) * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+        }
+        fclose(file);
+    }
+#endif
+}
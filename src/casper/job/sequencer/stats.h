@@ -0,0 +1,162 @@
+/**
+* @file stats.h
+*
+* Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+*
+* This file is part of casper-job-sequencer.
+*
+* casper-job-sequencer is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Affero General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* casper-job-sequencer  is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU Affero General Public License
+* along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#ifndef CASPER_JOB_SEQUENCER_STATS_H_
+#define CASPER_JOB_SEQUENCER_STATS_H_
+
+#include "cc/non-movable.h"
+#include "cc/non-copyable.h"
+
+#include "casper/job/sequencer/histogram.h"
+
+#include <inttypes.h> // uint64_t
+#include <chrono>
+#include <functional> // std::function
+#include <map>
+#include <string>
+#include <vector>
+
+namespace casper
+{
+
+    namespace job
+    {
+
+        namespace sequencer
+        {
+
+            /**
+             * @brief Per target tube, per stage, latency histograms of the activity lifecycle.
+             *
+             * Not thread safe, expected to be used only at the looper thread.
+             */
+            class Stats final : public cc::NonMovable, public cc::NonCopyable
+            {
+
+            public: // Data Type(s)
+
+                enum class Stage : uint8_t {
+                    Reserve = 0,      //!< REDIS job id reservation and status set.
+                    Responses,        //!< js.get_activities_responses.
+                    Patch,            //!< V8 payload patch and abort expression evaluation.
+                    Register,         //!< js.register_activity.
+                    Subscribe,        //!< REDIS channel subscription.
+                    Relay,            //!< REDIS ( forged ) reset message relay.
+                    Push,             //!< BEANSTALKD push.
+                    Execution,        //!< From push to activity return ( worker execution ).
+                    Finalize,         //!< js.finalize_activity.
+                    Launch,           //!< Next activity launch, end-to-end.
+                    FinalizeSequence, //!< js.finalize_sequence.
+                    Sequence          //!< From sequence creation until it's finalization, end-to-end.
+                };
+
+            private: // Data Type(s)
+
+                typedef struct {
+                    std::vector<Histogram> histograms_; //!< One per stage, reset on each \link Dump \link call.
+                    std::vector<Histogram> totals_;     //!< One per stage, never reset.
+                } Tube;
+
+            private: // Static Const Data
+
+                static const size_t             sk_stages_count_ = static_cast<size_t>(Stage::Sequence) + 1;
+                static const char* const        sk_stages_names_[sk_stages_count_];
+
+            private: // Data
+
+                std::map<std::string, Tube> tubes_;     //!< Tube -> histograms.
+                uint64_t                    dumped_at_; //!< Last \link Dump \link call, as returned by \link Now \link.
+
+            public: // Constructor(s) / Destructor
+
+                Stats ();
+                virtual ~Stats ();
+
+            public: // Method(s) / Function(s)
+
+                uint64_t Record     (const std::string& a_tube, const Stage a_stage, const uint64_t a_start);
+                uint64_t Percentile (const std::string& a_tube, const Stage a_stage, const double a_percentile) const;
+                void     Dump       (const std::function<void(const std::string& a_line)>& a_callback);
+
+            public: // Static Method(s) / Function(s)
+
+                static uint64_t Now ();
+                static void     RSS (uint64_t& o_current, uint64_t& o_peak);
+
+            }; // end of class 'Stats'
+
+            /**
+             * @brief Record a stage duration, from a_start until now.
+             *
+             * @param a_tube  Target tube.
+             * @param a_stage One of \link Stage \link.
+             * @param a_start Stage start, as returned by \link Now \link.
+             *
+             * @return Recorded duration, in microseconds.
+             */
+            inline uint64_t Stats::Record (const std::string& a_tube, const Stats::Stage a_stage, const uint64_t a_start)
+            {
+                auto it = tubes_.find(a_tube);
+                if ( tubes_.end() == it ) {
+                    it = tubes_.insert(std::make_pair(a_tube, Tube({ std::vector<Histogram>(sk_stages_count_), std::vector<Histogram>(sk_stages_count_) }))).first;
+                }
+                const uint64_t now     = Now();
+                const uint64_t elapsed = ( now > a_start ? now - a_start : 0 );
+                it->second.histograms_[static_cast<size_t>(a_stage)].Record(elapsed);
+                it->second.totals_[static_cast<size_t>(a_stage)].Record(elapsed);
+                return elapsed;
+            }
+
+            /**
+             * @brief Calculate a stage latency percentile, over all recorded durations - not affected by \link Dump \link calls.
+             *
+             * @param a_tube       Target tube.
+             * @param a_stage      One of \link Stage \link.
+             * @param a_percentile Percentile, ]0, 100].
+             *
+             * @return Latency, in microseconds, 0 if nothing was recorded.
+             */
+            inline uint64_t Stats::Percentile (const std::string& a_tube, const Stats::Stage a_stage, const double a_percentile) const
+            {
+                const auto it = tubes_.find(a_tube);
+                if ( tubes_.end() == it ) {
+                    return 0;
+                }
+                return it->second.totals_[static_cast<size_t>(a_stage)].Percentile(a_percentile);
+            }
+
+            /**
+             * @return Monotonic clock, in microseconds.
+             */
+            inline uint64_t Stats::Now ()
+            {
+                return static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()
+                );
+            }
+
+        } // end of namespace 'sequencer'
+
+    } // end of namespace 'job'
+
+} // end of namespace 'casper'
+
+#endif // CASPER_JOB_SEQUENCER_STATS_H_
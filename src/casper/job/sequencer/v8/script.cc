@@ -69,6 +69,46 @@ casper::job::sequencer::v8::Script::~Script ()
 
 // MARK: -
 
+/**
+ * @brief Traverse a JSON object and replace all evaluable 'String' fields by their evaluation result.
+ *
+ * @param a_data    Previously loaded data object, see \link SetData \link.
+ * @param io_object JSON object to patch.
+ *
+ * @throw ::cc::v8::Exception on evaluation error.
+ */
+void casper::job::sequencer::v8::Script::Patch (::v8::Persistent<::v8::Value>& a_data, Json::Value& io_object)
+{
+    ::cc::v8::Value value;
+    PatchObject(io_object, [this, &a_data, &value] (const std::string& a_expression) -> Json::Value {
+        // ... start as null ...
+        value.SetNull();
+        // ...
+        Evaluate(a_data, a_expression, value);
+        // ...
+        switch(value.type()) {
+            case ::cc::v8::Value::Type::Int32:
+                return Json::Value(value.operator int());
+            case ::cc::v8::Value::Type::UInt32:
+                return Json::Value(value.operator unsigned int());
+            case ::cc::v8::Value::Type::Double:
+                return Json::Value(value.operator double());
+            case ::cc::v8::Value::Type::String:
+                return Json::Value(value.AsString());
+            case ::cc::v8::Value::Type::Boolean:
+                return Json::Value(value.operator const bool());
+            case ::cc::v8::Value::Type::Object:
+                return value.operator const Json::Value &();
+            case ::cc::v8::Value::Type::Date:
+            case ::cc::v8::Value::Type::Undefined:
+            case ::cc::v8::Value::Type::Null:
+                return Json::Value(Json::Value::null);
+        }
+    });
+}
+
+// MARK: -
+
 /**
  * @brief The callback that is invoked by v8 whenever the JavaScript 'NativeParseDate' function is called.
  *
@@ -48,6 +48,10 @@ namespace casper
                             const std::string& a_owner, const std::string& a_name, const std::string& a_uri,
                             const std::string& a_out_path);
                     virtual ~Script ();
+
+                public: // Method(s) / Function(s)
+
+                    void Patch (::v8::Persistent<::v8::Value>& a_data, Json::Value& io_object);
                     
                 private: // Static Method(s) / Function(s)
                     
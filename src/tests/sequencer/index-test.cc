@@ -0,0 +1,191 @@
+/**
+* @file index-test.cc
+*
+* Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+*
+* This file is part of casper-job-sequencer.
+*
+* casper-job-sequencer is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Affero General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* casper-job-sequencer  is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU Affero General Public License
+* along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "casper/job/sequencer/index.h"
+
+#include "gtest/gtest.h"
+
+#include <map>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+    typedef casper::job::sequencer::Index<int> IntIndex;
+
+    /**
+     * @brief Same mix as the index, used to pick keys that share a home slot.
+     */
+    uint64_t Mix (uint64_t a_key)
+    {
+        a_key ^= a_key >> 30; a_key *= 0xbf58476d1ce4e5b9ULL;
+        a_key ^= a_key >> 27; a_key *= 0x94d049bb133111ebULL;
+        a_key ^= a_key >> 31;
+        return a_key;
+    }
+
+    /**
+     * @return First a_count keys, starting at a_first, whose home slot is a_home in a table with a_capacity slots.
+     */
+    std::vector<uint64_t> KeysAt (const size_t a_home, const size_t a_capacity, const size_t a_count, const uint64_t a_first = 1)
+    {
+        std::vector<uint64_t> keys;
+        for ( uint64_t key = a_first ; keys.size() < a_count ; ++key ) {
+            if ( a_home == ( Mix(key) & ( a_capacity - 1 ) ) ) {
+                keys.push_back(key);
+            }
+        }
+        return keys;
+    }
+
+} // end of anonymous namespace
+
+TEST(Index, InsertFindErase)
+{
+    IntIndex index;
+    int      values[3] = { 0, 1, 2 };
+
+    EXPECT_EQ(nullptr, index.Find(1));
+    EXPECT_EQ(nullptr, index.Erase(1));
+
+    index.Insert(1, &values[0]);
+    index.Insert(2, &values[1]);
+    EXPECT_EQ(2u, index.size());
+    EXPECT_EQ(&values[0], index.Find(1));
+    EXPECT_EQ(&values[1], index.Find(2));
+
+    // ... replacing a value does not change size ...
+    index.Insert(1, &values[2]);
+    EXPECT_EQ(2u, index.size());
+    EXPECT_EQ(&values[2], index.Find(1));
+
+    EXPECT_EQ(&values[2], index.Erase(1));
+    EXPECT_EQ(nullptr, index.Find(1));
+    EXPECT_EQ(nullptr, index.Erase(1));
+    EXPECT_EQ(1u, index.size());
+
+    index.Clear();
+    EXPECT_EQ(0u, index.size());
+    EXPECT_EQ(nullptr, index.Find(2));
+}
+
+TEST(Index, GrowKeepsValues)
+{
+    IntIndex         index(1);
+    std::vector<int> values(1000);
+    for ( size_t idx = 0 ; idx < values.size() ; ++idx ) {
+        index.Insert(idx + 1, &values[idx]);
+    }
+    EXPECT_EQ(values.size(), index.size());
+    for ( size_t idx = 0 ; idx < values.size() ; ++idx ) {
+        EXPECT_EQ(&values[idx], index.Find(idx + 1));
+    }
+    size_t visited = 0;
+    index.ForEach([&visited, &values] (const uint64_t a_key, int* a_value) {
+        EXPECT_EQ(&values[a_key - 1], a_value);
+        ++visited;
+    });
+    EXPECT_EQ(values.size(), visited);
+}
+
+TEST(Index, BackwardShiftDelete)
+{
+    // ... 8 slots, up to 4 values without growing: a cluster of 3 keys with the same home plus one key homed inside it ...
+    IntIndex                    index(8);
+    int                         values[4] = { 0, 1, 2, 3 };
+    const std::vector<uint64_t> cluster   = KeysAt(2, 8, 3);
+    const uint64_t              inside    = KeysAt(3, 8, 1)[0];
+
+    for ( size_t idx = 0 ; idx < cluster.size() ; ++idx ) {
+        index.Insert(cluster[idx], &values[idx]);
+    }
+    index.Insert(inside, &values[3]);
+
+    // ... erasing the head of the cluster must shift followers back, no tombstones ...
+    EXPECT_EQ(&values[0], index.Erase(cluster[0]));
+    EXPECT_EQ(&values[1], index.Find(cluster[1]));
+    EXPECT_EQ(&values[2], index.Find(cluster[2]));
+    EXPECT_EQ(&values[3], index.Find(inside));
+
+    EXPECT_EQ(&values[2], index.Erase(cluster[2]));
+    EXPECT_EQ(&values[1], index.Find(cluster[1]));
+    EXPECT_EQ(&values[3], index.Find(inside));
+
+    EXPECT_EQ(&values[1], index.Erase(cluster[1]));
+    EXPECT_EQ(&values[3], index.Find(inside));
+    EXPECT_EQ(1u, index.size());
+}
+
+TEST(Index, BackwardShiftDeleteWrapsAround)
+{
+    // ... cluster starting at the last slot wraps to the first ones ...
+    IntIndex                    index(8);
+    int                         values[3] = { 0, 1, 2 };
+    const std::vector<uint64_t> cluster   = KeysAt(7, 8, 2);
+    const uint64_t              first     = KeysAt(0, 8, 1)[0];
+
+    index.Insert(cluster[0], &values[0]); // slot 7
+    index.Insert(cluster[1], &values[1]); // slot 0
+    index.Insert(first     , &values[2]); // slot 1, home 0
+
+    EXPECT_EQ(&values[0], index.Erase(cluster[0]));
+    EXPECT_EQ(&values[1], index.Find(cluster[1]));
+    EXPECT_EQ(&values[2], index.Find(first));
+
+    EXPECT_EQ(&values[1], index.Erase(cluster[1]));
+    EXPECT_EQ(&values[2], index.Find(first));
+    EXPECT_EQ(1u, index.size());
+}
+
+TEST(Index, MatchesReference)
+{
+    IntIndex                 index(4);
+    std::map<uint64_t, int*> reference;
+    std::vector<int>         values(512);
+    std::mt19937_64          random(1);
+
+    for ( size_t step = 0 ; step < 200000 ; ++step ) {
+        const uint64_t key = random() % values.size();
+        switch ( random() % 3 ) {
+            case 0:
+                index.Insert(key, &values[key]);
+                reference[key] = &values[key];
+                break;
+            case 1:
+            {
+                const auto it = reference.find(key);
+                EXPECT_EQ(( reference.end() != it ? it->second : nullptr ), index.Erase(key));
+                if ( reference.end() != it ) {
+                    reference.erase(it);
+                }
+                break;
+            }
+            default:
+            {
+                const auto it = reference.find(key);
+                EXPECT_EQ(( reference.end() != it ? it->second : nullptr ), index.Find(key));
+                break;
+            }
+        }
+        ASSERT_EQ(reference.size(), index.size());
+    }
+}
@@ -0,0 +1,118 @@
+/**
+* @file memo-test.cc
+*
+* Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+*
+* This file is part of casper-job-sequencer.
+*
+* casper-job-sequencer is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Affero General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* casper-job-sequencer  is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU Affero General Public License
+* along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "casper/job/sequencer/memo.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <thread>
+
+namespace
+{
+
+    Json::Value Response (const int a_value)
+    {
+        Json::Value response = Json::Value(Json::ValueType::objectValue);
+        response["status"] = "completed";
+        response["value"]  = a_value;
+        return response;
+    }
+
+} // end of anonymous namespace
+
+TEST(Memo, Hash)
+{
+    // ... FNV-1a 64 offset basis and a known vector ...
+    EXPECT_EQ(14695981039346656037ULL, casper::job::sequencer::Memo::Hash(""));
+    EXPECT_EQ(0xaf63dc4c8601ec8cULL, casper::job::sequencer::Memo::Hash("a"));
+    EXPECT_EQ(casper::job::sequencer::Memo::Hash("{\"a\":1}"), casper::job::sequencer::Memo::Hash("{\"a\":1}"));
+    EXPECT_NE(casper::job::sequencer::Memo::Hash("{\"a\":1}"), casper::job::sequencer::Memo::Hash("{\"a\":2}"));
+}
+
+TEST(Memo, DisabledTube)
+{
+    casper::job::sequencer::Memo memo;
+    memo.Put("tube", 1, "data", Response(1));
+    EXPECT_FALSE(memo.Enabled("tube"));
+    EXPECT_EQ(nullptr, memo.Get("tube", 1, "data"));
+
+    // ... no room, nothing is kept ...
+    memo.Enable("tube", 60, 0);
+    memo.Put("tube", 1, "data", Response(1));
+    EXPECT_TRUE(memo.Enabled("tube"));
+    EXPECT_EQ(nullptr, memo.Get("tube", 1, "data"));
+}
+
+TEST(Memo, HitAndCollision)
+{
+    casper::job::sequencer::Memo memo;
+    memo.Enable("tube", 60, 16);
+    memo.Put("tube", 1, "data", Response(1));
+
+    const Json::Value* response = memo.Get("tube", 1, "data");
+    ASSERT_NE(nullptr, response);
+    EXPECT_EQ(1, (*response)["value"].asInt());
+
+    // ... same key, different data: a hash collision is a miss ...
+    EXPECT_EQ(nullptr, memo.Get("tube", 1, "other"));
+    EXPECT_EQ(nullptr, memo.Get("other", 1, "data"));
+
+    // ... overwritten ...
+    memo.Put("tube", 1, "data", Response(2));
+    response = memo.Get("tube", 1, "data");
+    ASSERT_NE(nullptr, response);
+    EXPECT_EQ(2, (*response)["value"].asInt());
+}
+
+TEST(Memo, EvictsOldestWhenFull)
+{
+    casper::job::sequencer::Memo memo;
+    memo.Enable("tube", 60, 2);
+    memo.Put("tube", 1, "1", Response(1));
+    memo.Put("tube", 2, "2", Response(2));
+    // ... rewriting 1 makes it the newest one, 2 is evicted next ...
+    memo.Put("tube", 1, "1", Response(1));
+    memo.Put("tube", 3, "3", Response(3));
+
+    EXPECT_NE(nullptr, memo.Get("tube", 1, "1"));
+    EXPECT_EQ(nullptr, memo.Get("tube", 2, "2"));
+    EXPECT_NE(nullptr, memo.Get("tube", 3, "3"));
+}
+
+TEST(Memo, ExpiresByTTL)
+{
+    casper::job::sequencer::Memo memo;
+    memo.Enable("tube", 1, 16);
+    memo.Put("tube", 1, "1", Response(1));
+    EXPECT_NE(nullptr, memo.Get("tube", 1, "1"));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+
+    // ... expired entries are evicted on lookup and on write ...
+    memo.Put("tube", 2, "2", Response(2));
+    EXPECT_EQ(nullptr, memo.Get("tube", 1, "1"));
+    EXPECT_NE(nullptr, memo.Get("tube", 2, "2"));
+
+    // ... re-enabling a tube drops it's entries ...
+    memo.Enable("tube", 1, 16);
+    EXPECT_EQ(nullptr, memo.Get("tube", 2, "2"));
+}
@@ -0,0 +1,129 @@
+/**
+* @file protocol-test.cc
+*
+* Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+*
+* This file is part of casper-job-sequencer.
+*
+* casper-job-sequencer is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Affero General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* casper-job-sequencer  is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU Affero General Public License
+* along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "casper/job/sequencer/protocol.h"
+
+#include "cc/exception.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+namespace
+{
+
+    /**
+     * @return Unwrapped body, as a string.
+     */
+    std::string Unwrap (const std::string& a_message)
+    {
+        const char* body   = nullptr;
+        size_t      length = 0;
+        casper::job::sequencer::Protocol::Unwrap(a_message, body, length);
+        return std::string(body, length);
+    }
+
+    /**
+     * @return Status, or '<full parse>' if a full parse is required.
+     */
+    std::string PeekStatus (const std::string& a_body)
+    {
+        std::string status;
+        if ( false == casper::job::sequencer::Protocol::PeekStatus(a_body.data(), a_body.length(), status) ) {
+            return "<full parse>";
+        }
+        return status;
+    }
+
+} // end of anonymous namespace
+
+TEST(Protocol, Unwrap)
+{
+    EXPECT_EQ("{\"status\":\"completed\"}", Unwrap("*200,16,application/json,22,{\"status\":\"completed\"}"));
+    EXPECT_EQ("", Unwrap("*200,16,application/json,0,"));
+    // ... content-type length is honored, even if it contains ',' ...
+    EXPECT_EQ("{}", Unwrap("*500,3,a,b,2,{}"));
+    // ... trailing bytes are not part of body ...
+    EXPECT_EQ("{}", Unwrap("*200,16,application/json,2,{}garbage"));
+}
+
+TEST(Protocol, UnwrapTruncated)
+{
+    const std::string message = "*200,16,application/json,22,{\"status\":\"completed\"}";
+    for ( size_t length = 0 ; length < message.length() ; ++length ) {
+        EXPECT_THROW(Unwrap(message.substr(0, length)), ::cc::Exception) << "length " << length;
+    }
+    EXPECT_NO_THROW(Unwrap(message));
+}
+
+TEST(Protocol, UnwrapMalformed)
+{
+    EXPECT_THROW(Unwrap("{\"status\":\"completed\"}"), ::cc::Exception);
+    EXPECT_THROW(Unwrap("*,16,application/json,2,{}"), ::cc::Exception);
+    EXPECT_THROW(Unwrap("*200,x,application/json,2,{}"), ::cc::Exception);
+    EXPECT_THROW(Unwrap("*200,17,application/json,2,{}"), ::cc::Exception);
+    EXPECT_THROW(Unwrap("*200,99,application/json,2,{}"), ::cc::Exception);
+    EXPECT_THROW(Unwrap("*200,16,application/json,3,{}"), ::cc::Exception);
+    EXPECT_THROW(Unwrap("*200,16,application/json,-1,{}"), ::cc::Exception);
+    // ... overflowing lengths must not wrap around ...
+    EXPECT_THROW(Unwrap("*200,16,application/json,184467440737095516160,{}"), ::cc::Exception);
+    EXPECT_THROW(Unwrap("*200,18446744073709551615,application/json,2,{}"), ::cc::Exception);
+}
+
+TEST(Protocol, PeekStatus)
+{
+    EXPECT_EQ("completed", PeekStatus("{\"status\":\"completed\"}"));
+    EXPECT_EQ("failed", PeekStatus(" \r\n{ \"a\" : [1, -2.5e+3, true, false, null, {\"status\":\"x\"}], \"status\" : \"failed\" }\n"));
+    EXPECT_EQ("", PeekStatus("{\"status\":\"\"}"));
+    // ... nested 'status' keys and 'status' values are ignored ...
+    EXPECT_EQ("in-progress", PeekStatus("{\"a\":{\"status\":\"completed\"},\"b\":\"status\",\"status\":\"in-progress\"}"));
+    // ... as a full parse does, last one wins ...
+    EXPECT_EQ("completed", PeekStatus("{\"status\":\"failed\",\"status\":\"completed\"}"));
+    // ... escapes elsewhere are fine ...
+    EXPECT_EQ("completed", PeekStatus("{\"message\":\"say \\\"hi\\\"\",\"status\":\"completed\"}"));
+}
+
+TEST(Protocol, PeekStatusRequiresFullParse)
+{
+    EXPECT_EQ("<full parse>", PeekStatus(""));
+    EXPECT_EQ("<full parse>", PeekStatus("[]"));
+    EXPECT_EQ("<full parse>", PeekStatus("{}"));
+    EXPECT_EQ("<full parse>", PeekStatus("{\"a\":1}"));
+    EXPECT_EQ("<full parse>", PeekStatus("{\"status\":1}"));
+    EXPECT_EQ("<full parse>", PeekStatus("{\"status\":null}"));
+    EXPECT_EQ("<full parse>", PeekStatus("{\"status\":\"com\\u0070leted\"}"));
+    EXPECT_EQ("<full parse>", PeekStatus("{\"st\\u0061tus\":\"completed\"}"));
+    EXPECT_EQ("<full parse>", PeekStatus("{\"status\":\"completed\"}x"));
+    EXPECT_EQ("<full parse>", PeekStatus("{\"status\":\"completed\",\"a\":[}"));
+    EXPECT_EQ("<full parse>", PeekStatus("{\"status\":\"completed\",\"a\":tru}"));
+    EXPECT_EQ("<full parse>", PeekStatus("{\"status\" \"completed\"}"));
+    // ... too deep ...
+    EXPECT_EQ("<full parse>", PeekStatus("{\"status\":\"completed\",\"a\":" + std::string(64, '[') + std::string(64, ']') + "}"));
+}
+
+TEST(Protocol, PeekStatusTruncated)
+{
+    const std::string body = "{\"a\":{\"b\":[1,2,\"}\"]},\"status\":\"completed\"}";
+    for ( size_t length = 0 ; length < body.length() ; ++length ) {
+        EXPECT_EQ("<full parse>", PeekStatus(body.substr(0, length))) << "length " << length;
+    }
+    EXPECT_EQ("completed", PeekStatus(body));
+}
@@ -0,0 +1,126 @@
+/**
+* @file ring-test.cc
+*
+* Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+*
+* This file is part of casper-job-sequencer.
+*
+* casper-job-sequencer is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Affero General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* casper-job-sequencer  is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU Affero General Public License
+* along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "casper/job/sequencer/ring.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(Ring, CapacityIsRoundedUp)
+{
+    casper::job::sequencer::Ring<int> ring(3);
+    int value;
+
+    EXPECT_FALSE(ring.Pop(value));
+    for ( int idx = 0 ; idx < 4 ; ++idx ) {
+        EXPECT_TRUE(ring.Push(int(idx)));
+    }
+    EXPECT_EQ(4u, ring.size());
+    EXPECT_FALSE(ring.Push(4));
+    for ( int idx = 0 ; idx < 4 ; ++idx ) {
+        ASSERT_TRUE(ring.Pop(value));
+        EXPECT_EQ(idx, value);
+    }
+    EXPECT_FALSE(ring.Pop(value));
+    EXPECT_EQ(0u, ring.size());
+}
+
+TEST(Ring, OverflowLeavesValueUntouched)
+{
+    casper::job::sequencer::Ring<std::string> ring(2);
+    std::string value = "payload";
+
+    EXPECT_TRUE(ring.Push(std::string("a")));
+    EXPECT_TRUE(ring.Push(std::string("b")));
+    EXPECT_FALSE(ring.Push(std::move(value)));
+    EXPECT_EQ("payload", value);
+
+    ASSERT_TRUE(ring.Pop(value));
+    EXPECT_EQ("a", value);
+    EXPECT_TRUE(ring.Push(std::string("c")));
+    ASSERT_TRUE(ring.Pop(value));
+    EXPECT_EQ("b", value);
+    ASSERT_TRUE(ring.Pop(value));
+    EXPECT_EQ("c", value);
+}
+
+TEST(Ring, WrapsAround)
+{
+    casper::job::sequencer::Ring<size_t> ring(8);
+    size_t next  = 0;
+    size_t value = 0;
+
+    // ... positions go well past capacity, keeping 1 to 5 values queued ...
+    for ( size_t round = 0 ; round < 1000 ; ++round ) {
+        const size_t count = 1 + round % 5;
+        for ( size_t idx = 0 ; idx < count ; ++idx ) {
+            ASSERT_TRUE(ring.Push(round * 10 + idx));
+        }
+        for ( size_t idx = 0 ; idx < count ; ++idx ) {
+            ASSERT_TRUE(ring.Pop(value));
+            EXPECT_EQ(round * 10 + idx, value);
+            ++next;
+        }
+    }
+    EXPECT_FALSE(ring.Pop(value));
+    EXPECT_EQ(3000u, next);
+}
+
+TEST(Ring, MultipleProducers)
+{
+    const size_t                         producers = 4;
+    const size_t                         count     = 100000;
+    casper::job::sequencer::Ring<size_t> ring(64);
+    std::vector<std::thread>             threads;
+
+    for ( size_t producer = 0 ; producer < producers ; ++producer ) {
+        threads.emplace_back([&ring, producer, count] () {
+            for ( size_t idx = 0 ; idx < count ; ++idx ) {
+                while ( false == ring.Push(producer * count + idx) ) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // ... each producer values must be received in order, none lost nor duplicated ...
+    std::vector<size_t> next(producers, 0);
+    size_t              received = 0;
+    size_t              value;
+    while ( received < producers * count ) {
+        if ( false == ring.Pop(value) ) {
+            std::this_thread::yield();
+            continue;
+        }
+        const size_t producer = value / count;
+        ASSERT_LT(producer, producers);
+        ASSERT_EQ(next[producer], value % count);
+        next[producer]++;
+        received++;
+    }
+    for ( auto& thread : threads ) {
+        thread.join();
+    }
+    EXPECT_FALSE(ring.Pop(value));
+}
@@ -0,0 +1,1808 @@
+/**
+* @file sequencer-e2e-bench.cc
+*
+* Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+*
+* This file is part of casper-job-sequencer.
+*
+* casper-job-sequencer is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Affero General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* casper-job-sequencer  is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU Affero General Public License
+* along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <signal.h>
+#include <unistd.h>
+#include <poll.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "json/json.h"
+
+#include "casper/job/sequencer/protocol.h"
+
+namespace
+{
+
+    /**
+     * @return Monotonic clock, in microseconds.
+     */
+    uint64_t Now ()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * @brief Serialize a JSON value, without ending line feed.
+     */
+    std::string ToString (const Json::Value& a_value)
+    {
+        Json::FastWriter fw; fw.omitEndingLineFeed();
+        return fw.write(a_value);
+    }
+
+    /**
+     * @brief Parse a JSON message, unwrapping it first if it's a primitive protocol message.
+     *
+     * @return True on success, false otherwise.
+     */
+    bool ParseMessage (const std::string& a_message, Json::Value& o_value)
+    {
+        const char* body   = a_message.data();
+        size_t      length = a_message.length();
+        try {
+            if ( 0 != length && '*' == body[0] ) {
+                casper::job::sequencer::Protocol::Unwrap(a_message, body, length);
+            }
+        } catch (...) {
+            return false;
+        }
+        Json::Reader reader;
+        return reader.parse(body, body + length, o_value, /* a_collect_comments */ false);
+    }
+
+    // MARK: - TCP
+
+    /**
+     * @brief A blocking, buffered, TCP connection.
+     */
+    class Connection final
+    {
+
+    private: // Data
+
+        int         fd_;
+        std::string buffer_;
+        std::mutex  write_mutex_;
+
+    public: // Constructor(s) / Destructor
+
+        Connection (const int a_fd)
+            : fd_(a_fd)
+        {
+            const int one = 1;
+            (void)setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+
+        ~Connection ()
+        {
+            close(fd_);
+        }
+
+    public: // Method(s) / Function(s)
+
+        /**
+         * @brief Read more data into buffer.
+         *
+         * @return False if peer closed connection or on error.
+         */
+        bool Fill ()
+        {
+            char    chunk[16384];
+            ssize_t rv;
+            do {
+                rv = recv(fd_, chunk, sizeof(chunk), 0);
+            } while ( -1 == rv && EINTR == errno );
+            if ( rv <= 0 ) {
+                return false;
+            }
+            buffer_.append(chunk, static_cast<size_t>(rv));
+            return true;
+        }
+
+        /**
+         * @brief Read a '\r\n' terminated line ( terminator is not included ).
+         */
+        bool ReadLine (std::string& o_line)
+        {
+            size_t pos;
+            while ( std::string::npos == ( pos = buffer_.find("\r\n") ) ) {
+                if ( false == Fill() ) {
+                    return false;
+                }
+            }
+            o_line = buffer_.substr(0, pos);
+            buffer_.erase(0, pos + 2);
+            return true;
+        }
+
+        /**
+         * @brief Read exactly N bytes.
+         */
+        bool Read (const size_t a_length, std::string& o_data)
+        {
+            while ( buffer_.length() < a_length ) {
+                if ( false == Fill() ) {
+                    return false;
+                }
+            }
+            o_data = buffer_.substr(0, a_length);
+            buffer_.erase(0, a_length);
+            return true;
+        }
+
+        /**
+         * @return True if there is buffered data, not yet consumed.
+         */
+        bool Buffered () const
+        {
+            return 0 != buffer_.length();
+        }
+
+        /**
+         * @return True if peer has closed it's side of the connection.
+         */
+        bool Closed () const
+        {
+            char          byte;
+            const ssize_t rv = recv(fd_, &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+            return ( 0 == rv || ( -1 == rv && EAGAIN != errno && EWOULDBLOCK != errno && EINTR != errno ) );
+        }
+
+        /**
+         * @brief Write all data, can be called from any thread.
+         */
+        bool Write (const std::string& a_data)
+        {
+            std::lock_guard<std::mutex> lock(write_mutex_);
+            size_t offset = 0;
+            while ( offset < a_data.length() ) {
+                const ssize_t rv = send(fd_, a_data.data() + offset, a_data.length() - offset, MSG_NOSIGNAL);
+                if ( rv < 0 ) {
+                    if ( EINTR == errno ) {
+                        continue;
+                    }
+                    return false;
+                }
+                offset += static_cast<size_t>(rv);
+            }
+            return true;
+        }
+
+    }; // end of class 'Connection'
+
+    /**
+     * @brief A TCP server listening on 127.0.0.1, one thread per connection.
+     */
+    class Server
+    {
+
+    private: // Data
+
+        int      fd_;
+        uint16_t port_;
+
+    public: // Constructor(s) / Destructor
+
+        Server ()
+            : fd_(-1), port_(0)
+        {
+            /* empty */
+        }
+
+        virtual ~Server ()
+        {
+            /* empty, never destroyed */
+        }
+
+    public: // Method(s) / Function(s)
+
+        /**
+         * @brief Listen on an ephemeral port and start accepting connections.
+         */
+        void Start ()
+        {
+            fd_ = socket(AF_INET, SOCK_STREAM, 0);
+            const int one = 1;
+            (void)setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            struct sockaddr_in addr;
+            memset(&addr, 0, sizeof(addr));
+            addr.sin_family      = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr.sin_port        = 0;
+            if ( 0 != bind(fd_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) || 0 != listen(fd_, 128) ) {
+                fprintf(stderr, "unable to listen: %s\n", strerror(errno));
+                exit(-1);
+            }
+            socklen_t len = sizeof(addr);
+            (void)getsockname(fd_, reinterpret_cast<struct sockaddr*>(&addr), &len);
+            port_ = ntohs(addr.sin_port);
+            std::thread([this] () {
+                while ( true ) {
+                    const int fd = accept(fd_, nullptr, nullptr);
+                    if ( -1 == fd ) {
+                        if ( EINTR == errno || ECONNABORTED == errno ) {
+                            continue;
+                        }
+                        return;
+                    }
+                    std::thread([this, fd] () {
+                        std::shared_ptr<Connection> connection = std::make_shared<Connection>(fd);
+                        Serve(connection);
+                        Disconnected(connection);
+                    }).detach();
+                }
+            }).detach();
+        }
+
+        uint16_t port () const
+        {
+            return port_;
+        }
+
+    protected: // Virtual Method(s) / Function(s)
+
+        virtual void Serve        (const std::shared_ptr<Connection>& a_connection) = 0;
+        virtual void Disconnected (const std::shared_ptr<Connection>& /* a_connection */) { }
+
+    }; // end of class 'Server'
+
+    // MARK: - BEANSTALKD
+
+    /**
+     * @brief In-process beanstalkd stand-in, only the commands used by jobs and the sequencer are implemented.
+     */
+    class FakeBeanstalkd final : public Server
+    {
+
+    public: // Data Type(s)
+
+        typedef struct {
+            uint64_t    id_;
+            std::string tube_;
+            std::string data_;
+        } Job;
+
+        typedef std::function<void(const std::string& a_tube, const std::string& a_data)> PutCallback;
+
+    private: // Data
+
+        std::mutex                                   mutex_;
+        std::condition_variable                      cv_;
+        uint64_t                                     next_id_;
+        std::map<std::string, std::deque<Job>>       ready_;
+        std::map<uint64_t, Job>                      reserved_;
+        std::map<std::string, size_t>                watchers_;
+        PutCallback                                  on_put_;
+
+    public: // Constructor(s) / Destructor
+
+        FakeBeanstalkd ()
+            : next_id_(1)
+        {
+            /* empty */
+        }
+
+    public: // Method(s) / Function(s)
+
+        void SetPutCallback (PutCallback a_callback)
+        {
+            on_put_ = a_callback;
+        }
+
+        /**
+         * @brief Put a job ( in-process producers ).
+         */
+        uint64_t Put (const std::string& a_tube, const std::string& a_data)
+        {
+            uint64_t id;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                id = next_id_++;
+                ready_[a_tube].push_back({ id, a_tube, a_data });
+            }
+            if ( nullptr != on_put_ ) {
+                on_put_(a_tube, a_data);
+            }
+            cv_.notify_all();
+            return id;
+        }
+
+        /**
+         * @brief Reserve a job from any tube but the excluded one ( in-process workers ).
+         *
+         * @return True if a job was reserved, false on timeout.
+         */
+        bool ReserveAny (const std::string& a_excluded, const uint64_t a_timeout_ms, Job& o_job)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(a_timeout_ms);
+            while ( true ) {
+                for ( auto& it : ready_ ) {
+                    if ( it.first == a_excluded || 0 == it.second.size() ) {
+                        continue;
+                    }
+                    o_job = it.second.front();
+                    it.second.pop_front();
+                    return true;
+                }
+                if ( std::cv_status::timeout == cv_.wait_until(lock, deadline) ) {
+                    return false;
+                }
+            }
+        }
+
+        /**
+         * @return Number of connections watching a tube.
+         */
+        size_t Watchers (const std::string& a_tube)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const auto it = watchers_.find(a_tube);
+            return ( watchers_.end() != it ? it->second : 0 );
+        }
+
+        /**
+         * @brief Drop all jobs.
+         */
+        void Reset ()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ready_.clear();
+            reserved_.clear();
+        }
+
+    protected: // Method(s) / Function(s)
+
+        void Serve (const std::shared_ptr<Connection>& a_connection) override
+        {
+            std::string           used    = "default";
+            std::set<std::string> watched = { "default" };
+            Watch(watched, "default", true);
+
+            std::string line;
+            while ( true == a_connection->ReadLine(line) ) {
+                std::istringstream is(line);
+                std::string        command;
+                is >> command;
+                if ( 0 == command.compare("put") ) {
+                    unsigned pri, delay, ttr; size_t bytes;
+                    is >> pri >> delay >> ttr >> bytes;
+                    std::string data;
+                    if ( false == a_connection->Read(bytes + 2, data) ) {
+                        break;
+                    }
+                    data.resize(bytes);
+                    a_connection->Write("INSERTED " + std::to_string(Put(used, data)) + "\r\n");
+                } else if ( 0 == command.compare("use") ) {
+                    is >> used;
+                    a_connection->Write("USING " + used + "\r\n");
+                } else if ( 0 == command.compare("watch") ) {
+                    std::string tube; is >> tube;
+                    Watch(watched, tube, true);
+                    a_connection->Write("WATCHING " + std::to_string(watched.size()) + "\r\n");
+                } else if ( 0 == command.compare("ignore") ) {
+                    std::string tube; is >> tube;
+                    if ( 1 == watched.size() && 1 == watched.count(tube) ) {
+                        a_connection->Write("NOT_IGNORED\r\n");
+                    } else {
+                        Watch(watched, tube, false);
+                        a_connection->Write("WATCHING " + std::to_string(watched.size()) + "\r\n");
+                    }
+                } else if ( 0 == command.compare("reserve") || 0 == command.compare("reserve-with-timeout") ) {
+                    int64_t timeout = -1;
+                    if ( 0 == command.compare("reserve-with-timeout") ) {
+                        is >> timeout;
+                    }
+                    Job job;
+                    if ( false == Reserve(a_connection, watched, timeout, job) ) {
+                        if ( true == a_connection->Closed() ) {
+                            break;
+                        }
+                        a_connection->Write("TIMED_OUT\r\n");
+                    } else {
+                        a_connection->Write("RESERVED " + std::to_string(job.id_) + " " + std::to_string(job.data_.length()) + "\r\n" + job.data_ + "\r\n");
+                    }
+                } else if ( 0 == command.compare("delete") ) {
+                    uint64_t id = 0; is >> id;
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    a_connection->Write(( 1 == reserved_.erase(id) ? "DELETED\r\n" : "NOT_FOUND\r\n" ));
+                } else if ( 0 == command.compare("release") ) {
+                    uint64_t id = 0; is >> id;
+                    bool released = false;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        const auto it = reserved_.find(id);
+                        if ( reserved_.end() != it ) {
+                            ready_[it->second.tube_].push_back(it->second);
+                            reserved_.erase(it);
+                            released = true;
+                        }
+                    }
+                    cv_.notify_all();
+                    a_connection->Write(( true == released ? "RELEASED\r\n" : "NOT_FOUND\r\n" ));
+                } else if ( 0 == command.compare("bury") ) {
+                    uint64_t id = 0; is >> id;
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    a_connection->Write(( 1 == reserved_.erase(id) ? "BURIED\r\n" : "NOT_FOUND\r\n" ));
+                } else if ( 0 == command.compare("touch") ) {
+                    a_connection->Write("TOUCHED\r\n");
+                } else if ( 0 == command.compare("list-tube-used") ) {
+                    a_connection->Write("USING " + used + "\r\n");
+                } else if ( 0 == command.compare("quit") ) {
+                    break;
+                } else if ( 0 == command.compare(0, 4, "peek") || 0 == command.compare("kick-job") ) {
+                    a_connection->Write("NOT_FOUND\r\n");
+                } else if ( 0 == command.compare(0, 5, "stats") || 0 == command.compare(0, 10, "list-tubes") ) {
+                    const std::string yaml = "---\n";
+                    a_connection->Write("OK " + std::to_string(yaml.length()) + "\r\n" + yaml + "\r\n");
+                } else {
+                    a_connection->Write("UNKNOWN_COMMAND\r\n");
+                }
+            }
+
+            for ( auto tube : std::set<std::string>(watched) ) {
+                Watch(watched, tube, false);
+            }
+        }
+
+    private: // Method(s) / Function(s)
+
+        void Watch (std::set<std::string>& io_watched, const std::string& a_tube, const bool a_watch)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if ( true == a_watch ) {
+                if ( true == io_watched.insert(a_tube).second ) {
+                    watchers_[a_tube]++;
+                }
+            } else if ( 1 == io_watched.erase(a_tube) ) {
+                watchers_[a_tube]--;
+            }
+        }
+
+        bool Reserve (const std::shared_ptr<Connection>& a_connection, const std::set<std::string>& a_watched, const int64_t a_timeout_s, Job& o_job)
+        {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(a_timeout_s < 0 ? 0 : a_timeout_s);
+            std::unique_lock<std::mutex> lock(mutex_);
+            while ( true ) {
+                // ... peer gone? must be checked first, or a dead connection would steal a job ...
+                if ( false == a_connection->Buffered() && true == a_connection->Closed() ) {
+                    return false;
+                }
+                for ( const auto& tube : a_watched ) {
+                    auto it = ready_.find(tube);
+                    if ( ready_.end() == it || 0 == it->second.size() ) {
+                        continue;
+                    }
+                    o_job = it->second.front();
+                    it->second.pop_front();
+                    reserved_[o_job.id_] = o_job;
+                    return true;
+                }
+                if ( a_timeout_s >= 0 && std::chrono::steady_clock::now() >= deadline ) {
+                    return false;
+                }
+                cv_.wait_for(lock, std::chrono::milliseconds(100));
+            }
+        }
+
+    }; // end of class 'FakeBeanstalkd'
+
+    // MARK: - REDIS
+
+    /**
+     * @brief In-process REDIS stand-in, RESP2, strings, hashes and pub/sub only.
+     */
+    class FakeRedis final : public Server
+    {
+
+    public: // Data Type(s)
+
+        typedef std::function<void(const std::string& a_channel, const std::string& a_message)> PublishCallback;
+
+    private: // Data Type(s)
+
+        typedef struct {
+            std::set<std::string> channels_;
+            std::set<std::string> patterns_;
+        } Subscriptions;
+
+    private: // Data
+
+        std::mutex                                                 mutex_;
+        std::map<std::string, std::string>                         strings_;
+        std::map<std::string, std::map<std::string, std::string>>  hashes_;
+        std::map<std::shared_ptr<Connection>, Subscriptions>       subscribers_;
+        PublishCallback                                            on_publish_;
+
+    public: // Method(s) / Function(s)
+
+        void SetPublishCallback (PublishCallback a_callback)
+        {
+            on_publish_ = a_callback;
+        }
+
+        /**
+         * @brief INCR ( in-process clients ).
+         */
+        int64_t Incr (const std::string& a_key)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::string& value = strings_[a_key];
+            const int64_t next = ( 0 == value.length() ? 0 : strtoll(value.c_str(), nullptr, 10) ) + 1;
+            value = std::to_string(next);
+            return next;
+        }
+
+        /**
+         * @brief HSET ( in-process clients ).
+         */
+        void HSet (const std::string& a_key, const std::string& a_field, const std::string& a_value)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            hashes_[a_key][a_field] = a_value;
+        }
+
+        /**
+         * @brief PUBLISH ( in-process clients ).
+         *
+         * @return Number of subscribers that received the message.
+         */
+        size_t Publish (const std::string& a_channel, const std::string& a_message)
+        {
+            std::vector<std::pair<std::shared_ptr<Connection>, std::string>> deliveries;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for ( const auto& it : subscribers_ ) {
+                    if ( 1 == it.second.channels_.count(a_channel) ) {
+                        deliveries.push_back(std::make_pair(it.first, Array({ "message", a_channel, a_message })));
+                    }
+                    for ( const auto& pattern : it.second.patterns_ ) {
+                        if ( 0 == fnmatch(pattern.c_str(), a_channel.c_str(), 0) ) {
+                            deliveries.push_back(std::make_pair(it.first, Array({ "pmessage", pattern, a_channel, a_message })));
+                        }
+                    }
+                }
+            }
+            if ( nullptr != on_publish_ ) {
+                on_publish_(a_channel, a_message);
+            }
+            for ( const auto& delivery : deliveries ) {
+                (void)delivery.first->Write(delivery.second);
+            }
+            return deliveries.size();
+        }
+
+        /**
+         * @brief Drop all keys.
+         */
+        void Reset ()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            strings_.clear();
+            hashes_.clear();
+        }
+
+    protected: // Method(s) / Function(s)
+
+        void Serve (const std::shared_ptr<Connection>& a_connection) override
+        {
+            std::vector<std::string> args;
+            while ( true == ReadCommand(a_connection, args) ) {
+                if ( 0 == args.size() ) {
+                    continue;
+                }
+                std::string command = args[0];
+                std::transform(command.begin(), command.end(), command.begin(), ::toupper);
+                a_connection->Write(Execute(a_connection, command, args));
+            }
+        }
+
+        void Disconnected (const std::shared_ptr<Connection>& a_connection) override
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            subscribers_.erase(a_connection);
+        }
+
+    private: // Method(s) / Function(s)
+
+        static std::string Bulk (const std::string& a_value)
+        {
+            return "$" + std::to_string(a_value.length()) + "\r\n" + a_value + "\r\n";
+        }
+
+        static std::string Integer (const int64_t a_value)
+        {
+            return ":" + std::to_string(a_value) + "\r\n";
+        }
+
+        static std::string Array (const std::vector<std::string>& a_values)
+        {
+            std::string reply = "*" + std::to_string(a_values.size()) + "\r\n";
+            for ( const auto& value : a_values ) {
+                reply += Bulk(value);
+            }
+            return reply;
+        }
+
+        bool ReadCommand (const std::shared_ptr<Connection>& a_connection, std::vector<std::string>& o_args)
+        {
+            o_args.clear();
+            std::string line;
+            if ( false == a_connection->ReadLine(line) ) {
+                return false;
+            }
+            // ... inline command?
+            if ( 0 == line.length() || '*' != line[0] ) {
+                std::istringstream is(line);
+                std::string        arg;
+                while ( is >> arg ) {
+                    o_args.push_back(arg);
+                }
+                return true;
+            }
+            const long count = strtol(line.c_str() + 1, nullptr, 10);
+            for ( long idx = 0 ; idx < count ; ++idx ) {
+                if ( false == a_connection->ReadLine(line) || 0 == line.length() || '$' != line[0] ) {
+                    return false;
+                }
+                std::string arg;
+                if ( false == a_connection->Read(static_cast<size_t>(strtol(line.c_str() + 1, nullptr, 10)) + 2, arg) ) {
+                    return false;
+                }
+                arg.resize(arg.length() - 2);
+                o_args.push_back(std::move(arg));
+            }
+            return true;
+        }
+
+        std::string Execute (const std::shared_ptr<Connection>& a_connection, const std::string& a_command, const std::vector<std::string>& a_args)
+        {
+            if ( 0 == a_command.compare("PING") ) {
+                return "+PONG\r\n";
+            } else if ( 0 == a_command.compare("AUTH") || 0 == a_command.compare("SELECT") || 0 == a_command.compare("CLIENT") ) {
+                return "+OK\r\n";
+            } else if ( 0 == a_command.compare("INCR") && 2 == a_args.size() ) {
+                return Integer(Incr(a_args[1]));
+            } else if ( 0 == a_command.compare("PUBLISH") && 3 == a_args.size() ) {
+                return Integer(static_cast<int64_t>(Publish(a_args[1], a_args[2])));
+            } else if ( 0 == a_command.compare("SUBSCRIBE") || 0 == a_command.compare("PSUBSCRIBE")
+                       || 0 == a_command.compare("UNSUBSCRIBE") || 0 == a_command.compare("PUNSUBSCRIBE") ) {
+                return Subscribe(a_connection, a_command, a_args);
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if ( 0 == a_command.compare("SET") && a_args.size() >= 3 ) {
+                strings_[a_args[1]] = a_args[2];
+                return "+OK\r\n";
+            } else if ( 0 == a_command.compare("GET") && 2 == a_args.size() ) {
+                const auto it = strings_.find(a_args[1]);
+                return ( strings_.end() != it ? Bulk(it->second) : "$-1\r\n" );
+            } else if ( 0 == a_command.compare("DEL") ) {
+                int64_t count = 0;
+                for ( size_t idx = 1 ; idx < a_args.size() ; ++idx ) {
+                    count += static_cast<int64_t>(strings_.erase(a_args[idx]) + hashes_.erase(a_args[idx]));
+                }
+                return Integer(count);
+            } else if ( 0 == a_command.compare("EXISTS") && 2 == a_args.size() ) {
+                return Integer(( 1 == strings_.count(a_args[1]) || 1 == hashes_.count(a_args[1]) ) ? 1 : 0);
+            } else if ( ( 0 == a_command.compare("EXPIRE") || 0 == a_command.compare("PEXPIRE") ) && 3 == a_args.size() ) {
+                // ... keys never expire, the matrix is too short for it to matter ...
+                return Integer(( 1 == strings_.count(a_args[1]) || 1 == hashes_.count(a_args[1]) ) ? 1 : 0);
+            } else if ( 0 == a_command.compare("TTL") ) {
+                return Integer(-1);
+            } else if ( ( 0 == a_command.compare("HSET") || 0 == a_command.compare("HMSET") ) && a_args.size() >= 4 && 0 == ( a_args.size() % 2 ) ) {
+                auto&   hash  = hashes_[a_args[1]];
+                int64_t added = 0;
+                for ( size_t idx = 2 ; idx + 1 < a_args.size() ; idx += 2 ) {
+                    added += ( hash.end() == hash.find(a_args[idx]) ? 1 : 0 );
+                    hash[a_args[idx]] = a_args[idx + 1];
+                }
+                return ( 0 == a_command.compare("HSET") ? Integer(added) : "+OK\r\n" );
+            } else if ( 0 == a_command.compare("HGET") && 3 == a_args.size() ) {
+                const auto h = hashes_.find(a_args[1]);
+                if ( hashes_.end() == h ) {
+                    return "$-1\r\n";
+                }
+                const auto f = h->second.find(a_args[2]);
+                return ( h->second.end() != f ? Bulk(f->second) : "$-1\r\n" );
+            } else if ( 0 == a_command.compare("HMGET") && a_args.size() >= 3 ) {
+                const auto  h     = hashes_.find(a_args[1]);
+                std::string reply = "*" + std::to_string(a_args.size() - 2) + "\r\n";
+                for ( size_t idx = 2 ; idx < a_args.size() ; ++idx ) {
+                    if ( hashes_.end() == h || h->second.end() == h->second.find(a_args[idx]) ) {
+                        reply += "$-1\r\n";
+                    } else {
+                        reply += Bulk(h->second.find(a_args[idx])->second);
+                    }
+                }
+                return reply;
+            } else if ( 0 == a_command.compare("HGETALL") && 2 == a_args.size() ) {
+                std::vector<std::string> values;
+                const auto h = hashes_.find(a_args[1]);
+                if ( hashes_.end() != h ) {
+                    for ( const auto& f : h->second ) {
+                        values.push_back(f.first);
+                        values.push_back(f.second);
+                    }
+                }
+                return Array(values);
+            } else if ( 0 == a_command.compare("HDEL") && a_args.size() >= 3 ) {
+                int64_t count = 0;
+                const auto h = hashes_.find(a_args[1]);
+                if ( hashes_.end() != h ) {
+                    for ( size_t idx = 2 ; idx < a_args.size() ; ++idx ) {
+                        count += static_cast<int64_t>(h->second.erase(a_args[idx]));
+                    }
+                }
+                return Integer(count);
+            } else if ( 0 == a_command.compare("INFO") ) {
+                return Bulk("# Server\r\nredis_version:6.0.0\r\n");
+            }
+            return "-ERR unknown command '" + a_command + "'\r\n";
+        }
+
+        std::string Subscribe (const std::shared_ptr<Connection>& a_connection, const std::string& a_command, const std::vector<std::string>& a_args)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Subscriptions&         subscriptions = subscribers_[a_connection];
+            const bool             pattern       = ( 'P' == a_command[0] );
+            const bool             subscribe     = ( std::string::npos == a_command.find("UNSUB") );
+            std::set<std::string>& set           = ( true == pattern ? subscriptions.patterns_ : subscriptions.channels_ );
+            std::string            kind          = a_command;
+            std::transform(kind.begin(), kind.end(), kind.begin(), ::tolower);
+
+            std::vector<std::string> names(a_args.begin() + 1, a_args.end());
+            if ( false == subscribe && 0 == names.size() ) {
+                names.assign(set.begin(), set.end());
+            }
+            std::string reply;
+            if ( 0 == names.size() ) {
+                reply = "*3\r\n" + Bulk(kind) + "$-1\r\n" + Integer(0);
+            }
+            for ( const auto& name : names ) {
+                if ( true == subscribe ) {
+                    set.insert(name);
+                } else {
+                    set.erase(name);
+                }
+                reply += "*3\r\n" + Bulk(kind) + Bulk(name) + Integer(static_cast<int64_t>(subscriptions.channels_.size() + subscriptions.patterns_.size()));
+            }
+            return reply;
+        }
+
+    }; // end of class 'FakeRedis'
+
+    // MARK: - POSTGRESQL
+
+    /**
+     * @brief In-process PostgreSQL stand-in, simple query protocol, implementing the js.* functions called by the sequencer.
+     */
+    class FakePostgreSQL final : public Server
+    {
+
+    private: // Data Type(s)
+
+        enum : uint32_t {
+            INT4OID   = 23,
+            TEXTOID   = 25,
+            FLOAT8OID = 701,
+            JSONBOID  = 3802
+        };
+
+        typedef struct {
+            std::string name_;
+            uint32_t    oid_;
+        } Column;
+
+        typedef struct {
+            std::vector<Column>                    columns_;
+            std::vector<std::vector<Json::Value>>  rows_;
+        } Result;
+
+        typedef struct {
+            int64_t     id_;
+            size_t      index_;
+            Json::Value job_;
+            std::string status_;
+            Json::Value response_;
+            uint64_t    started_at_;
+        } Activity;
+
+        typedef struct {
+            int64_t               id_;
+            Json::Value           payload_;
+            std::vector<Activity> activities_;
+            uint64_t              started_at_;
+        } Sequence;
+
+    private: // Data
+
+        std::mutex                  mutex_;
+        int64_t                     next_id_;
+        std::map<int64_t, Sequence> sequences_;
+        std::map<int64_t, int64_t>  activities_; //!< Activity id to sequence id.
+
+    public: // Constructor(s) / Destructor
+
+        FakePostgreSQL ()
+            : next_id_(1)
+        {
+            /* empty */
+        }
+
+    public: // Method(s) / Function(s)
+
+        /**
+         * @brief Drop all rows.
+         */
+        void Reset ()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            sequences_.clear();
+            activities_.clear();
+        }
+
+    protected: // Method(s) / Function(s)
+
+        void Serve (const std::shared_ptr<Connection>& a_connection) override
+        {
+            // ... startup, possibly preceded by SSL / GSS encryption requests ...
+            while ( true ) {
+                std::string header;
+                if ( false == a_connection->Read(8, header) ) {
+                    return;
+                }
+                const uint32_t length = Int32(header, 0);
+                const uint32_t code   = Int32(header, 4);
+                std::string    rest;
+                if ( length < 8 || false == a_connection->Read(length - 8, rest) ) {
+                    return;
+                }
+                if ( 80877103 == code || 80877104 == code ) {
+                    a_connection->Write("N");
+                    continue;
+                }
+                if ( 80877102 == code ) {
+                    return;
+                }
+                break;
+            }
+            std::string hello = Message('R', Int32(0));
+            hello += Message('S', std::string("server_version\0" "12.0\0", 20));
+            hello += Message('S', std::string("server_encoding\0" "UTF8\0", 21));
+            hello += Message('S', std::string("client_encoding\0" "UTF8\0", 21));
+            hello += Message('S', std::string("DateStyle\0" "ISO, MDY\0", 19));
+            hello += Message('S', std::string("integer_datetimes\0" "on\0", 21));
+            hello += Message('S', std::string("standard_conforming_strings\0" "on\0", 31));
+            hello += Message('K', Int32(static_cast<uint32_t>(getpid())) + Int32(0));
+            hello += Message('Z', "I");
+            a_connection->Write(hello);
+
+            // ... messages ...
+            while ( true ) {
+                std::string header;
+                if ( false == a_connection->Read(5, header) ) {
+                    return;
+                }
+                const char     type   = header[0];
+                const uint32_t length = Int32(header, 1);
+                std::string    body;
+                if ( length < 4 || false == a_connection->Read(length - 4, body) ) {
+                    return;
+                }
+                if ( 'X' == type ) {
+                    return;
+                } else if ( 'Q' == type ) {
+                    a_connection->Write(Query(std::string(body.c_str())) + Message('Z', "I"));
+                } else if ( 'S' == type ) {
+                    a_connection->Write(Message('Z', "I"));
+                } else {
+                    a_connection->Write(Error("extended query protocol is not supported") + Message('Z', "I"));
+                }
+            }
+        }
+
+    private: // Method(s) / Function(s)
+
+        static uint32_t Int32 (const std::string& a_data, const size_t a_offset)
+        {
+            const unsigned char* ptr = reinterpret_cast<const unsigned char*>(a_data.data()) + a_offset;
+            return ( static_cast<uint32_t>(ptr[0]) << 24 ) | ( static_cast<uint32_t>(ptr[1]) << 16 ) | ( static_cast<uint32_t>(ptr[2]) << 8 ) | ptr[3];
+        }
+
+        static std::string Int32 (const uint32_t a_value)
+        {
+            const char bytes[4] = {
+                static_cast<char>(( a_value >> 24 ) & 0xFF), static_cast<char>(( a_value >> 16 ) & 0xFF),
+                static_cast<char>(( a_value >>  8 ) & 0xFF), static_cast<char>(a_value & 0xFF)
+            };
+            return std::string(bytes, 4);
+        }
+
+        static std::string Int16 (const uint16_t a_value)
+        {
+            const char bytes[2] = { static_cast<char>(( a_value >> 8 ) & 0xFF), static_cast<char>(a_value & 0xFF) };
+            return std::string(bytes, 2);
+        }
+
+        static std::string Message (const char a_type, const std::string& a_body)
+        {
+            return std::string(1, a_type) + Int32(static_cast<uint32_t>(a_body.length() + 4)) + a_body;
+        }
+
+        static std::string Error (const std::string& a_message)
+        {
+            return Message('E', std::string("SERROR\0", 7) + std::string("CXX000\0", 7) + "M" + a_message + std::string("\0\0", 2));
+        }
+
+        static std::string Serialize (const Result& a_result)
+        {
+            std::string description = Int16(static_cast<uint16_t>(a_result.columns_.size()));
+            for ( const auto& column : a_result.columns_ ) {
+                description += column.name_ + std::string("\0", 1);
+                description += Int32(0) + Int16(0) + Int32(column.oid_);
+                description += Int16(static_cast<uint16_t>(INT4OID == column.oid_ ? 4 : ( FLOAT8OID == column.oid_ ? 8 : 0xFFFF )));
+                description += Int32(0xFFFFFFFF) + Int16(0);
+            }
+            std::string reply = Message('T', description);
+            for ( const auto& row : a_result.rows_ ) {
+                std::string data = Int16(static_cast<uint16_t>(row.size()));
+                for ( const auto& value : row ) {
+                    if ( true == value.isNull() ) {
+                        data += Int32(0xFFFFFFFF);
+                        continue;
+                    }
+                    const std::string text = ( true == value.isString() ? value.asString() : ToString(value) );
+                    data += Int32(static_cast<uint32_t>(text.length())) + text;
+                }
+                reply += Message('D', data);
+            }
+            return reply + Message('C', "SELECT " + std::to_string(a_result.rows_.size()) + std::string("\0", 1));
+        }
+
+        /**
+         * @brief Split 'SELECT * FROM js.<function>(<args>);' into function name and literal arguments.
+         */
+        static bool Parse (const std::string& a_query, std::string& o_function, std::vector<std::string>& o_args)
+        {
+            const char* const prefix = "SELECT * FROM js.";
+            if ( 0 != a_query.compare(0, strlen(prefix), prefix) ) {
+                return false;
+            }
+            const size_t open = a_query.find('(');
+            if ( std::string::npos == open ) {
+                return false;
+            }
+            o_function = a_query.substr(strlen(prefix), open - strlen(prefix));
+            o_args.clear();
+            std::string arg;
+            bool        quoted = false;
+            for ( size_t idx = open + 1 ; idx < a_query.length() ; ++idx ) {
+                const char c = a_query[idx];
+                if ( true == quoted ) {
+                    if ( '\'' == c ) {
+                        if ( idx + 1 < a_query.length() && '\'' == a_query[idx + 1] ) {
+                            arg += '\'';
+                            ++idx;
+                        } else {
+                            quoted = false;
+                        }
+                    } else {
+                        arg += c;
+                    }
+                } else if ( '\'' == c ) {
+                    quoted = true;
+                } else if ( ',' == c || ')' == c ) {
+                    o_args.push_back(arg);
+                    arg.clear();
+                    if ( ')' == c ) {
+                        return true;
+                    }
+                } else if ( ' ' != c ) {
+                    arg += c;
+                }
+            }
+            return false;
+        }
+
+        static Json::Value JSON (const std::string& a_text)
+        {
+            Json::Value  value;
+            Json::Reader reader;
+            if ( false == reader.parse(a_text, value, /* a_collect_comments */ false) ) {
+                return Json::Value::null;
+            }
+            return value;
+        }
+
+        static double Seconds (const uint64_t a_since)
+        {
+            return static_cast<double>(Now() - a_since) / 1000000.0;
+        }
+
+        std::string Query (const std::string& a_query)
+        {
+            std::string              function;
+            std::vector<std::string> args;
+            if ( false == Parse(a_query, function, args) ) {
+                if ( 0 == a_query.compare(0, 3, "SET") ) {
+                    return Message('C', std::string("SET\0", 4));
+                }
+                return Serialize({ {}, {} });
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            Result result;
+            if ( 0 == function.compare("register_sequence") && 11 == args.size() ) {
+                // ... (pid, cid, iid, bjid, rjid, rcid, payload, activities, ttr, validity, timeout) ...
+                Sequence sequence;
+                sequence.id_         = next_id_++;
+                sequence.payload_    = JSON(args[6]);
+                sequence.started_at_ = Now();
+                const Json::Value jobs = JSON(args[7]);
+                result.columns_ = { { "sid", INT4OID }, { "id", INT4OID }, { "index", INT4OID }, { "job", JSONBOID } };
+                for ( Json::ArrayIndex idx = 0 ; idx < jobs.size() ; ++idx ) {
+                    sequence.activities_.push_back({ next_id_++, static_cast<size_t>(idx), jobs[idx], "Pending", Json::Value::null, 0 });
+                    activities_[sequence.activities_.back().id_] = sequence.id_;
+                    result.rows_.push_back({ Json::Int64(sequence.id_), Json::Int64(sequence.activities_.back().id_), Json::UInt(idx), jobs[idx] });
+                }
+                sequences_[sequence.id_] = std::move(sequence);
+            } else if ( 0 == function.compare("register_activity") && 8 == args.size() ) {
+                // ... (sid, id, bjid, rjid, rcid, attempt, payload, status) ...
+                Activity* activity = Find(args[0], args[1]);
+                if ( nullptr == activity ) {
+                    return Error("activity not found");
+                }
+                activity->status_     = args[7];
+                activity->started_at_ = Now();
+                result.columns_ = { { "id", INT4OID } };
+                result.rows_.push_back({ Json::Int64(activity->id_) });
+            } else if ( 0 == function.compare("finalize_activity") && 6 == args.size() ) {
+                // ... (sid, id, attempt, payload, response, status) ...
+                Activity* activity = Find(args[0], args[1]);
+                if ( nullptr == activity ) {
+                    return Error("activity not found");
+                }
+                activity->status_   = args[5];
+                activity->response_ = JSON(args[4]);
+                const Sequence& sequence = sequences_[strtoll(args[0].c_str(), nullptr, 10)];
+                result.columns_ = { { "rtt", FLOAT8OID }, { "sid", INT4OID }, { "id", INT4OID }, { "index", INT4OID }, { "job", JSONBOID } };
+                const size_t next = activity->index_ + 1;
+                if ( 0 == activity->status_.compare("Done") && next < sequence.activities_.size() ) {
+                    const Activity& n = sequence.activities_[next];
+                    result.rows_.push_back({ Seconds(activity->started_at_), Json::Int64(sequence.id_), Json::Int64(n.id_), Json::UInt(n.index_), n.job_ });
+                } else {
+                    result.rows_.push_back({ Seconds(activity->started_at_), Json::Int64(sequence.id_), Json::Value::null, Json::Value::null, Json::Value::null });
+                }
+            } else if ( 0 == function.compare("get_activities_responses") && 1 == args.size() ) {
+                // ... (sid) ...
+                const auto it = sequences_.find(strtoll(args[0].c_str(), nullptr, 10));
+                if ( sequences_.end() == it ) {
+                    return Error("sequence not found");
+                }
+                result.columns_ = { { "id", INT4OID }, { "index", INT4OID }, { "sid", INT4OID }, { "status", TEXTOID }, { "response", JSONBOID }, { "sequence", JSONBOID } };
+                for ( const auto& activity : it->second.activities_ ) {
+                    if ( true == activity.response_.isNull() ) {
+                        continue;
+                    }
+                    result.rows_.push_back({ Json::Int64(activity.id_), Json::UInt(activity.index_), Json::Int64(it->second.id_),
+                                             activity.status_, activity.response_, it->second.payload_ });
+                }
+                if ( 0 == result.rows_.size() ) {
+                    result.rows_.push_back({ Json::Value::null, Json::Value::null, Json::Int64(it->second.id_),
+                                             Json::Value::null, Json::Value::null, it->second.payload_ });
+                }
+            } else if ( ( 0 == function.compare("finalize_sequence") && 3 == args.size() ) || ( 0 == function.compare("cancel_sequence") && 2 == args.size() ) ) {
+                // ... (id, status, response) or (id, response) ...
+                const auto it = sequences_.find(strtoll(args[0].c_str(), nullptr, 10));
+                if ( sequences_.end() == it ) {
+                    return Error("sequence not found");
+                }
+                result.columns_ = { { "rtt", FLOAT8OID } };
+                result.rows_.push_back({ Seconds(it->second.started_at_) });
+                for ( const auto& activity : it->second.activities_ ) {
+                    activities_.erase(activity.id_);
+                }
+                sequences_.erase(it);
+            } else {
+                return Error("function js." + function + " is not implemented");
+            }
+            return Serialize(result);
+        }
+
+        Activity* Find (const std::string& a_sid, const std::string& a_id)
+        {
+            const auto it = sequences_.find(strtoll(a_sid.c_str(), nullptr, 10));
+            if ( sequences_.end() == it ) {
+                return nullptr;
+            }
+            const int64_t id = strtoll(a_id.c_str(), nullptr, 10);
+            for ( auto& activity : it->second.activities_ ) {
+                if ( id == activity.id_ ) {
+                    return &activity;
+                }
+            }
+            return nullptr;
+        }
+
+    }; // end of class 'FakePostgreSQL'
+
+    // MARK: - BENCH
+
+    /**
+     * @brief Timestamps collected for one sequence.
+     */
+    typedef struct {
+        uint64_t              submitted_;
+        std::vector<uint64_t> pushed_;     //!< Activity push to beanstalkd, per index.
+        std::vector<uint64_t> returned_;   //!< Activity result published by worker, per index.
+        uint64_t              finished_;
+        std::string           status_;
+    } Track;
+
+    /**
+     * @brief Bench options.
+     */
+    typedef struct {
+        std::string              service_id_;
+        std::string              tube_;
+        std::string              worker_tube_;
+        std::string              config_template_;
+        std::string              log_;
+        std::vector<size_t>      lengths_;
+        std::vector<size_t>      payloads_;
+        std::vector<size_t>      concurrency_;
+        size_t                   sequences_;
+        size_t                   warmup_;
+        size_t                   workers_;
+        uint64_t                 work_us_;
+        uint64_t                 timeout_s_;
+        bool                     csv_;
+        std::vector<std::string> command_;
+    } Options;
+
+    /**
+     * @brief Latency percentiles.
+     */
+    typedef struct {
+        double p50_;
+        double p90_;
+        double p99_;
+    } Percentiles;
+
+    Percentiles Compute (std::vector<uint64_t>& io_samples)
+    {
+        if ( 0 == io_samples.size() ) {
+            return { 0, 0, 0 };
+        }
+        std::sort(io_samples.begin(), io_samples.end());
+        const auto at = [&io_samples] (const double a_q) -> double {
+            const size_t idx = std::min(io_samples.size() - 1, static_cast<size_t>(a_q * static_cast<double>(io_samples.size())));
+            return static_cast<double>(io_samples[idx]) / 1000.0;
+        };
+        return { at(0.50), at(0.90), at(0.99) };
+    }
+
+    std::vector<size_t> ParseList (const char* const a_value)
+    {
+        std::vector<size_t> values;
+        std::istringstream  is(a_value);
+        std::string         item;
+        while ( std::getline(is, item, ',') ) {
+            values.push_back(static_cast<size_t>(strtoull(item.c_str(), nullptr, 10)));
+        }
+        return values;
+    }
+
+    std::string Replace (std::string a_text, const std::string& a_what, const std::string& a_with)
+    {
+        size_t pos = 0;
+        while ( std::string::npos != ( pos = a_text.find(a_what, pos) ) ) {
+            a_text.replace(pos, a_what.length(), a_with);
+            pos += a_with.length();
+        }
+        return a_text;
+    }
+
+    /**
+     * @brief Read a field, in kB, from /proc/<pid>/status.
+     */
+    uint64_t ReadStatus (const pid_t a_pid, const char* const a_field)
+    {
+        FILE* file = fopen(( "/proc/" + std::to_string(a_pid) + "/status" ).c_str(), "r");
+        if ( nullptr == file ) {
+            return 0;
+        }
+        char     line[256];
+        uint64_t value = 0;
+        while ( nullptr != fgets(line, sizeof(line), file) ) {
+            if ( 0 == strncmp(line, a_field, strlen(a_field)) ) {
+                value = strtoull(line + strlen(a_field) + 1, nullptr, 10);
+                break;
+            }
+        }
+        fclose(file);
+        return value;
+    }
+
+    /**
+     * @brief Runs the matrix, one sequencer process per cell.
+     */
+    class Bench final
+    {
+
+    private: // Data
+
+        const Options&          options_;
+        FakeBeanstalkd*         beanstalkd_;
+        FakeRedis*              redis_;
+        FakePostgreSQL*         postgresql_;
+
+        std::mutex              mutex_;
+        std::condition_variable cv_;
+        std::map<uint64_t, Track> tracks_;
+        size_t                  finished_;
+        std::atomic<bool>       running_;
+
+    public: // Constructor(s) / Destructor
+
+        Bench (const Options& a_options)
+            : options_(a_options),
+              beanstalkd_(new FakeBeanstalkd()), redis_(new FakeRedis()), postgresql_(new FakePostgreSQL()),
+              finished_(0), running_(false)
+        {
+            beanstalkd_->SetPutCallback(std::bind(&Bench::OnPut, this, std::placeholders::_1, std::placeholders::_2));
+            redis_->SetPublishCallback(std::bind(&Bench::OnPublish, this, std::placeholders::_1, std::placeholders::_2));
+            beanstalkd_->Start();
+            redis_->Start();
+            postgresql_->Start();
+        }
+
+    public: // Method(s) / Function(s)
+
+        int Run ()
+        {
+            if ( true == options_.csv_ ) {
+                fprintf(stdout, "length,payload,concurrency,sequences,failed,seq_per_s,e2e_p50_ms,e2e_p90_ms,e2e_p99_ms,"
+                                "launch_p50_ms,launch_p99_ms,hop_p50_ms,hop_p90_ms,hop_p99_ms,finish_p50_ms,finish_p99_ms,rss_mib,peak_rss_mib\n");
+            } else {
+                fprintf(stdout, "%6s %8s %5s %8s %9s | %27s | %17s | %27s | %17s | %8s %8s\n",
+                        "length", "payload", "conc", "seq/s", "failed",
+                        "e2e p50/p90/p99 ms", "launch p50/p99", "hop p50/p90/p99 ms", "finish p50/p99", "rss MiB", "peak MiB");
+            }
+            fflush(stdout);
+
+            // ... workers are shared by all cells ...
+            running_ = true;
+            std::vector<std::thread> workers;
+            for ( size_t idx = 0 ; idx < options_.workers_ ; ++idx ) {
+                workers.emplace_back(&Bench::Work, this);
+            }
+
+            int rv = 0;
+            for ( const auto length : options_.lengths_ ) {
+                for ( const auto payload : options_.payloads_ ) {
+                    for ( const auto concurrency : options_.concurrency_ ) {
+                        if ( 0 != Cell(length, payload, concurrency) ) {
+                            rv = -1;
+                        }
+                    }
+                }
+            }
+
+            running_ = false;
+            for ( auto& worker : workers ) {
+                worker.join();
+            }
+            return rv;
+        }
+
+    private: // Method(s) / Function(s)
+
+        /**
+         * @brief Run one matrix cell.
+         */
+        int Cell (const size_t a_length, const size_t a_payload, const size_t a_concurrency)
+        {
+            beanstalkd_->Reset();
+            redis_->Reset();
+            postgresql_->Reset();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                tracks_.clear();
+                finished_ = 0;
+            }
+
+            const pid_t pid = Spawn();
+            if ( pid <= 0 ) {
+                return -1;
+            }
+
+            // ... wait for sequencer to watch it's tube ...
+            const uint64_t ready_deadline = Now() + options_.timeout_s_ * 1000000;
+            while ( 0 == beanstalkd_->Watchers(options_.tube_) && Now() < ready_deadline ) {
+                if ( pid == waitpid(pid, nullptr, WNOHANG) ) {
+                    fprintf(stderr, "sequencer exited before watching '%s' tube\n", options_.tube_.c_str());
+                    return -1;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            if ( 0 == beanstalkd_->Watchers(options_.tube_) ) {
+                fprintf(stderr, "sequencer is not watching '%s' tube\n", options_.tube_.c_str());
+                Stop(pid);
+                return -1;
+            }
+
+            // ... closed loop, keep N sequences in flight ...
+            const size_t total     = options_.warmup_ + options_.sequences_;
+            size_t       submitted = 0;
+            uint64_t     window    = 0;
+            bool         timedout  = false;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                while ( finished_ < total ) {
+                    while ( submitted < total && submitted - finished_ < a_concurrency ) {
+                        lock.unlock();
+                        Submit(a_length, a_payload);
+                        lock.lock();
+                        ++submitted;
+                    }
+                    if ( finished_ == options_.warmup_ && 0 == window ) {
+                        window = Now();
+                    }
+                    if ( std::cv_status::timeout == cv_.wait_for(lock, std::chrono::seconds(options_.timeout_s_)) && finished_ < total ) {
+                        timedout = true;
+                        break;
+                    }
+                    if ( finished_ >= options_.warmup_ && 0 == window ) {
+                        window = Now();
+                    }
+                }
+            }
+            const uint64_t elapsed = Now() - window;
+
+            const uint64_t rss  = ReadStatus(pid, "VmRSS:");
+            const uint64_t peak = ReadStatus(pid, "VmHWM:");
+
+            Stop(pid);
+
+            Report(a_length, a_payload, a_concurrency, elapsed, rss, peak, timedout);
+            return ( true == timedout ? -1 : 0 );
+        }
+
+        /**
+         * @brief Write sequencer config from template and start it.
+         */
+        pid_t Spawn ()
+        {
+            std::string config;
+            {
+                FILE* file = fopen(options_.config_template_.c_str(), "r");
+                if ( nullptr == file ) {
+                    fprintf(stderr, "unable to open '%s': %s\n", options_.config_template_.c_str(), strerror(errno));
+                    return -1;
+                }
+                char   buffer[4096];
+                size_t read;
+                while ( 0 != ( read = fread(buffer, 1, sizeof(buffer), file) ) ) {
+                    config.append(buffer, read);
+                }
+                fclose(file);
+            }
+            config = Replace(config, "{{SERVICE_ID}}"     , options_.service_id_);
+            config = Replace(config, "{{BEANSTALKD_HOST}}", "127.0.0.1");
+            config = Replace(config, "{{BEANSTALKD_PORT}}", std::to_string(beanstalkd_->port()));
+            config = Replace(config, "{{REDIS_HOST}}"     , "127.0.0.1");
+            config = Replace(config, "{{REDIS_PORT}}"     , std::to_string(redis_->port()));
+            config = Replace(config, "{{POSTGRESQL_HOST}}", "127.0.0.1");
+            config = Replace(config, "{{POSTGRESQL_PORT}}", std::to_string(postgresql_->port()));
+
+            char path[] = "/tmp/sequencer-e2e-bench-XXXXXX";
+            const int fd = mkstemp(path);
+            if ( -1 == fd || static_cast<ssize_t>(config.length()) != write(fd, config.data(), config.length()) ) {
+                fprintf(stderr, "unable to write config: %s\n", strerror(errno));
+                return -1;
+            }
+            close(fd);
+
+            std::vector<std::string> args;
+            for ( const auto& arg : options_.command_ ) {
+                args.push_back(Replace(arg, "{{CONFIG}}", path));
+            }
+
+            const pid_t pid = fork();
+            if ( 0 == pid ) {
+                const int log = open(options_.log_.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+                if ( -1 != log ) {
+                    dup2(log, STDOUT_FILENO);
+                    dup2(log, STDERR_FILENO);
+                }
+                std::vector<char*> argv;
+                for ( auto& arg : args ) {
+                    argv.push_back(const_cast<char*>(arg.c_str()));
+                }
+                argv.push_back(nullptr);
+                execvp(argv[0], argv.data());
+                _exit(127);
+            }
+            if ( pid < 0 ) {
+                fprintf(stderr, "unable to fork: %s\n", strerror(errno));
+            }
+            return pid;
+        }
+
+        /**
+         * @brief Stop sequencer process, SIGTERM then, if still running after 10 seconds, SIGKILL.
+         */
+        void Stop (const pid_t a_pid)
+        {
+            kill(a_pid, SIGTERM);
+            bool exited = false;
+            for ( int idx = 0 ; idx < 1000 && false == exited ; ++idx ) {
+                if ( a_pid == waitpid(a_pid, nullptr, WNOHANG) ) {
+                    exited = true;
+                } else {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+            }
+            if ( false == exited ) {
+                kill(a_pid, SIGKILL);
+                (void)waitpid(a_pid, nullptr, 0);
+            }
+            // ... next cell must not start while this process connections are still being torn down ...
+            for ( int idx = 0 ; idx < 100 && 0 != beanstalkd_->Watchers(options_.tube_) ; ++idx ) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+
+        /**
+         * @brief Submit a sequence, as a producer would.
+         */
+        void Submit (const size_t a_length, const size_t a_payload)
+        {
+            const uint64_t    id  = static_cast<uint64_t>(redis_->Incr(options_.service_id_ + ":jobs:sequential_id"));
+            const std::string key = options_.service_id_ + ":jobs:" + options_.tube_ + ':' + std::to_string(id);
+
+            Json::Value sequence = Json::Value(Json::ValueType::objectValue);
+            sequence["id"]       = std::to_string(id);
+            sequence["tube"]     = options_.tube_;
+            sequence["ttr"]      = Json::UInt(60 * a_length);
+            sequence["validity"] = Json::UInt(300 * a_length);
+            Json::Value& jobs = sequence["jobs"] = Json::Value(Json::ValueType::arrayValue);
+            for ( size_t idx = 0 ; idx < a_length ; ++idx ) {
+                Json::Value& job = jobs.append(Json::Value(Json::ValueType::objectValue));
+                job["tube"]     = options_.worker_tube_;
+                job["ttr"]      = Json::UInt(60);
+                job["validity"] = Json::UInt(300);
+                Json::Value& payload = job["payload"];
+                payload["bench"]["sequence"] = Json::UInt64(id);
+                payload["bench"]["index"]    = Json::UInt64(idx);
+                payload["data"]              = std::string(a_payload, 'x');
+                if ( idx > 0 ) {
+                    payload["previous"] = "$.responses[" + std::to_string(idx - 1) + "].response.index";
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                Track& track = tracks_[id];
+                track.submitted_ = Now();
+                track.pushed_.assign(a_length, 0);
+                track.returned_.assign(a_length, 0);
+                track.finished_ = 0;
+            }
+
+            redis_->HSet(key, "status", "{\"status\":\"queued\"}");
+            (void)beanstalkd_->Put(options_.tube_, ToString(sequence));
+        }
+
+        /**
+         * @brief Simulated worker: reserve an activity job, 'work' and publish it's result.
+         */
+        void Work ()
+        {
+            FakeBeanstalkd::Job job;
+            while ( true == running_ ) {
+                if ( false == beanstalkd_->ReserveAny(options_.tube_, /* a_timeout_ms */ 100, job) ) {
+                    continue;
+                }
+                Json::Value payload;
+                if ( false == ParseMessage(job.data_, payload) ) {
+                    continue;
+                }
+                if ( 0 != options_.work_us_ ) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(options_.work_us_));
+                }
+                Json::Value message = Json::Value(Json::ValueType::objectValue);
+                message["status"]               = "completed";
+                message["response"]["index"]    = payload["bench"]["index"];
+                message["response"]["data"]     = payload["data"];
+                const std::string id      = payload["id"].asString();
+                const std::string channel = options_.service_id_ + ':' + job.tube_ + ':' + id;
+                redis_->HSet(options_.service_id_ + ":jobs:" + job.tube_ + ':' + id, "status", "{\"status\":\"completed\"}");
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    const auto it = tracks_.find(payload["bench"]["sequence"].asUInt64());
+                    const auto index = static_cast<size_t>(payload["bench"]["index"].asUInt64());
+                    if ( tracks_.end() != it && index < it->second.returned_.size() ) {
+                        it->second.returned_[index] = Now();
+                    }
+                }
+                (void)redis_->Publish(channel, ToString(message));
+            }
+        }
+
+        /**
+         * @brief Called on every beanstalkd put, activity pushes are timestamped.
+         */
+        void OnPut (const std::string& a_tube, const std::string& a_data)
+        {
+            if ( a_tube == options_.tube_ ) {
+                return;
+            }
+            Json::Value payload;
+            if ( false == ParseMessage(a_data, payload) || false == payload.isMember("bench") ) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            const auto it    = tracks_.find(payload["bench"]["sequence"].asUInt64());
+            const auto index = static_cast<size_t>(payload["bench"]["index"].asUInt64());
+            if ( tracks_.end() != it && index < it->second.pushed_.size() ) {
+                it->second.pushed_[index] = Now();
+            }
+        }
+
+        /**
+         * @brief Called on every REDIS publish, sequence terminal messages are timestamped.
+         */
+        void OnPublish (const std::string& a_channel, const std::string& a_message)
+        {
+            const std::string prefix = options_.service_id_ + ':' + options_.tube_ + ':';
+            if ( 0 != a_channel.compare(0, prefix.length(), prefix) ) {
+                return;
+            }
+            Json::Value message;
+            if ( false == ParseMessage(a_message, message) ) {
+                return;
+            }
+            const std::string status = message.get("status", "").asString();
+            if ( 0 != status.compare("completed") && 0 != status.compare("failed") && 0 != status.compare("error") && 0 != status.compare("cancelled") ) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                const auto it = tracks_.find(strtoull(a_channel.c_str() + prefix.length(), nullptr, 10));
+                if ( tracks_.end() == it || 0 != it->second.finished_ ) {
+                    return;
+                }
+                it->second.finished_ = Now();
+                it->second.status_   = status;
+                ++finished_;
+            }
+            cv_.notify_all();
+        }
+
+        /**
+         * @brief Print one matrix cell results.
+         */
+        void Report (const size_t a_length, const size_t a_payload, const size_t a_concurrency, const uint64_t a_elapsed,
+                     const uint64_t a_rss_kb, const uint64_t a_peak_kb, const bool a_timedout)
+        {
+            std::vector<uint64_t> e2e, launch, hop, finish;
+            std::vector<uint64_t> submitted;
+            size_t                completed = 0;
+            size_t                failed    = 0;
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            for ( const auto& it : tracks_ ) {
+                submitted.push_back(it.second.submitted_);
+            }
+            std::sort(submitted.begin(), submitted.end());
+            const uint64_t measured_from = ( options_.warmup_ < submitted.size() ? submitted[options_.warmup_] : 0 );
+
+            for ( const auto& it : tracks_ ) {
+                const Track& track = it.second;
+                if ( 0 == track.finished_ || track.submitted_ < measured_from ) {
+                    continue;
+                }
+                if ( 0 != track.status_.compare("completed") ) {
+                    ++failed;
+                    continue;
+                }
+                ++completed;
+                e2e.push_back(track.finished_ - track.submitted_);
+                if ( 0 != track.pushed_[0] ) {
+                    launch.push_back(track.pushed_[0] - track.submitted_);
+                }
+                for ( size_t idx = 1 ; idx < track.pushed_.size() ; ++idx ) {
+                    if ( 0 != track.pushed_[idx] && 0 != track.returned_[idx - 1] && track.pushed_[idx] >= track.returned_[idx - 1] ) {
+                        hop.push_back(track.pushed_[idx] - track.returned_[idx - 1]);
+                    }
+                }
+                if ( 0 != track.returned_.back() ) {
+                    finish.push_back(track.finished_ - track.returned_.back());
+                }
+            }
+
+            const double      rate = ( 0 != a_elapsed ? static_cast<double>(completed + failed) * 1000000.0 / static_cast<double>(a_elapsed) : 0.0 );
+            const Percentiles e    = Compute(e2e);
+            const Percentiles l    = Compute(launch);
+            const Percentiles h    = Compute(hop);
+            const Percentiles f    = Compute(finish);
+
+            if ( true == options_.csv_ ) {
+                fprintf(stdout, "%zu,%zu,%zu,%zu,%zu,%.1f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.1f,%.1f\n",
+                        a_length, a_payload, a_concurrency, completed, failed, rate,
+                        e.p50_, e.p90_, e.p99_, l.p50_, l.p99_, h.p50_, h.p90_, h.p99_, f.p50_, f.p99_,
+                        static_cast<double>(a_rss_kb) / 1024.0, static_cast<double>(a_peak_kb) / 1024.0
+                );
+            } else {
+                fprintf(stdout, "%6zu %8zu %5zu %8.1f %9zu | %8.3f %8.3f %9.3f | %8.3f %8.3f | %8.3f %8.3f %9.3f | %8.3f %8.3f | %8.1f %8.1f%s\n",
+                        a_length, a_payload, a_concurrency, rate, failed,
+                        e.p50_, e.p90_, e.p99_, l.p50_, l.p99_, h.p50_, h.p90_, h.p99_, f.p50_, f.p99_,
+                        static_cast<double>(a_rss_kb) / 1024.0, static_cast<double>(a_peak_kb) / 1024.0,
+                        ( true == a_timedout ? " TIMED OUT" : "" )
+                );
+            }
+            fflush(stdout);
+        }
+
+    }; // end of class 'Bench'
+
+} // end of anonymous namespace
+
+/**
+ * @brief End-to-end throughput and latency benchmark.
+ *
+ * In-process stand-ins for beanstalkd, REDIS and PostgreSQL ( js.* functions ) are started on
+ * ephemeral 127.0.0.1 ports, a sequencer process is started against them for each matrix cell
+ * and simulated workers consume activity jobs and publish their results.
+ *
+ * USAGE:
+ *
+ * sequencer-e2e-bench --config <template> [options] -- <sequencer command line>
+ *
+ *  --config <template>     Sequencer config file template, {{SERVICE_ID}}, {{BEANSTALKD_HOST}}, {{BEANSTALKD_PORT}},
+ *                          {{REDIS_HOST}}, {{REDIS_PORT}}, {{POSTGRESQL_HOST}} and {{POSTGRESQL_PORT}} are replaced.
+ *  --service-id <id>       REDIS service id, must match the one set in config ( default: bench ).
+ *  --lengths <list>        Sequence lengths ( default: 1,4,16 ).
+ *  --payloads <list>       Activity payload sizes, in bytes ( default: 256,4096,65536 ).
+ *  --concurrency <list>    Sequences in flight ( default: 1,16,64 ).
+ *  --sequences <n>         Measured sequences per cell ( default: 200 ).
+ *  --warmup <n>            Unmeasured sequences per cell ( default: 10 ).
+ *  --workers <n>           Simulated workers ( default: 64 ).
+ *  --work-us <n>           Simulated work per activity, in microseconds ( default: 0 ).
+ *  --timeout <s>           Max. seconds without progress before a cell is aborted ( default: 30 ).
+ *  --log <file>            Sequencer stdout / stderr ( default: /dev/null ).
+ *  --csv                   Report as CSV.
+ *
+ * {{CONFIG}} is replaced in the sequencer command line by the generated config file path, e.g.:
+ *
+ * sequencer-e2e-bench --config bench.json.tpl -- ./casper-job-sequencer -c {{CONFIG}}
+ *
+ * Reported per cell: sequences/s, end-to-end latency ( submit to final message ), launch ( submit to first activity push ),
+ * hop ( activity result to next activity push ), finish ( last activity result to final message ) percentiles,
+ * and sequencer resident set size ( current and peak ).
+ *
+ * param argc
+ * param argv
+ *
+ * return
+ */
+int main(int argc, char** argv)
+{
+    Options options;
+    options.service_id_  = "bench";
+    options.tube_        = "sequencer-live";
+    options.worker_tube_ = "bench-worker";
+    options.log_         = "/dev/null";
+    options.lengths_     = { 1, 4, 16 };
+    options.payloads_    = { 256, 4096, 65536 };
+    options.concurrency_ = { 1, 16, 64 };
+    options.sequences_   = 200;
+    options.warmup_      = 10;
+    options.workers_     = 64;
+    options.work_us_     = 0;
+    options.timeout_s_   = 30;
+    options.csv_         = false;
+
+    for ( int idx = 1 ; idx < argc ; ++idx ) {
+        const std::string arg   = argv[idx];
+        const char*       value = ( idx + 1 < argc ? argv[idx + 1] : nullptr );
+        if ( 0 == arg.compare("--") ) {
+            options.command_.assign(argv + idx + 1, argv + argc);
+            break;
+        } else if ( 0 == arg.compare("--csv") ) {
+            options.csv_ = true;
+            continue;
+        } else if ( nullptr == value ) {
+            fprintf(stderr, "missing value for '%s'\n", arg.c_str());
+            return -1;
+        }
+        if ( 0 == arg.compare("--config") ) {
+            options.config_template_ = value;
+        } else if ( 0 == arg.compare("--service-id") ) {
+            options.service_id_ = value;
+        } else if ( 0 == arg.compare("--lengths") ) {
+            options.lengths_ = ParseList(value);
+        } else if ( 0 == arg.compare("--payloads") ) {
+            options.payloads_ = ParseList(value);
+        } else if ( 0 == arg.compare("--concurrency") ) {
+            options.concurrency_ = ParseList(value);
+        } else if ( 0 == arg.compare("--sequences") ) {
+            options.sequences_ = static_cast<size_t>(strtoull(value, nullptr, 10));
+        } else if ( 0 == arg.compare("--warmup") ) {
+            options.warmup_ = static_cast<size_t>(strtoull(value, nullptr, 10));
+        } else if ( 0 == arg.compare("--workers") ) {
+            options.workers_ = static_cast<size_t>(strtoull(value, nullptr, 10));
+        } else if ( 0 == arg.compare("--work-us") ) {
+            options.work_us_ = static_cast<uint64_t>(strtoull(value, nullptr, 10));
+        } else if ( 0 == arg.compare("--timeout") ) {
+            options.timeout_s_ = static_cast<uint64_t>(strtoull(value, nullptr, 10));
+        } else if ( 0 == arg.compare("--log") ) {
+            options.log_ = value;
+        } else {
+            fprintf(stderr, "unknown option '%s'\n", arg.c_str());
+            return -1;
+        }
+        ++idx;
+    }
+
+    if ( 0 == options.config_template_.length() || 0 == options.command_.size() ) {
+        fprintf(stderr, "usage: %s --config <template> [options] -- <sequencer command line>\n", argv[0]);
+        return -1;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+
+    // ... fakes and workers threads outlive main, bench is never destroyed ...
+    Bench* bench = new Bench(options);
+    const int rv = bench->Run();
+    fflush(stdout);
+    _exit(rv);
+}
@@ -0,0 +1,86 @@
+/**
+* @file sequencer-log-decoder.cc
+*
+* Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+*
+* This file is part of casper-job-sequencer.
+*
+* casper-job-sequencer is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Affero General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* casper-job-sequencer  is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU Affero General Public License
+* along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "casper/job/sequencer/logger.h"
+
+/**
+ * @brief Offline decoder for casper::job::sequencer::Logger binary files.
+ *
+ * USAGE:
+ *
+ * sequencer-log-decoder <binary log file> [bjid]
+ *
+ * Each record is written to stdout as '<UTC timestamp>, <level>, <bjid>, <text>',
+ * where text is the same as the one that would have been written by CC_JOB_LOG.
+ *
+ * param argc
+ * param argv
+ *
+ * return
+ */
+int main(int argc, char** argv)
+{
+    if ( argc < 2 ) {
+        fprintf(stderr, "usage: %s <binary log file> [bjid]\n", argv[0]);
+        return -1;
+    }
+
+    FILE* file = fopen(argv[1], "rb");
+    if ( nullptr == file ) {
+        fprintf(stderr, "unable to open '%s': %s\n", argv[1], strerror(errno));
+        return -1;
+    }
+
+    const bool     filter = ( argc > 2 );
+    const uint64_t bjid   = ( true == filter ? static_cast<uint64_t>(strtoull(argv[2], nullptr, 10)) : 0 );
+
+    const bool rv = casper::job::sequencer::Logger::Decode(file,
+        [filter, bjid] (const uint64_t a_timestamp, const uint64_t a_bjid, const uint32_t a_level, const std::string& /* a_step */, const std::string& a_text) {
+            // ... filtering by job?
+            if ( true == filter && bjid != a_bjid ) {
+                return;
+            }
+            const time_t seconds = static_cast<time_t>(a_timestamp / 1000000);
+            struct tm    tm;
+            char         buffer[32];
+            gmtime_r(&seconds, &tm);
+            strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", &tm);
+            fprintf(stdout, "%s.%06u, %u, %8" PRIu64 ", %s\n",
+                    buffer, static_cast<unsigned>(a_timestamp % 1000000), a_level, a_bjid, a_text.c_str()
+            );
+        }
+    );
+
+    fclose(file);
+
+    if ( false == rv ) {
+        fprintf(stderr, "'%s' is truncated or corrupted!\n", argv[1]);
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,489 @@
+/**
+* @file sequencer-microbench.cc
+*
+* Copyright (c) 2011-2020 Cloudware S.A. All rights reserved.
+*
+* This file is part of casper-job-sequencer.
+*
+* casper-job-sequencer is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Affero General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* casper-job-sequencer  is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU Affero General Public License
+* along with casper-job-sequencer.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "casper/job/sequencer.h"
+
+#include "casper/job/sequencer/activity.h"
+#include "casper/job/sequencer/protocol.h"
+#include "casper/job/sequencer/sequence.h"
+#include "casper/job/sequencer/sql.h"
+#include "casper/job/sequencer/v8/script.h"
+
+#include "cc/v8/singleton.h"
+
+namespace
+{
+
+    std::atomic<uint64_t> s_allocations_(0); //!< Number of calls to operator new, since startup.
+
+}
+
+// MARK: - ALLOCATION COUNTING
+
+void* operator new (size_t a_size)
+{
+    s_allocations_.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = malloc(0 != a_size ? a_size : 1);
+    if ( nullptr == ptr ) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete (void* a_ptr) noexcept
+{
+    free(a_ptr);
+}
+
+namespace
+{
+
+    /**
+     * @brief Reports the average number of heap allocations per iteration as 'allocs/op'.
+     *
+     * Must be declared right before the benchmark loop, fixture setup would otherwise be accounted.
+     */
+    class AllocationCounter final
+    {
+
+    private: // Data
+
+        benchmark::State& state_; //!< Benchmark state.
+        const uint64_t    start_; //!< Allocations count when created.
+
+    public: // Constructor(s) / Destructor
+
+        AllocationCounter (benchmark::State& a_state)
+            : state_(a_state), start_(s_allocations_.load(std::memory_order_relaxed))
+        {
+            /* empty */
+        }
+
+        ~AllocationCounter ()
+        {
+            state_.counters["allocs/op"] = benchmark::Counter(static_cast<double>(s_allocations_.load(std::memory_order_relaxed) - start_),
+                                                              benchmark::Counter::kAvgIterations);
+        }
+
+    }; // end of class 'AllocationCounter'
+
+    /**
+     * @brief Exposes the stateless casper::job::Sequencer helpers, never instantiated.
+     */
+    class Probe final : public casper::job::Sequencer
+    {
+
+    public: // Static Method(s) / Function(s)
+
+        using casper::job::Sequencer::MSG2JSON;
+        using casper::job::Sequencer::MakeID;
+        using casper::job::Sequencer::SumSequenceTimeouts;
+
+    }; // end of class 'Probe'
+
+    const casper::job::sequencer::Tracking sk_tracking_ = SEQUENCER_TRACK_CALL(0, "MICROBENCH");
+
+    /**
+     * @brief Build a synthetic activity response with a 'data' field of ( approximately ) the requested size.
+     *
+     * @param a_size Payload size, in bytes.
+     *
+     * @return JSON string.
+     */
+    std::string MakeResponse (const size_t a_size)
+    {
+        return "{\"status\":\"completed\",\"status_code\":200,\"response\":{\"id\":1234,\"data\":\"" + std::string(a_size, 'x') + "\"}}";
+    }
+
+    /**
+     * @brief Wrap a body using the '*status,ctlen,ct,bodylen,body' primitive protocol.
+     *
+     * @param a_body Body to wrap.
+     *
+     * @return Primitive protocol message.
+     */
+    std::string Wrap (const std::string& a_body)
+    {
+        const std::string content_type = "application/json";
+        return "*200," + std::to_string(content_type.length()) + "," + content_type + "," + std::to_string(a_body.length()) + "," + a_body;
+    }
+
+    /**
+     * @brief Build a sequence payload with N jobs.
+     *
+     * @param a_count Number of jobs.
+     *
+     * @return Sequence payload.
+     */
+    Json::Value MakeSequencePayload (const size_t a_count)
+    {
+        Json::Value payload = Json::Value(Json::ValueType::objectValue);
+        payload["ttr"]      = Json::UInt(0);
+        payload["validity"] = Json::UInt(0);
+        Json::Value& jobs = payload["jobs"] = Json::Value(Json::ValueType::arrayValue);
+        for ( size_t idx = 0 ; idx < a_count ; ++idx ) {
+            Json::Value& job = jobs.append(Json::Value(Json::ValueType::objectValue));
+            job["tube"]                 = "bench-" + std::to_string(idx);
+            job["ttr"]                  = Json::UInt(60);
+            job["validity"]             = Json::UInt(300);
+            job["payload"]["id"]        = Json::UInt64(idx);
+            job["payload"]["previous"]  = "$.responses[" + std::to_string(0 == idx ? 0 : idx - 1) + "].response.id";
+        }
+        return payload;
+    }
+
+    /**
+     * @brief Build a bound sequence, as it is after being registered.
+     *
+     * @return Shared sequence.
+     */
+    casper::job::sequencer::SharedSequence MakeSequence ()
+    {
+        std::shared_ptr<casper::job::sequencer::Sequence> sequence = std::make_shared<casper::job::sequencer::Sequence>(
+            /* a_source   */ casper::job::sequencer::Sequence::Source::Default,
+            /* a_cid      */ 1,
+            /* a_iid      */ 1,
+            /* a_bjid     */ 1234567,
+            /* a_rsid     */ "bench",
+            /* a_rjnr     */ 1234567,
+            /* a_rjid     */ "bench:jobs:sequencer-live:1234567",
+            /* a_rcid     */ "bench:sequencer-live:1234567",
+            /* a_origin   */ Json::Value::null,
+            /* a_on_error */ Json::Value::null
+        );
+        sequence->Bind("987654", /* a_count */ 3);
+        return sequence;
+    }
+
+    /**
+     * @brief Build an activity with a payload of ( approximately ) the requested size.
+     *
+     * @param a_size Payload size, in bytes.
+     *
+     * @return Activity.
+     */
+    casper::job::sequencer::Activity MakeActivity (const size_t a_size)
+    {
+        casper::job::sequencer::Activity activity(MakeSequence(), /* a_did */ "123", /* a_index */ 1, /* a_attempt */ 0);
+        activity.Bind(7654321, "bench:jobs:bench-1:7654321", "bench:bench-1", "bench:bench-1:7654321", /* a_new_attempt */ true);
+        Json::Value payload = Json::Value(Json::ValueType::objectValue);
+        payload["id"]   = Json::UInt64(7654321);
+        payload["data"] = std::string(a_size, 'x');
+        activity.Bind(casper::job::sequencer::Status::Pending, /* a_validity */ 300, /* a_ttr */ 60, std::move(payload));
+        activity.SerializePayload();
+        return activity;
+    }
+
+} // end of anonymous namespace
+
+// MARK: - MSG2JSON
+
+/**
+ * @brief casper::job::Sequencer::MSG2JSON - primitive protocol message.
+ */
+static void BM_MSG2JSON_Primitive (benchmark::State& a_state)
+{
+    const std::string message = Wrap(MakeResponse(static_cast<size_t>(a_state.range(0))));
+    AllocationCounter allocations(a_state);
+    for ( auto _ : a_state ) {
+        Json::Value object;
+        benchmark::DoNotOptimize(Probe::MSG2JSON(message, object));
+    }
+    a_state.SetBytesProcessed(static_cast<int64_t>(a_state.iterations()) * static_cast<int64_t>(message.length()));
+}
+BENCHMARK(BM_MSG2JSON_Primitive)->Arg(64)->Arg(1024)->Arg(16384);
+
+/**
+ * @brief casper::job::Sequencer::MSG2JSON - plain JSON message.
+ */
+static void BM_MSG2JSON_JSON (benchmark::State& a_state)
+{
+    const std::string message = MakeResponse(static_cast<size_t>(a_state.range(0)));
+    AllocationCounter allocations(a_state);
+    for ( auto _ : a_state ) {
+        Json::Value object;
+        benchmark::DoNotOptimize(Probe::MSG2JSON(message, object));
+    }
+    a_state.SetBytesProcessed(static_cast<int64_t>(a_state.iterations()) * static_cast<int64_t>(message.length()));
+}
+BENCHMARK(BM_MSG2JSON_JSON)->Arg(64)->Arg(1024)->Arg(16384);
+
+// MARK: - MakeID
+
+/**
+ * @brief casper::job::Sequencer::MakeID.
+ */
+static void BM_MakeID (benchmark::State& a_state)
+{
+    const std::string rcid = "bench:sequencer-live:1234567";
+    AllocationCounter allocations(a_state);
+    for ( auto _ : a_state ) {
+        benchmark::DoNotOptimize(Probe::MakeID("relay", rcid));
+    }
+}
+BENCHMARK(BM_MakeID);
+
+// MARK: - SQL
+
+/**
+ * @brief casper::job::sequencer::SQL::RegisterSequence, as called by casper::job::Sequencer::RegisterSequence.
+ */
+static void BM_SQL_RegisterSequence (benchmark::State& a_state)
+{
+    const auto        sequence = MakeSequence();
+    const Json::Value payload  = MakeSequencePayload(static_cast<size_t>(a_state.range(0)));
+    AllocationCounter allocations(a_state);
+    for ( auto _ : a_state ) {
+        // ... serialization is part of the measured cost, as it is at the call site ...
+        Json::FastWriter fw; fw.omitEndingLineFeed();
+        benchmark::DoNotOptimize(casper::job::sequencer::SQL::RegisterSequence(/* a_pid */ 1, *sequence,
+                                                                               fw.write(payload), fw.write(payload["jobs"]),
+                                                                               /* a_ttr */ 60, /* a_validity */ 300, /* a_timeout */ 360)
+        );
+    }
+}
+BENCHMARK(BM_SQL_RegisterSequence)->Arg(1)->Arg(10)->Arg(100);
+
+/**
+ * @brief casper::job::sequencer::SQL::FinalizeActivity, as called by casper::job::Sequencer::FinalizeActivity.
+ */
+static void BM_SQL_FinalizeActivity (benchmark::State& a_state)
+{
+    const auto        activity = MakeActivity(64);
+    const std::string response = MakeResponse(static_cast<size_t>(a_state.range(0)));
+    const std::string attempt  = "{\"attempt\":1,\"status\":\"completed\"}";
+    AllocationCounter allocations(a_state);
+    for ( auto _ : a_state ) {
+        benchmark::DoNotOptimize(casper::job::sequencer::SQL::FinalizeActivity(activity, attempt, response));
+    }
+}
+BENCHMARK(BM_SQL_FinalizeActivity)->Arg(64)->Arg(1024)->Arg(16384);
+
+// MARK: - COPY
+
+/**
+ * @brief casper::job::sequencer::Sequence copy construction.
+ */
+static void BM_Sequence_Copy (benchmark::State& a_state)
+{
+    const auto sequence = MakeSequence();
+    AllocationCounter allocations(a_state);
+    for ( auto _ : a_state ) {
+        casper::job::sequencer::Sequence copy(*sequence);
+        benchmark::DoNotOptimize(&copy);
+    }
+}
+BENCHMARK(BM_Sequence_Copy);
+
+/**
+ * @brief casper::job::sequencer::Activity copy construction.
+ */
+static void BM_Activity_Copy (benchmark::State& a_state)
+{
+    const auto activity = MakeActivity(static_cast<size_t>(a_state.range(0)));
+    AllocationCounter allocations(a_state);
+    for ( auto _ : a_state ) {
+        casper::job::sequencer::Activity copy(activity);
+        benchmark::DoNotOptimize(&copy);
+    }
+}
+BENCHMARK(BM_Activity_Copy)->Arg(64)->Arg(1024)->Arg(16384);
+
+// MARK: - MOVE vs COPY
+
+/**
+ * @brief casper::job::sequencer::Activity::Bind, payload copied in.
+ */
+static void BM_Activity_Bind_Copy (benchmark::State& a_state)
+{
+    auto              activity = MakeActivity(64);
+    const Json::Value payload  = MakeActivity(static_cast<size_t>(a_state.range(0))).payload();
+    AllocationCounter allocations(a_state);
+    for ( auto _ : a_state ) {
+        activity.Bind(casper::job::sequencer::Status::Pending, /* a_validity */ 300, /* a_ttr */ 60, payload);
+        benchmark::DoNotOptimize(&activity);
+    }
+}
+BENCHMARK(BM_Activity_Bind_Copy)->Arg(64)->Arg(1024)->Arg(16384);
+
+/**
+ * @brief casper::job::sequencer::Activity::Bind, payload moved in and detached back ( hop path ).
+ */
+static void BM_Activity_Bind_Move (benchmark::State& a_state)
+{
+    auto        activity = MakeActivity(64);
+    Json::Value payload  = MakeActivity(static_cast<size_t>(a_state.range(0))).payload();
+    AllocationCounter allocations(a_state);
+    for ( auto _ : a_state ) {
+        activity.Bind(casper::job::sequencer::Status::Pending, /* a_validity */ 300, /* a_ttr */ 60, std::move(payload));
+        payload = activity.DetachPayload();
+        benchmark::DoNotOptimize(&payload);
+    }
+}
+BENCHMARK(BM_Activity_Bind_Move)->Arg(64)->Arg(1024)->Arg(16384);
+
+/**
+ * @brief casper::job::sequencer::Activity::SetPayload, payload copied in.
+ */
+static void BM_Activity_SetPayload_Copy (benchmark::State& a_state)
+{
+    auto              activity = MakeActivity(64);
+    const Json::Value payload  = MakeActivity(static_cast<size_t>(a_state.range(0))).payload();
+    AllocationCounter allocations(a_state);
+    for ( auto _ : a_state ) {
+        activity.SetPayload(payload);
+        benchmark::DoNotOptimize(&activity);
+    }
+}
+BENCHMARK(BM_Activity_SetPayload_Copy)->Arg(64)->Arg(1024)->Arg(16384);
+
+/**
+ * @brief casper::job::sequencer::Activity::SetPayload, payload moved in and detached back ( hop path ).
+ */
+static void BM_Activity_SetPayload_Move (benchmark::State& a_state)
+{
+    auto        activity = MakeActivity(64);
+    Json::Value payload  = MakeActivity(static_cast<size_t>(a_state.range(0))).payload();
+    AllocationCounter allocations(a_state);
+    for ( auto _ : a_state ) {
+        activity.SetPayload(std::move(payload));
+        payload = activity.DetachPayload();
+        benchmark::DoNotOptimize(&payload);
+    }
+}
+BENCHMARK(BM_Activity_SetPayload_Move)->Arg(64)->Arg(1024)->Arg(16384);
+
+// MARK: - TIMEOUTS
+
+/**
+ * @brief casper::job::Sequencer::ValidateSequenceTimeouts.
+ *
+ * Measures the per-activity summing, the limits check and logging need a configured job.
+ */
+static void BM_ValidateSequenceTimeouts (benchmark::State& a_state)
+{
+    const Json::Value payload = MakeSequencePayload(static_cast<size_t>(a_state.range(0)));
+    AllocationCounter allocations(a_state);
+    for ( auto _ : a_state ) {
+        Json::UInt ttr      = 0;
+        Json::UInt validity = 0;
+        Probe::SumSequenceTimeouts(sk_tracking_, payload["jobs"], /* a_ttr */ 300, /* a_validity */ 3600, /* a_map_concurrency */ 16, ttr, validity);
+        benchmark::DoNotOptimize(ttr);
+        benchmark::DoNotOptimize(validity);
+    }
+}
+BENCHMARK(BM_ValidateSequenceTimeouts)->Arg(1)->Arg(10)->Arg(100);
+
+// MARK: - V8
+
+/**
+ * @brief casper::job::sequencer::v8::Script::Patch, as called by casper::job::Sequencer::PatchActivity,
+ *        with N synthetic previous activities responses loaded as data object.
+ */
+static void BM_PatchActivity_V8 (benchmark::State& a_state)
+{
+    const size_t count = static_cast<size_t>(a_state.range(0));
+
+    static const ::ev::Loggable::Data sk_loggable_data(/* a_owner_ptr */ nullptr, /* a_ip_addr */ "127.0.0.1", /* a_module */ "microbench", /* a_tag */ "v8");
+
+    casper::job::sequencer::v8::Script script(sk_loggable_data, "microbench", "thin air", "", "/tmp");
+    script.Load(Json::Value::null, {});
+
+    // ... data object, as built from js.get_activities_responses ...
+    Json::Reader reader;
+    Json::Value  object    = Json::Value(Json::ValueType::objectValue);
+    Json::Value& responses = object["responses"] = Json::Value(Json::ValueType::arrayValue);
+    for ( size_t idx = 0 ; idx < count ; ++idx ) {
+        Json::Value response;
+        reader.parse(MakeResponse(256), response, /* a_collect_comments */ false);
+        responses.append(std::move(response));
+    }
+    Json::FastWriter fw; fw.omitEndingLineFeed();
+    ::v8::Persistent<::v8::Value> data;
+    script.SetData(/* a_name  */ "microbench-v8-data",
+                   /* a_data   */ fw.write(object).c_str(),
+                   /* o_object */ nullptr,
+                   /* o_value  */ &data,
+                   /* a_key    */ nullptr
+    );
+
+    // ... payload with one expression per previous response ...
+    Json::Value payload = Json::Value(Json::ValueType::objectValue);
+    for ( size_t idx = 0 ; idx < count ; ++idx ) {
+        payload["field_" + std::to_string(idx)] = "$.responses[" + std::to_string(idx) + "].response.id";
+    }
+
+    AllocationCounter allocations(a_state);
+    for ( auto _ : a_state ) {
+        Json::Value patched = payload;
+        script.Patch(data, patched);
+        benchmark::DoNotOptimize(&patched);
+    }
+    data.Reset();
+}
+BENCHMARK(BM_PatchActivity_V8)->Arg(1)->Arg(10)->Arg(100);
+
+/**
+ * @brief Microbenchmark suite for casper::job::Sequencer CPU bound hot paths.
+ *
+ * USAGE:
+ *
+ * sequencer-microbench [--icu-data=<icudtl.dat uri>] [google benchmark options]
+ *
+ * All google benchmark options are accepted, e.g. --benchmark_filter=MSG2JSON.
+ * Each benchmark also reports the average number of heap allocations per iteration ( allocs/op ).
+ * ICU data is only needed by BM_PatchActivity_V8.
+ *
+ * param argc
+ * param argv
+ *
+ * return
+ */
+int main(int argc, char** argv)
+{
+    const char* icu_data = "";
+    for ( int idx = 1 ; idx < argc ; ++idx ) {
+        if ( 0 == strncmp(argv[idx], "--icu-data=", sizeof("--icu-data=") - 1) ) {
+            icu_data = argv[idx] + sizeof("--icu-data=") - 1;
+        }
+    }
+
+    benchmark::Initialize(&argc, argv);
+
+    ::cc::v8::Singleton::GetInstance().Startup(/* a_exec_uri */ argv[0], /* a_icu_data_uri */ icu_data);
+
+    benchmark::RunSpecifiedBenchmarks();
+
+    ::cc::v8::Singleton::GetInstance().Shutdown();
+
+    return 0;
+}